@@ -74,11 +74,28 @@ typedef struct
   uint32 programSize;
 } OTA_CrcControl_t;
 
+#if HAL_OTA_DL_CRC && !HAL_OTA_BOOT_CODE
+// CRC run over the DL image as it is written
+typedef struct
+{
+  uint32 oset;                   // Image offset of the next byte expected
+  uint32 programStart;           // Image offset of the program, valid once startKnown
+  OTA_CrcControl_t crcControl;   // As found in the program
+  uint16 crc;                    // Run over the program bytes so far
+  uint8 startKnown;              // Both header length bytes have been written
+  uint8 valid;                   // Image written in order from offset 0
+} dlCrc_t;
+#endif
+
 /******************************************************************************
  * LOCAL VARIABLES
  */
 OTA_CrcControl_t OTA_crcControl;
 
+#if HAL_OTA_DL_CRC && !HAL_OTA_BOOT_CODE
+static dlCrc_t dlCrc;
+#endif
+
 #if HAL_OTA_BOOT_CODE
 halDMADesc_t dmaCh0;
 #endif
@@ -88,6 +105,10 @@ halDMADesc_t dmaCh0;
  */
 static uint16 runPoly(uint16 crc, uint8 val);
 
+#if HAL_OTA_DL_CRC && !HAL_OTA_BOOT_CODE
+static void dlCrcRun(uint32 oset, uint8 *pBuf, uint16 len);
+#endif
+
 #if HAL_OTA_XNV_IS_SPI
 static void HalSPIRead(uint32 addr, uint8 *pBuf, uint16 len);
 static void HalSPIWrite(uint32 addr, uint8 *pBuf, uint16 len);
@@ -234,6 +255,82 @@ static uint16 runPoly(uint16 crc, uint8 val)
   return crc;
 }
 
+#if HAL_OTA_DL_CRC && !HAL_OTA_BOOT_CODE
+/******************************************************************************
+ * @fn      dlCrcRun
+ *
+ * @brief   Run the CRC16 Polynomial calculation over bytes being written to the DL image,
+ *          skipping the same bytes as HalOTAChkDL(). A write at offset 0 starts a new image;
+ *          a write anywhere but right after the last one stops the calculation until then.
+ *
+ * @param   oset - Offset into the DL image.
+ * @param   pBuf - Pointer to the bytes being written.
+ * @param   len - Number of bytes being written.
+ *
+ * @return  None.
+ */
+static void dlCrcRun(uint32 oset, uint8 *pBuf, uint16 len)
+{
+  if (oset == 0)
+  {
+    dlCrc.oset = 0;
+    dlCrc.programStart = 0;
+    dlCrc.crcControl.programSize = 0;
+    dlCrc.crc = 0;
+    dlCrc.startKnown = FALSE;
+    dlCrc.valid = TRUE;
+  }
+  else if (oset != dlCrc.oset)
+  {
+    dlCrc.valid = FALSE;
+  }
+
+  if (!dlCrc.valid)
+  {
+    return;
+  }
+
+  for (; len != 0; len--, pBuf++, dlCrc.oset++)
+  {
+    uint32 pos;
+
+    // The program follows the OTA header and its sub-element header.
+    if (dlCrc.oset == OTA_HEADER_LEN_POS)
+    {
+      dlCrc.programStart = *pBuf;
+    }
+    else if (dlCrc.oset == OTA_HEADER_LEN_POS + 1)
+    {
+      dlCrc.programStart += ((uint16)*pBuf << 8) + OTA_SUB_ELEMENT_HDR_LEN;
+      dlCrc.startKnown = TRUE;
+    }
+
+    if (!dlCrc.startKnown || (dlCrc.oset < dlCrc.programStart))
+    {
+      continue;
+    }
+
+    pos = dlCrc.oset - dlCrc.programStart;
+
+    if ((pos >= HAL_OTA_CRC_OSET) && (pos < HAL_OTA_CRC_OSET + sizeof(OTA_CrcControl_t)))
+    {
+      ((uint8 *)&dlCrc.crcControl)[pos - HAL_OTA_CRC_OSET] = *pBuf;
+
+      if (pos < HAL_OTA_CRC_OSET + 4)
+      {
+        continue;
+      }
+    }
+    else if ((pos >= HAL_OTA_CRC_OSET) && (pos >= dlCrc.crcControl.programSize))
+    {
+      continue;
+    }
+
+    dlCrc.crc = runPoly(dlCrc.crc, *pBuf);
+  }
+}
+#endif
+
 /******************************************************************************
  * @fn      HalOTAChkDL
  *
@@ -253,6 +350,17 @@ uint8 HalOTAChkDL(uint8 dlImagePreambleOffset)
   OTA_ImageHeader_t header;
   uint32 programStart;
 
+#if HAL_OTA_DL_CRC && !HAL_OTA_BOOT_CODE
+  // Use the CRC run while the image was written if it covers the whole program.
+  if (dlCrc.valid && dlCrc.startKnown &&
+      (dlCrc.crcControl.programSize >= HAL_OTA_CRC_OSET + sizeof(OTA_CrcControl_t)) &&
+      (dlCrc.crcControl.programSize <= HAL_OTA_DL_MAX) &&
+      (dlCrc.oset >= dlCrc.programStart + dlCrc.crcControl.programSize))
+  {
+    return (dlCrc.crcControl.crc[0] == dlCrc.crc) ? SUCCESS : FAILURE;
+  }
+#endif
+
 #if HAL_OTA_XNV_IS_SPI
   XNV_SPI_INIT();
 #endif
@@ -357,6 +465,9 @@ void HalOTAWrite(uint32 oset, uint8 *pBuf, uint16 len, image_t type)
 {
   if (HAL_OTA_RC != type)
   {
+#if HAL_OTA_DL_CRC && !HAL_OTA_BOOT_CODE
+    dlCrcRun(oset, pBuf, len);
+#endif
 #if HAL_OTA_XNV_IS_INT
     oset += HAL_OTA_RC_START + HAL_OTA_DL_OSET;
 #elif HAL_OTA_XNV_IS_SPI
@@ -55,6 +55,15 @@
 #define HAL_OTA_BOOT_CODE  FALSE
 #endif
 
+/* Set HAL_OTA_DL_CRC to TRUE to run the CRC over the DL image as it is written, so that
+ * HalOTAChkDL() does not have to read the whole image back from flash. The CRC is then run over
+ * the bytes handed to HalOTAWrite() and not over what the flash holds. The image is read back as
+ * before when it was not written in order from offset 0 or the device was reset since.
+ */
+#if !defined HAL_OTA_DL_CRC
+#define HAL_OTA_DL_CRC     FALSE
+#endif
+
 // MSP430 needs to explicitly pack OTA data structures - 8051 is automatic with byte alignment.
 #define PACK_1
 
@@ -0,0 +1,61 @@
+/**************************************************************************************************
+  Filename:       hal_adc.c
+  Revised:        $Date$
+  Revision:       $Revision$
+
+  Description:    This file contains the interface to the HAL ADC.
+                  The host supply is always reported as good.
+
+
+  Copyright 2026 The Z-Stack host port authors.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+
+    Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+    Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+    Neither the name of the copyright holder nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************************************************/
+
+/**************************************************************************************************
+ *                                           INCLUDES
+ **************************************************************************************************/
+#include "hal_adc.h"
+#include "hal_defs.h"
+#include "hal_mcu.h"
+#include "hal_types.h"
+
+/**************************************************************************************************
+ *                                        FUNCTIONS - API
+ **************************************************************************************************/
+
+/* The host has no ADC; the supply voltage always reads as good. */
+
+void HalAdcInit(void){}
+uint16 HalAdcRead(uint8 channel, uint8 resolution){ (void)channel; (void)resolution; return 0;}
+void HalAdcSetReference(uint8 reference){ (void)reference; }
+bool HalAdcCheckVdd(uint8 vdd){ (void)vdd; return TRUE;}
+uint8 HalAdcCheckVddRaw(void){ return 0xFF;}
+
+/**************************************************************************************************
+**************************************************************************************************/
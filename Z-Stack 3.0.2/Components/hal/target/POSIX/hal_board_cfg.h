@@ -0,0 +1,228 @@
+/**************************************************************************************************
+  Filename:       hal_board_cfg.h
+  Revised:        $Date$
+  Revision:       $Revision$
+
+  Description:    Declarations for the host (POSIX) board.
+
+
+  Copyright 2026 Texas Instruments Incorporated. All rights reserved.
+
+  IMPORTANT: Your use of this Software is limited to those specific rights
+  granted under the terms of a software license agreement between the user
+  who downloaded the software, his/her employer (which must be your employer)
+  and Texas Instruments Incorporated (the "License").  You may not use this
+  Software unless you agree to abide by the terms of the License. The License
+  limits your use, and you acknowledge, that the Software may not be modified,
+  copied or distributed unless embedded on a Texas Instruments microcontroller
+  or used solely and exclusively in conjunction with a Texas Instruments radio
+  frequency transceiver, which is integrated into your product.  Other than for
+  the foregoing purpose, you may not use, reproduce, copy, prepare derivative
+  works of, modify, distribute, perform, display or sell this Software and/or
+  its documentation for any purpose.
+
+  YOU FURTHER ACKNOWLEDGE AND AGREE THAT THE SOFTWARE AND DOCUMENTATION ARE
+  PROVIDED AS IS WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+  INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF MERCHANTABILITY, TITLE,
+  NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT SHALL
+  TEXAS INSTRUMENTS OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER CONTRACT,
+  NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR OTHER
+  LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+  INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE
+  OR CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT
+  OF SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+  (INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+
+  Should you have any questions regarding your right to use this Software,
+  contact Texas Instruments Incorporated at www.TI.com.
+**************************************************************************************************/
+
+#ifndef HAL_BOARD_CFG_H
+#define HAL_BOARD_CFG_H
+
+/* ------------------------------------------------------------------------------------------------
+ *                                           Includes
+ * ------------------------------------------------------------------------------------------------
+ */
+
+#include "hal_mcu.h"
+#include "hal_defs.h"
+#include "hal_types.h"
+
+/* ------------------------------------------------------------------------------------------------
+ *                                       Board Indentifier
+ * ------------------------------------------------------------------------------------------------
+ */
+
+#define HAL_BOARD_POSIX
+
+/* ------------------------------------------------------------------------------------------------
+ *                                          Clock Speed
+ * ------------------------------------------------------------------------------------------------
+ */
+
+/* Nominal value only; the host has no busy-wait loops scaled by the CPU clock. */
+#define HAL_CPU_CLOCK_MHZ     32
+
+/* ------------------------------------------------------------------------------------------------
+ *                                       LED Configuration
+ * ------------------------------------------------------------------------------------------------
+ */
+
+#define HAL_NUM_LEDS            3
+
+/* ------------------------------------------------------------------------------------------------
+ *                                    Push Button Configuration
+ * ------------------------------------------------------------------------------------------------
+ */
+
+#define ACTIVE_LOW        !
+#define ACTIVE_HIGH       !!    /* double negation forces result to be '1' */
+
+/* ------------------------------------------------------------------------------------------------
+ *                                    UART pty Configuration
+ * ------------------------------------------------------------------------------------------------
+ */
+
+/* Each opened UART port is a pseudo-terminal. The slave side is published as a symlink named by
+ * the environment variable HAL_UART<n>_PTY or, when that is not set, by HAL_UART_PTY_LINK with
+ * the port number appended.
+ */
+#ifndef HAL_UART_PTY_LINK
+#define HAL_UART_PTY_LINK          "/tmp/zstack_uart"
+#endif
+
+/* Host side software FIFO sizes per port. */
+#ifndef HAL_UART_POSIX_RX_MAX
+#define HAL_UART_POSIX_RX_MAX      1024
+#endif
+
+#ifndef HAL_UART_POSIX_TX_MAX
+#define HAL_UART_POSIX_TX_MAX      2048
+#endif
+
+/* Used by the idle wait in hal_sleep.c to block on the open ports. */
+extern int halUARTFd( uint8 port );
+extern uint8 halUARTTxPending( uint8 port );
+
+/* ------------------------------------------------------------------------------------------------
+ *                                 OSAL NV implemented by a host file.
+ * ------------------------------------------------------------------------------------------------
+ */
+
+/* The NV items are kept in the file named by the environment variable OSAL_NV_FILE or, when that
+ * is not set, HAL_NV_FILE.
+ */
+#ifndef HAL_NV_FILE
+#define HAL_NV_FILE                "osal_nv.bin"
+#endif
+
+// Re-defining Z_EXTADDR_LEN here so as not to include a Z-Stack .h file.
+#define HAL_FLASH_IEEE_SIZE        8
+
+/* ------------------------------------------------------------------------------------------------
+ *                                            Macros
+ * ------------------------------------------------------------------------------------------------
+ */
+
+/* ----------- Board Initialization ---------- */
+#define HAL_BOARD_INIT()
+
+/* ----------- Debounce ---------- */
+#define HAL_DEBOUNCE(expr)
+
+/* ----------- Push Buttons ---------- */
+#define HAL_PUSH_BUTTON1()        (0)
+#define HAL_PUSH_BUTTON2()        (0)
+#define HAL_PUSH_BUTTON3()        (0)
+#define HAL_PUSH_BUTTON4()        (0)
+#define HAL_PUSH_BUTTON5()        (0)
+#define HAL_PUSH_BUTTON6()        (0)
+
+/* ----------- LED's ---------- */
+#define HAL_TURN_OFF_LED1()
+#define HAL_TURN_OFF_LED2()
+#define HAL_TURN_OFF_LED3()
+#define HAL_TURN_OFF_LED4()
+
+#define HAL_TURN_ON_LED1()
+#define HAL_TURN_ON_LED2()
+#define HAL_TURN_ON_LED3()
+#define HAL_TURN_ON_LED4()
+
+#define HAL_TOGGLE_LED1()
+#define HAL_TOGGLE_LED2()
+#define HAL_TOGGLE_LED3()
+#define HAL_TOGGLE_LED4()
+
+#define HAL_STATE_LED1()          (0)
+#define HAL_STATE_LED2()          (0)
+#define HAL_STATE_LED3()          (0)
+#define HAL_STATE_LED4()          (0)
+
+#define HAL_LED_BLINK_DELAY()
+
+/* ----------- Minimum safe bus voltage ---------- */
+
+// The host supply is always good; these only keep the common Vdd checks compiling.
+#define VDD_MIN_RUN   0
+#define VDD_MIN_NV    0
+#define VDD_MIN_GOOD  0
+
+/* ------------------------------------------------------------------------------------------------
+ *                                     Driver Configuration
+ * ------------------------------------------------------------------------------------------------
+ */
+
+/* Set to TRUE enable H/W TIMER usage, FALSE disable it */
+#ifndef HAL_TIMER
+#define HAL_TIMER FALSE
+#endif
+
+/* Set to TRUE enable ADC usage, FALSE disable it */
+#ifndef HAL_ADC
+#define HAL_ADC FALSE
+#endif
+
+/* Set to TRUE enable DMA usage, FALSE disable it */
+#ifndef HAL_DMA
+#define HAL_DMA FALSE
+#endif
+
+/* Set to TRUE enable Flash access, FALSE disable it */
+#ifndef HAL_FLASH
+#define HAL_FLASH FALSE
+#endif
+
+/* Set to TRUE enable AES usage, FALSE disable it */
+#ifndef HAL_AES
+#define HAL_AES FALSE
+#endif
+
+/* Set to TRUE enable LCD usage, FALSE disable it */
+#ifndef HAL_LCD
+#define HAL_LCD FALSE
+#endif
+
+/* Set to TRUE enable LED usage, FALSE disable it */
+#ifndef HAL_LED
+#define HAL_LED FALSE
+#endif
+
+/* Set to TRUE enable KEY usage, FALSE disable it */
+#ifndef HAL_KEY
+#define HAL_KEY FALSE
+#endif
+
+#ifndef HAL_SPI
+#define HAL_SPI FALSE
+#endif
+
+/* Set to TRUE enable UART usage, FALSE disable it */
+#ifndef HAL_UART
+#define HAL_UART TRUE
+#endif
+
+#endif
+/*******************************************************************************************************
+*/
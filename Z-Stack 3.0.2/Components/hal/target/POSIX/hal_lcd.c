@@ -0,0 +1,63 @@
+/**************************************************************************************************
+  Filename:       hal_lcd.c
+  Revised:        $Date$
+  Revision:       $Revision$
+
+  Description:    This file contains the interface to the HAL LCD Service.
+                  The host has no LCD; all calls are no-ops.
+
+
+  Copyright 2026 The Z-Stack host port authors.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+
+    Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+    Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+    Neither the name of the copyright holder nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************************************************/
+
+/**************************************************************************************************
+ *                                           INCLUDES
+ **************************************************************************************************/
+#include "hal_types.h"
+#include "hal_lcd.h"
+
+/**************************************************************************************************
+ *                                        FUNCTIONS - API
+ **************************************************************************************************/
+
+/* The host has no LCD. */
+
+void HalLcdInit(void){}
+void HalLcdWriteString(char *str, uint8 option){ (void)str; (void)option; }
+void HalLcdWriteValue(uint32 value, const uint8 radix, uint8 option){ (void)value; (void)radix; (void)option; }
+void HalLcdWriteScreen(char *line1, char *line2){ (void)line1; (void)line2; }
+void HalLcdWriteStringValue(char *title, uint16 value, uint8 format, uint8 line){ (void)title; (void)value; (void)format; (void)line; }
+void HalLcdWriteStringValueValue(char *title, uint16 value1, uint8 format1, uint16 value2, uint8 format2, uint8 line)
+{ (void)title; (void)value1; (void)format1; (void)value2; (void)format2; (void)line; }
+void HalLcdDisplayPercentBar(char *title, uint8 value){ (void)title; (void)value; }
+void HalLcd_HW_Clear(void){}
+
+/**************************************************************************************************
+**************************************************************************************************/
@@ -0,0 +1,166 @@
+/**************************************************************************************************
+  Filename:       hal_led.c
+  Revised:        $Date$
+  Revision:       $Revision$
+
+  Description:    This file contains the interface to the HAL LED Service.
+                  The host has no LEDs; only the state is kept.
+
+
+  Copyright 2026 Texas Instruments Incorporated. All rights reserved.
+
+  IMPORTANT: Your use of this Software is limited to those specific rights
+  granted under the terms of a software license agreement between the user
+  who downloaded the software, his/her employer (which must be your employer)
+  and Texas Instruments Incorporated (the "License").  You may not use this
+  Software unless you agree to abide by the terms of the License. The License
+  limits your use, and you acknowledge, that the Software may not be modified,
+  copied or distributed unless embedded on a Texas Instruments microcontroller
+  or used solely and exclusively in conjunction with a Texas Instruments radio
+  frequency transceiver, which is integrated into your product.  Other than for
+  the foregoing purpose, you may not use, reproduce, copy, prepare derivative
+  works of, modify, distribute, perform, display or sell this Software and/or
+  its documentation for any purpose.
+
+  YOU FURTHER ACKNOWLEDGE AND AGREE THAT THE SOFTWARE AND DOCUMENTATION ARE
+  PROVIDED AS IS WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+  INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF MERCHANTABILITY, TITLE,
+  NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT SHALL
+  TEXAS INSTRUMENTS OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER CONTRACT,
+  NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR OTHER
+  LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+  INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE
+  OR CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT
+  OF SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+  (INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+
+  Should you have any questions regarding your right to use this Software,
+  contact Texas Instruments Incorporated at www.TI.com.
+**************************************************************************************************/
+
+/***************************************************************************************************
+ *                                             INCLUDES
+ ***************************************************************************************************/
+#include "hal_mcu.h"
+#include "hal_defs.h"
+#include "hal_types.h"
+#include "hal_drivers.h"
+#include "hal_led.h"
+#include "hal_board.h"
+
+/***************************************************************************************************
+ *                                           LOCAL VARIABLES
+ ***************************************************************************************************/
+
+/* The host has no LEDs; the requested state is only remembered for HalLedGetState(). */
+static uint8 HalLedState;
+
+/***************************************************************************************************
+ * @fn      HalLedInit
+ *
+ * @brief   Initialize LED Service
+ *
+ * @param   init - pointer to void that contains the initialized value
+ *
+ * @return  None
+ ***************************************************************************************************/
+void HalLedInit (void)
+{
+  HalLedState = 0;
+}
+
+/***************************************************************************************************
+ * @fn      HalLedSet
+ *
+ * @brief   Tun ON/OFF/TOGGLE given LEDs
+ *
+ * @param   led - bit mask value of leds to be turned ON/OFF/TOGGLE
+ *          mode - BLINK, FLASH, TOGGLE, ON, OFF
+ * @return  None
+ ***************************************************************************************************/
+uint8 HalLedSet (uint8 leds, uint8 mode)
+{
+  switch (mode)
+  {
+    case HAL_LED_MODE_ON:
+      HalLedState |= leds;
+      break;
+
+    case HAL_LED_MODE_TOGGLE:
+      HalLedState ^= leds;
+      break;
+
+    case HAL_LED_MODE_OFF:
+      HalLedState &= ~leds;
+      break;
+
+    default:
+      break;
+  }
+
+  return HalLedState;
+}
+
+/***************************************************************************************************
+ * @fn      HalLedBlink
+ *
+ * @brief   Blink the leds
+ *
+ * @param   leds       - bit mask value of leds to be blinked
+ *          numBlinks  - number of blinks
+ *          percent    - the percentage in each period where the led
+ *                       will be on
+ *          period     - length of each cycle in milliseconds
+ *
+ * @return  None
+ ***************************************************************************************************/
+void HalLedBlink (uint8 leds, uint8 numBlinks, uint8 percent, uint16 period)
+{
+  (void)leds;
+  (void)numBlinks;
+  (void)percent;
+  (void)period;
+}
+
+/***************************************************************************************************
+ * @fn      HalGetLedState
+ *
+ * @brief   Dim LED2 - Dim (set level) of LED2
+ *
+ * @param   none
+ *
+ * @return  led state
+ ***************************************************************************************************/
+uint8 HalLedGetState ()
+{
+  return HalLedState;
+}
+
+/***************************************************************************************************
+ * @fn      HalLedEnterSleep
+ *
+ * @brief   Store current LEDs state before sleep
+ *
+ * @param   none
+ *
+ * @return  none
+ ***************************************************************************************************/
+void HalLedEnterSleep( void )
+{
+}
+
+/***************************************************************************************************
+ * @fn      HalLedExitSleep
+ *
+ * @brief   Restore current LEDs state after sleep
+ *
+ * @param   none
+ *
+ * @return  none
+ ***************************************************************************************************/
+void HalLedExitSleep( void )
+{
+}
+
+/***************************************************************************************************
+***************************************************************************************************/
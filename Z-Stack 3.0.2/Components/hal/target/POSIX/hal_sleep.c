@@ -0,0 +1,186 @@
+/**************************************************************************************************
+  Filename:       hal_sleep.c
+  Revised:        $Date$
+  Revision:       $Revision$
+
+  Description:    This module contains the HAL power management procedures
+                  for the host (POSIX) process.
+
+
+  Copyright 2026 Texas Instruments Incorporated. All rights reserved.
+
+  IMPORTANT: Your use of this Software is limited to those specific rights
+  granted under the terms of a software license agreement between the user
+  who downloaded the software, his/her employer (which must be your employer)
+  and Texas Instruments Incorporated (the "License").  You may not use this
+  Software unless you agree to abide by the terms of the License. The License
+  limits your use, and you acknowledge, that the Software may not be modified,
+  copied or distributed unless embedded on a Texas Instruments microcontroller
+  or used solely and exclusively in conjunction with a Texas Instruments radio
+  frequency transceiver, which is integrated into your product.  Other than for
+  the foregoing purpose, you may not use, reproduce, copy, prepare derivative
+  works of, modify, distribute, perform, display or sell this Software and/or
+  its documentation for any purpose.
+
+  YOU FURTHER ACKNOWLEDGE AND AGREE THAT THE SOFTWARE AND DOCUMENTATION ARE
+  PROVIDED AS IS WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+  INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF MERCHANTABILITY, TITLE,
+  NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT SHALL
+  TEXAS INSTRUMENTS OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER CONTRACT,
+  NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR OTHER
+  LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+  INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE
+  OR CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT
+  OF SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+  (INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+
+  Should you have any questions regarding your right to use this Software,
+  contact Texas Instruments Incorporated at www.TI.com.
+**************************************************************************************************/
+
+/* ------------------------------------------------------------------------------------------------
+ *                                          Includes
+ * ------------------------------------------------------------------------------------------------
+ */
+
+#include <poll.h>
+
+#include "hal_board_cfg.h"
+#include "hal_sleep.h"
+#include "hal_uart.h"
+
+/* ------------------------------------------------------------------------------------------------
+ *                                          Constants
+ * ------------------------------------------------------------------------------------------------
+ */
+
+/* poll() waits forever with a negative timeout */
+#define HAL_SLEEP_FOREVER        -1
+
+/* ------------------------------------------------------------------------------------------------
+ *                                      Local Variables
+ * ------------------------------------------------------------------------------------------------
+ */
+
+/* maximum time a single wait may last, in msecs; 0 means no limit */
+static uint32 maxSleepLoopTime = 0;
+
+/**************************************************************************************************
+ * @fn          halSleep
+ *
+ * @brief       Idle the process until the next OSAL timer expires or one of the open UART ports
+ *              becomes ready. This takes the place of the PM1/PM2 sleep of the SoC targets: the
+ *              caller invokes it when no task has an event pending, and the OSAL clock catches
+ *              up with the elapsed time on the next pass of the task loop.
+ *
+ * input parameters
+ *
+ * @param       osal_timeout - Next OSAL timer timeout, in msecs; 0 if no timer is running.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      None.
+ **************************************************************************************************
+ */
+void halSleep( uint32 osal_timeout )
+{
+  struct pollfd fds[HAL_UART_PORT_MAX];
+  nfds_t cnt = 0;
+  uint8 port;
+  int timeout = HAL_SLEEP_FOREVER;
+
+  for (port = 0; port < HAL_UART_PORT_MAX; port++)
+  {
+    int fd = halUARTFd(port);
+
+    if (fd >= 0)
+    {
+      fds[cnt].fd = fd;
+      fds[cnt].events = POLLIN | (halUARTTxPending(port) ? POLLOUT : 0);
+      fds[cnt].revents = 0;
+      cnt++;
+    }
+  }
+
+  if ((maxSleepLoopTime != 0) && ((osal_timeout == 0) || (osal_timeout > maxSleepLoopTime)))
+  {
+    osal_timeout = maxSleepLoopTime;
+  }
+
+  if (osal_timeout != 0)
+  {
+    timeout = (osal_timeout > 0x7FFFFFFF) ? 0x7FFFFFFF : (int)osal_timeout;
+  }
+
+  (void)poll(fds, cnt, timeout);
+}
+
+/**************************************************************************************************
+ * @fn          halSetMaxSleepLoopTime
+ *
+ * @brief       Set the longest time that a single halSleep() may last.
+ *
+ * input parameters
+ *
+ * @param       rolloverTime - Maximum wait, in msecs; 0 for no limit.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      None.
+ **************************************************************************************************
+ */
+void halSetMaxSleepLoopTime(uint32 rolloverTime)
+{
+  maxSleepLoopTime = rolloverTime;
+}
+
+/**************************************************************************************************
+ * @fn          TimerElapsed
+ *
+ * @brief       Determine the number of OSAL timer ticks elapsed during sleep.
+ *              Not used; the OSAL clock is kept by macMcuPrecisionCount().
+ *
+ * input parameters
+ *
+ * @param       None.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      Number of timer ticks elapsed during sleep.
+ **************************************************************************************************
+ */
+uint32 TimerElapsed( void )
+{
+  /* Stubs */
+  return (0);
+}
+
+/**************************************************************************************************
+ * @fn          halRestoreSleepLevel
+ *
+ * @brief       Restore the deepest timer sleep level.
+ *
+ * input parameters
+ *
+ * @param       None
+ *
+ * output parameters
+ *
+ *              None.
+ *
+ * @return      None.
+ **************************************************************************************************
+ */
+void halRestoreSleepLevel( void )
+{
+  /* Stubs */
+}
+
+/**************************************************************************************************
+*/
@@ -0,0 +1,121 @@
+/**************************************************************************************************
+  Filename:       hal_startup.c
+  Revised:        $Date$
+  Revision:       $Revision$
+
+  Description:    Reset support for the host (POSIX) process.
+
+
+  Copyright 2026 The Z-Stack host port authors.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+
+    Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+    Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+    Neither the name of the copyright holder nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************************************************/
+
+/* ------------------------------------------------------------------------------------------------
+ *                                          Includes
+ * ------------------------------------------------------------------------------------------------
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "hal_mcu.h"
+
+/* ------------------------------------------------------------------------------------------------
+ *                                          Constants
+ * ------------------------------------------------------------------------------------------------
+ */
+
+#define HAL_MCU_ARGS_MAX      32
+#define HAL_MCU_CMDLINE_MAX   4096
+
+/* ------------------------------------------------------------------------------------------------
+ *                                       Global Variables
+ * ------------------------------------------------------------------------------------------------
+ */
+
+/* Stand-in for the 8051 EA bit; see hal_mcu.h. */
+uint8 halIntsEnabled = 0;
+
+/**************************************************************************************************
+ * @fn          halMcuReset
+ *
+ * @brief       Emulate a watchdog reset by re-executing the process image with the arguments it
+ *              was started with. The pty and NV file are re-opened by the new image, so a host
+ *              tool sees the same reset behaviour as with a real device. If the image cannot be
+ *              re-executed, the process exits.
+ *
+ * input parameters
+ *
+ * None.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      Does not return.
+ **************************************************************************************************
+ */
+void halMcuReset( void )
+{
+  static char cmdline[HAL_MCU_CMDLINE_MAX];
+  char *argv[HAL_MCU_ARGS_MAX+1];
+  char *pCmd = cmdline;
+  size_t len = 0;
+  int argc = 0;
+  FILE *fp;
+
+  HAL_DISABLE_INTERRUPTS();
+  (void)fflush(NULL);
+
+  if ((fp = fopen("/proc/self/cmdline", "rb")) != NULL)
+  {
+    len = fread(cmdline, 1, sizeof(cmdline) - 1, fp);
+    (void)fclose(fp);
+  }
+  cmdline[len] = '\0';
+
+  while ((pCmd < cmdline + len) && (argc < HAL_MCU_ARGS_MAX))
+  {
+    argv[argc++] = pCmd;
+    pCmd += strlen(pCmd) + 1;
+  }
+  argv[argc] = NULL;
+
+  if (argc != 0)
+  {
+    (void)execv("/proc/self/exe", argv);
+  }
+
+  exit(EXIT_FAILURE);
+}
+
+/**************************************************************************************************
+*/
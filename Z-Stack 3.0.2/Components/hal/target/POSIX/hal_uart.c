@@ -0,0 +1,624 @@
+/**************************************************************************************************
+  Filename:       hal_uart.c
+  Revised:        $Date$
+  Revision:       $Revision$
+
+  Description:    This file contains the interface to the H/W UART driver.
+                  Each port is a host pseudo-terminal.
+
+
+  Copyright 2026 Texas Instruments Incorporated. All rights reserved.
+
+  IMPORTANT: Your use of this Software is limited to those specific rights
+  granted under the terms of a software license agreement between the user
+  who downloaded the software, his/her employer (which must be your employer)
+  and Texas Instruments Incorporated (the "License").  You may not use this
+  Software unless you agree to abide by the terms of the License. The License
+  limits your use, and you acknowledge, that the Software may not be modified,
+  copied or distributed unless embedded on a Texas Instruments microcontroller
+  or used solely and exclusively in conjunction with a Texas Instruments radio
+  frequency transceiver, which is integrated into your product.  Other than for
+  the foregoing purpose, you may not use, reproduce, copy, prepare derivative
+  works of, modify, distribute, perform, display or sell this Software and/or
+  its documentation for any purpose.
+
+  YOU FURTHER ACKNOWLEDGE AND AGREE THAT THE SOFTWARE AND DOCUMENTATION ARE
+  PROVIDED AS IS WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+  INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF MERCHANTABILITY, TITLE,
+  NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT SHALL
+  TEXAS INSTRUMENTS OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER CONTRACT,
+  NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR OTHER
+  LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+  INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE
+  OR CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT
+  OF SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+  (INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+
+  Should you have any questions regarding your right to use this Software,
+  contact Texas Instruments Incorporated at www.TI.com.
+**************************************************************************************************/
+
+/*********************************************************************
+ * INCLUDES
+ */
+
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "hal_board_cfg.h"
+#include "hal_defs.h"
+#include "hal_types.h"
+#include "hal_uart.h"
+
+/*********************************************************************
+ * MACROS
+ */
+
+/*********************************************************************
+ * TYPEDEFS
+ */
+
+typedef struct
+{
+  int masterFd;                 // pty master, non-blocking; -1 when the port is closed
+  int slaveFd;                  // kept open so that the master never reads EIO between clients
+  uint8 rxBuf[HAL_UART_POSIX_RX_MAX];
+  uint16 rxHead;
+  uint16 rxTail;
+  uint8 txBuf[HAL_UART_POSIX_TX_MAX];
+  uint16 txHead;
+  uint16 txTail;
+  uint8 txMT;                   // Set when the Tx FIFO has drained; reported as HAL_UART_TX_EMPTY
+  halUARTCBack_t uartCB;
+  char link[128];               // Symlink published for the slave side; empty when there is none
+} uartPosixCfg_t;
+
+/*********************************************************************
+ * CONSTANTS
+ */
+
+#define HAL_UART_POSIX_HIGH       (HAL_UART_POSIX_RX_MAX / 2)
+
+/*********************************************************************
+ * GLOBAL VARIABLES
+ */
+
+/*********************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+/*********************************************************************
+ * LOCAL VARIABLES
+ */
+
+static uartPosixCfg_t uartCfg[HAL_UART_PORT_MAX];
+
+/*********************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+static uint16 HalUARTRxAvail( uartPosixCfg_t *cfg );
+static uint16 HalUARTTxAvail( uartPosixCfg_t *cfg );
+static void HalUARTFill( uartPosixCfg_t *cfg );
+static void HalUARTDrain( uartPosixCfg_t *cfg );
+static void HalUARTUnlink( void );
+static void HalUARTSignal( int sig );
+
+/******************************************************************************
+ * @fn      HalUARTInit
+ *
+ * @brief   Initialize the UART
+ *
+ * @param   none
+ *
+ * @return  none
+ *****************************************************************************/
+void HalUARTInit(void)
+{
+  uint8 port;
+
+  for (port = 0; port < HAL_UART_PORT_MAX; port++)
+  {
+    (void)memset(&uartCfg[port], 0, sizeof(uartPosixCfg_t));
+    uartCfg[port].masterFd = -1;
+    uartCfg[port].slaveFd = -1;
+  }
+
+  // The pty links name devices that vanish with this process, so remove them on the way out.
+  (void)atexit(HalUARTUnlink);
+  (void)signal(SIGINT, HalUARTSignal);
+  (void)signal(SIGTERM, HalUARTSignal);
+  (void)signal(SIGHUP, HalUARTSignal);
+}
+
+/******************************************************************************
+ * @fn      HalUARTOpen
+ *
+ * @brief   Open a port as a pseudo-terminal in raw mode and publish the name of its slave side
+ *          as a symlink, so that a host tool can open it like a serial device. The baud rate,
+ *          flow control and buffer sizes of the configuration have no meaning on a pty.
+ *
+ * @param   port   - UART port
+ *          config - contains configuration information
+ *
+ * @return  Status of the function call
+ *****************************************************************************/
+uint8 HalUARTOpen(uint8 port, halUARTCfg_t *config)
+{
+  uartPosixCfg_t *cfg;
+  struct termios tio;
+  char envName[16];
+  const char *link;
+  const char *slave;
+
+  if (port >= HAL_UART_PORT_MAX)
+  {
+    return HAL_UART_NOT_SUPPORTED;
+  }
+  cfg = &uartCfg[port];
+
+  if (cfg->masterFd < 0)
+  {
+    if (((cfg->masterFd = posix_openpt(O_RDWR | O_NOCTTY)) < 0) ||
+        (grantpt(cfg->masterFd) != 0) || (unlockpt(cfg->masterFd) != 0) ||
+        ((slave = ptsname(cfg->masterFd)) == NULL) ||
+        ((cfg->slaveFd = open(slave, O_RDWR | O_NOCTTY)) < 0))
+    {
+      HalUARTClose(port);
+      return HAL_UART_UNCONFIGURED;
+    }
+
+    (void)tcgetattr(cfg->slaveFd, &tio);
+    cfmakeraw(&tio);
+    (void)tcsetattr(cfg->slaveFd, TCSANOW, &tio);
+    (void)fcntl(cfg->masterFd, F_SETFL, fcntl(cfg->masterFd, F_GETFL) | O_NONBLOCK);
+    (void)fcntl(cfg->masterFd, F_SETFD, FD_CLOEXEC);
+    (void)fcntl(cfg->slaveFd, F_SETFD, FD_CLOEXEC);
+
+    (void)snprintf(envName, sizeof(envName), "HAL_UART%u_PTY", port);
+    if ((link = getenv(envName)) != NULL)
+    {
+      (void)snprintf(cfg->link, sizeof(cfg->link), "%s", link);
+    }
+    else
+    {
+      (void)snprintf(cfg->link, sizeof(cfg->link), "%s%u", HAL_UART_PTY_LINK, port);
+    }
+    (void)unlink(cfg->link);
+    if (symlink(slave, cfg->link) != 0)
+    {
+      cfg->link[0] = '\0';
+    }
+    (void)fprintf(stderr, "UART%u: %s\n", port, (cfg->link[0] != '\0') ? cfg->link : slave);
+  }
+
+  cfg->rxHead = cfg->rxTail = 0;
+  cfg->txHead = cfg->txTail = 0;
+  cfg->txMT = FALSE;
+  cfg->uartCB = config->callBackFunc;
+
+  return HAL_UART_SUCCESS;
+}
+
+/*****************************************************************************
+ * @fn      HalUARTRead
+ *
+ * @brief   Read a buffer from the UART
+ *
+ * @param   port - USART module designation
+ *          buf  - valid data buffer at least 'len' bytes in size
+ *          len  - max length number of bytes to copy to 'buf'
+ *
+ * @return  length of buffer that was read
+ *****************************************************************************/
+uint16 HalUARTRead(uint8 port, uint8 *buf, uint16 len)
+{
+  uartPosixCfg_t *cfg;
+  uint16 cnt = 0;
+
+  if (port >= HAL_UART_PORT_MAX)
+  {
+    return 0;
+  }
+  cfg = &uartCfg[port];
+
+  while ((cfg->rxHead != cfg->rxTail) && (cnt < len))
+  {
+    *buf++ = cfg->rxBuf[cfg->rxHead];
+    if (++cfg->rxHead >= HAL_UART_POSIX_RX_MAX)
+    {
+      cfg->rxHead = 0;
+    }
+    cnt++;
+  }
+
+  return cnt;
+}
+
+/******************************************************************************
+ * @fn      HalUARTWrite
+ *
+ * @brief   Write a buffer to the UART. As with the ISR driver, nothing is queued unless all of
+ *          'len' fits into the Tx FIFO.
+ *
+ * @param   port - UART port
+ *          buf  - pointer to the buffer that will be written, not freed
+ *          len  - length of
+ *
+ * @return  length of the buffer that was sent
+ *****************************************************************************/
+uint16 HalUARTWrite(uint8 port, uint8 *buf, uint16 len)
+{
+  uartPosixCfg_t *cfg;
+  uint16 cnt;
+
+  if (port >= HAL_UART_PORT_MAX)
+  {
+    return 0;
+  }
+  cfg = &uartCfg[port];
+
+  if ((cfg->masterFd < 0) || (HalUARTTxAvail(cfg) < len))
+  {
+    return 0;
+  }
+
+  for (cnt = 0; cnt < len; cnt++)
+  {
+    cfg->txBuf[cfg->txTail] = *buf++;
+    if (++cfg->txTail >= HAL_UART_POSIX_TX_MAX)
+    {
+      cfg->txTail = 0;
+    }
+  }
+
+  HalUARTDrain(cfg);
+
+  return len;
+}
+
+/******************************************************************************
+ * @fn      HalUARTSuspend
+ *
+ * @brief   Suspend UART hardware before entering PM mode 1, 2 or 3.
+ *
+ * @param   None
+ *
+ * @return  None
+ *****************************************************************************/
+void HalUARTSuspend( void )
+{
+}
+
+/******************************************************************************
+ * @fn      HalUARTResume
+ *
+ * @brief   Resume UART hardware after exiting PM mode 1, 2 or 3.
+ *
+ * @param   None
+ *
+ * @return  None
+ *****************************************************************************/
+void HalUARTResume( void )
+{
+}
+
+/***************************************************************************************************
+ * @fn      HalUARTPoll
+ *
+ * @brief   Move data between the ptys and the software FIFOs and report the resulting events.
+ *          A pty delivers whole bursts, so any received data is reported right away as
+ *          HAL_UART_RX_TIMEOUT instead of waiting for an idle period.
+ *
+ * @param   None
+ *
+ * @return  None
+ ***************************************************************************************************/
+void HalUARTPoll(void)
+{
+  uint8 port;
+
+  for (port = 0; port < HAL_UART_PORT_MAX; port++)
+  {
+    uartPosixCfg_t *cfg = &uartCfg[port];
+    uint16 cnt;
+    uint8 evt = 0;
+
+    if (cfg->masterFd < 0)
+    {
+      continue;
+    }
+
+    HalUARTDrain(cfg);
+    HalUARTFill(cfg);
+
+    if (cfg->uartCB == NULL)
+    {
+      continue;
+    }
+
+    cnt = HalUARTRxAvail(cfg);
+    if (cnt >= HAL_UART_POSIX_RX_MAX-1)
+    {
+      evt = HAL_UART_RX_FULL;
+    }
+    else if (cnt >= HAL_UART_POSIX_HIGH)
+    {
+      evt = HAL_UART_RX_ABOUT_FULL;
+    }
+    else if (cnt)
+    {
+      evt = HAL_UART_RX_TIMEOUT;
+    }
+
+    if (cfg->txMT)
+    {
+      cfg->txMT = FALSE;
+      evt |= HAL_UART_TX_EMPTY;
+    }
+
+    if (evt)
+    {
+      cfg->uartCB(port, evt);
+    }
+  }
+}
+
+/**************************************************************************************************
+ * @fn      Hal_UART_RxBufLen()
+ *
+ * @brief   Calculate Rx Buffer length - the number of bytes in the buffer.
+ *
+ * @param   port - UART port
+ *
+ * @return  length of current Rx Buffer
+ **************************************************************************************************/
+uint16 Hal_UART_RxBufLen( uint8 port )
+{
+  if (port >= HAL_UART_PORT_MAX)
+  {
+    return 0;
+  }
+
+  return HalUARTRxAvail(&uartCfg[port]);
+}
+
+/**************************************************************************************************
+ * @fn      Hal_UART_TxBufLen()
+ *
+ * @brief   Calculate the space left in the Tx Buffer.
+ *
+ * @param   port - UART port
+ *
+ * @return  number of bytes that can still be written
+ **************************************************************************************************/
+uint16 Hal_UART_TxBufLen( uint8 port )
+{
+  if (port >= HAL_UART_PORT_MAX)
+  {
+    return 0;
+  }
+
+  return HalUARTTxAvail(&uartCfg[port]);
+}
+
+/******************************************************************************
+ * @fn      HalUARTClose
+ *
+ * @brief   Close the UART
+ *
+ * @param   port - UART port
+ *
+ * @return  none
+ *****************************************************************************/
+void HalUARTClose(uint8 port)
+{
+  uartPosixCfg_t *cfg;
+
+  if (port >= HAL_UART_PORT_MAX)
+  {
+    return;
+  }
+  cfg = &uartCfg[port];
+
+  if (cfg->link[0] != '\0')
+  {
+    (void)unlink(cfg->link);
+    cfg->link[0] = '\0';
+  }
+  if (cfg->slaveFd >= 0)
+  {
+    (void)close(cfg->slaveFd);
+    cfg->slaveFd = -1;
+  }
+  if (cfg->masterFd >= 0)
+  {
+    (void)close(cfg->masterFd);
+    cfg->masterFd = -1;
+  }
+  cfg->uartCB = NULL;
+}
+
+/******************************************************************************
+ * @fn      halUARTFd
+ *
+ * @brief   Get the file descriptor of an open port, so that the idle wait can block on it.
+ *
+ * @param   port - UART port
+ *
+ * @return  pty master descriptor, or -1 if the port is not open
+ *****************************************************************************/
+int halUARTFd(uint8 port)
+{
+  return (port < HAL_UART_PORT_MAX) ? uartCfg[port].masterFd : -1;
+}
+
+/******************************************************************************
+ * @fn      halUARTTxPending
+ *
+ * @brief   Check whether a port still has Tx data that the pty did not accept.
+ *
+ * @param   port - UART port
+ *
+ * @return  TRUE if the Tx FIFO is not empty
+ *****************************************************************************/
+uint8 halUARTTxPending(uint8 port)
+{
+  return (port < HAL_UART_PORT_MAX) && (uartCfg[port].txHead != uartCfg[port].txTail);
+}
+
+/******************************************************************************
+ * @fn      HalUARTRxAvail
+ *
+ * @brief   Calculate Rx Buffer length - the number of bytes in the buffer.
+ *
+ * @param   cfg - port state
+ *
+ * @return  length of current Rx Buffer
+ *****************************************************************************/
+static uint16 HalUARTRxAvail( uartPosixCfg_t *cfg )
+{
+  return (cfg->rxTail >= cfg->rxHead) ? (cfg->rxTail - cfg->rxHead) :
+                                        (HAL_UART_POSIX_RX_MAX - cfg->rxHead + cfg->rxTail);
+}
+
+/******************************************************************************
+ * @fn      HalUARTTxAvail
+ *
+ * @brief   Calculate the free space in the Tx FIFO; one byte is kept unused to tell full from
+ *          empty.
+ *
+ * @param   cfg - port state
+ *
+ * @return  number of bytes that can still be queued
+ *****************************************************************************/
+static uint16 HalUARTTxAvail( uartPosixCfg_t *cfg )
+{
+  uint16 used = (cfg->txTail >= cfg->txHead) ? (cfg->txTail - cfg->txHead) :
+                                               (HAL_UART_POSIX_TX_MAX - cfg->txHead + cfg->txTail);
+
+  return (HAL_UART_POSIX_TX_MAX - 1 - used);
+}
+
+/******************************************************************************
+ * @fn      HalUARTFill
+ *
+ * @brief   Read whatever the pty has pending into the free space of the Rx FIFO.
+ *
+ * @param   cfg - port state
+ *
+ * @return  none
+ *****************************************************************************/
+static void HalUARTFill( uartPosixCfg_t *cfg )
+{
+  for (;;)
+  {
+    uint16 room;
+    ssize_t cnt;
+
+    if (cfg->rxTail >= cfg->rxHead)
+    {
+      room = HAL_UART_POSIX_RX_MAX - cfg->rxTail - ((cfg->rxHead == 0) ? 1 : 0);
+    }
+    else
+    {
+      room = cfg->rxHead - cfg->rxTail - 1;
+    }
+
+    if ((room == 0) || ((cnt = read(cfg->masterFd, cfg->rxBuf + cfg->rxTail, room)) <= 0))
+    {
+      break;
+    }
+
+    cfg->rxTail += (uint16)cnt;
+    if (cfg->rxTail >= HAL_UART_POSIX_RX_MAX)
+    {
+      cfg->rxTail = 0;
+    }
+  }
+}
+
+/******************************************************************************
+ * @fn      HalUARTDrain
+ *
+ * @brief   Write as much of the Tx FIFO as the pty accepts without blocking.
+ *
+ * @param   cfg - port state
+ *
+ * @return  none
+ *****************************************************************************/
+static void HalUARTDrain( uartPosixCfg_t *cfg )
+{
+  while (cfg->txHead != cfg->txTail)
+  {
+    uint16 len = (cfg->txTail > cfg->txHead) ? (cfg->txTail - cfg->txHead) :
+                                               (HAL_UART_POSIX_TX_MAX - cfg->txHead);
+    ssize_t cnt = write(cfg->masterFd, cfg->txBuf + cfg->txHead, len);
+
+    if (cnt <= 0)
+    {
+      return;
+    }
+
+    cfg->txHead += (uint16)cnt;
+    if (cfg->txHead >= HAL_UART_POSIX_TX_MAX)
+    {
+      cfg->txHead = 0;
+    }
+
+    if (cfg->txHead == cfg->txTail)
+    {
+      cfg->txMT = TRUE;
+    }
+  }
+}
+
+/******************************************************************************
+ * @fn      HalUARTUnlink
+ *
+ * @brief   Remove the pty symlinks published by HalUARTOpen. Registered with atexit() and
+ *          also called from the signal handler, so it only uses async-signal-safe calls.
+ *
+ * @param   none
+ *
+ * @return  none
+ *****************************************************************************/
+static void HalUARTUnlink( void )
+{
+  uint8 port;
+
+  for (port = 0; port < HAL_UART_PORT_MAX; port++)
+  {
+    if (uartCfg[port].link[0] != '\0')
+    {
+      (void)unlink(uartCfg[port].link);
+      uartCfg[port].link[0] = '\0';
+    }
+  }
+}
+
+/******************************************************************************
+ * @fn      HalUARTSignal
+ *
+ * @brief   Remove the pty symlinks when the process is stopped by a signal, which bypasses
+ *          atexit(), then let the signal terminate the process as it would have.
+ *
+ * @param   sig - signal number
+ *
+ * @return  none
+ *****************************************************************************/
+static void HalUARTSignal( int sig )
+{
+  HalUARTUnlink();
+  (void)signal(sig, SIG_DFL);
+  (void)raise(sig);
+}
+
+/******************************************************************************
+******************************************************************************/
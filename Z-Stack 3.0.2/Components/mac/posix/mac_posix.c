@@ -0,0 +1,416 @@
+/**************************************************************************************************
+  Filename:       mac_posix.c
+  Revised:        $Date$
+  Revision:       $Revision$
+
+  Description:    MAC stand-in for the host (POSIX) process: keeps the PIB
+                  and provides the 320 usec precision counter.
+
+
+  Copyright 2026 The Z-Stack host port authors.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+
+    Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+    Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+    Neither the name of the copyright holder nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************************************************/
+
+/* ------------------------------------------------------------------------------------------------
+ *                                          Includes
+ * ------------------------------------------------------------------------------------------------
+ */
+
+#include <time.h>
+
+#include "hal_mcu.h"
+#include "mac_api.h"
+#include "mac_low_level.h"
+#include "OSAL.h"
+
+/* ------------------------------------------------------------------------------------------------
+ *                                          Constants
+ * ------------------------------------------------------------------------------------------------
+ */
+
+/* The MAC precision counter ticks every 320 usecs (one backoff period). */
+#define MAC_POSIX_BACKOFF_NSEC      320000
+
+/* Largest PIB attribute kept by the stub; the beacon payload attribute holds a pointer. */
+#define MAC_POSIX_PIB_ATTR_LEN      SADDR_EXT_LEN
+
+#define MAC_POSIX_PIB_DEFAULT_CHAN  11
+
+/* ------------------------------------------------------------------------------------------------
+ *                                       Local Variables
+ * ------------------------------------------------------------------------------------------------
+ */
+
+/* OSAL task ID of the MAC */
+static uint8 macPosixTaskId;
+
+/* Attribute values indexed by PIB attribute ID */
+static uint8 macPosixPib[256][MAC_POSIX_PIB_ATTR_LEN];
+
+/* ------------------------------------------------------------------------------------------------
+ *                                       Local Functions
+ * ------------------------------------------------------------------------------------------------
+ */
+
+static uint8 macPosixPibLen(uint8 pibAttribute);
+static void macPosixPibReset(void);
+
+/**************************************************************************************************
+ * @fn          macPosixPibLen
+ *
+ * @brief       Return the size of a PIB attribute value.
+ *
+ * input parameters
+ *
+ * @param       pibAttribute - The attribute identifier.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      Size of the attribute value, in bytes.
+ **************************************************************************************************
+ */
+static uint8 macPosixPibLen(uint8 pibAttribute)
+{
+  switch (pibAttribute)
+  {
+    case MAC_COORD_EXTENDED_ADDRESS:
+    case MAC_EXTENDED_ADDRESS:
+      return SADDR_EXT_LEN;
+
+    case MAC_BEACON_PAYLOAD:
+      return sizeof(uint8 *);
+
+    case MAC_BEACON_TX_TIME:
+      return sizeof(uint32);
+
+    case MAC_COORD_SHORT_ADDRESS:
+    case MAC_PAN_ID:
+    case MAC_SHORT_ADDRESS:
+    case MAC_TRANSACTION_PERSISTENCE_TIME:
+    case MAC_MAX_FRAME_TOTAL_WAIT_TIME:
+    case MAC_RESPONSE_WAIT_TIME:
+      return sizeof(uint16);
+
+    default:
+      return sizeof(uint8);
+  }
+}
+
+/**************************************************************************************************
+ * @fn          macPosixPibReset
+ *
+ * @brief       Set the PIB attributes to their reset values. The extended address survives a
+ *              reset, as it does on the radio.
+ *
+ * input parameters
+ *
+ * None.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      None.
+ **************************************************************************************************
+ */
+static void macPosixPibReset(void)
+{
+  uint8 extAddr[SADDR_EXT_LEN];
+  uint16 noAddr = MAC_SHORT_ADDR_NONE;
+
+  osal_memcpy(extAddr, macPosixPib[MAC_EXTENDED_ADDRESS], SADDR_EXT_LEN);
+  osal_memset(macPosixPib, 0, sizeof(macPosixPib));
+  osal_memcpy(macPosixPib[MAC_EXTENDED_ADDRESS], extAddr, SADDR_EXT_LEN);
+
+  osal_memcpy(macPosixPib[MAC_COORD_SHORT_ADDRESS], &noAddr, sizeof(uint16));
+  osal_memcpy(macPosixPib[MAC_PAN_ID], &noAddr, sizeof(uint16));
+  osal_memcpy(macPosixPib[MAC_SHORT_ADDRESS], &noAddr, sizeof(uint16));
+  macPosixPib[MAC_BEACON_ORDER][0] = 15;
+  macPosixPib[MAC_SUPERFRAME_ORDER][0] = 15;
+  macPosixPib[MAC_LOGICAL_CHANNEL][0] = MAC_POSIX_PIB_DEFAULT_CHAN;
+  macPosixPib[MAC_DSN][0] = LO_UINT16(osal_rand());
+  macPosixPib[MAC_BSN][0] = LO_UINT16(osal_rand());
+}
+
+/**************************************************************************************************
+ * @fn          macMcuPrecisionCount
+ *
+ * @brief       Read the free running 320 usec backoff count. The host derives it from the
+ *              monotonic clock, which makes it the time base of the OSAL clock and timers.
+ *
+ * input parameters
+ *
+ * None.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      Number of 320 usec periods since an arbitrary fixed point; wraps at 32 bits.
+ **************************************************************************************************
+ */
+uint32 macMcuPrecisionCount(void)
+{
+  struct timespec ts;
+  uint64 nsec;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+  nsec = (uint64)ts.tv_sec * 1000000000ULL + (uint64)ts.tv_nsec;
+
+  return (uint32)(nsec / MAC_POSIX_BACKOFF_NSEC);
+}
+
+/**************************************************************************************************
+ * @fn          macTaskInit
+ *
+ * @brief       Initialize the MAC task. There is no radio, so the task only records its ID.
+ *
+ * input parameters
+ *
+ * @param       taskId - OSAL task ID of the MAC.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      None.
+ **************************************************************************************************
+ */
+void macTaskInit(uint8 taskId)
+{
+  macPosixTaskId = taskId;
+}
+
+/**************************************************************************************************
+ * @fn          macEventLoop
+ *
+ * @brief       MAC task event loop. Any queued message is released; no event is ever kept.
+ *
+ * input parameters
+ *
+ * @param       taskId - OSAL task ID of the MAC.
+ * @param       events - Pending events.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      Events not processed; always 0.
+ **************************************************************************************************
+ */
+uint16 macEventLoop(uint8 taskId, uint16 events)
+{
+  uint8 *pMsg;
+
+  (void)events;
+
+  while ((pMsg = osal_msg_receive(taskId)) != NULL)
+  {
+    (void)osal_msg_deallocate(pMsg);
+  }
+
+  return 0;
+}
+
+/**************************************************************************************************
+ * @fn          MAC_Init
+ *
+ * @brief       Initialize the MAC subsystem.
+ *
+ * input parameters
+ *
+ * None.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      None.
+ **************************************************************************************************
+ */
+void MAC_Init(void)
+{
+  osal_memset(macPosixPib[MAC_EXTENDED_ADDRESS], 0xFF, SADDR_EXT_LEN);
+  macPosixPibReset();
+}
+
+/**************************************************************************************************
+ * @fn          MAC_InitDevice
+ *
+ * @brief       Initialize the MAC for a device. Nothing to do on the host.
+ *
+ * input parameters
+ *
+ * None.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      None.
+ **************************************************************************************************
+ */
+void MAC_InitDevice(void)
+{
+}
+
+/**************************************************************************************************
+ * @fn          MAC_InitCoord
+ *
+ * @brief       Initialize the MAC for a coordinator. Nothing to do on the host.
+ *
+ * input parameters
+ *
+ * None.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      None.
+ **************************************************************************************************
+ */
+void MAC_InitCoord(void)
+{
+}
+
+/**************************************************************************************************
+ * @fn          MAC_MlmeResetReq
+ *
+ * @brief       Reset the MAC, optionally restoring the PIB to its reset values.
+ *
+ * input parameters
+ *
+ * @param       setDefaultPib - TRUE to reset the PIB.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      MAC_SUCCESS.
+ **************************************************************************************************
+ */
+uint8 MAC_MlmeResetReq(bool setDefaultPib)
+{
+  if (setDefaultPib)
+  {
+    macPosixPibReset();
+  }
+
+  return MAC_SUCCESS;
+}
+
+/**************************************************************************************************
+ * @fn          MAC_MlmeGetReq
+ *
+ * @brief       Read a PIB attribute.
+ *
+ * input parameters
+ *
+ * @param       pibAttribute - The attribute identifier.
+ *
+ * output parameters
+ *
+ * @param       pValue - Receives the attribute value.
+ *
+ * @return      MAC_SUCCESS.
+ **************************************************************************************************
+ */
+uint8 MAC_MlmeGetReq(uint8 pibAttribute, void *pValue)
+{
+  halIntState_t intState;
+
+  HAL_ENTER_CRITICAL_SECTION(intState);
+  osal_memcpy(pValue, macPosixPib[pibAttribute], macPosixPibLen(pibAttribute));
+  HAL_EXIT_CRITICAL_SECTION(intState);
+
+  return MAC_SUCCESS;
+}
+
+/**************************************************************************************************
+ * @fn          MAC_MlmeSetReq
+ *
+ * @brief       Write a PIB attribute. A NULL value restores the attribute reset value of 0.
+ *
+ * input parameters
+ *
+ * @param       pibAttribute - The attribute identifier.
+ * @param       pValue - Pointer to the attribute value.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      MAC_SUCCESS.
+ **************************************************************************************************
+ */
+uint8 MAC_MlmeSetReq(uint8 pibAttribute, void *pValue)
+{
+  halIntState_t intState;
+  uint8 len = macPosixPibLen(pibAttribute);
+
+  HAL_ENTER_CRITICAL_SECTION(intState);
+  if (pValue == NULL)
+  {
+    osal_memset(macPosixPib[pibAttribute], 0, len);
+  }
+  else
+  {
+    osal_memcpy(macPosixPib[pibAttribute], pValue, len);
+  }
+  HAL_EXIT_CRITICAL_SECTION(intState);
+
+  return MAC_SUCCESS;
+}
+
+/**************************************************************************************************
+ * @fn          macRadioSetTxPower
+ *
+ * @brief       Constrain a requested transmit power. Any value is accepted on the host.
+ *
+ * input parameters
+ *
+ * @param       txPower - Requested transmit power, in dBm.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      The transmit power that would be set.
+ **************************************************************************************************
+ */
+MAC_INTERNAL_API uint8 macRadioSetTxPower(uint8 txPower)
+{
+  return txPower;
+}
+
+/**************************************************************************************************
+*/
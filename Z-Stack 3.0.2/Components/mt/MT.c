@@ -247,6 +247,10 @@ mtProcessMsg_t mtProcessIncoming[] =
 byte debugThreshold;
 byte debugCompId;
 
+#if defined ( MT_EXT_FRAMES )
+uint8 MT_ExtFrames;
+#endif
+
 /**************************************************************************************************
  * LOCAL FUNCTIONS
  **************************************************************************************************/
@@ -256,6 +260,10 @@ void MT_ResetMsgQueue( void );
 byte MT_QueueMsg( byte *msg , byte len );
 void MT_ProcessQueue( void );
 
+#if defined ( MT_EXT_FRAMES )
+static uint8 MT_ExtFrameAccept( uint8 *pBuf );
+#endif
+
 #if defined ( MT_USER_TEST_FUNC )
 void MT_ProcessAppUserCmd( byte *pData );
 #endif
@@ -299,21 +307,27 @@ void MT_Init(uint8 taskID)
 /***************************************************************************************************
  * @fn      MT_BuildAndSendZToolResponse
  *
- * @brief   Build and send a ZTOOL msg
+ * @brief   Build and send a ZTOOL msg. Data longer than MT_RPC_DATA_MAX is sent in an extended
+ *          frame, up to MT_RPC_TX_DATA_MAX; longer data is not sent at all.
  * @param   uint8 cmdType - include type and subsystem
  *          uint8 cmdId - command ID
- *          byte dataLen
+ *          uint16 dataLen
  *          byte *pData
  *
  * @return  void
  ***************************************************************************************************/
 #if !defined(NPI)
-void MT_BuildAndSendZToolResponse(uint8 cmdType, uint8 cmdId, uint8 dataLen, uint8 *pData)
+void MT_BuildAndSendZToolResponse(uint8 cmdType, uint8 cmdId, uint16 dataLen, uint8 *pData)
 {
   uint8 *msg_ptr;
 
+  if (dataLen > MT_RPC_TX_DATA_MAX)
+  {
+    return;
+  }
+
 #ifdef FEATURE_DUAL_MAC
-  msg_ptr = DMMGR_BuildRspMsg( cmdType, cmdId, dataLen, pData );
+  msg_ptr = DMMGR_BuildRspMsg( cmdType, cmdId, (uint8)dataLen, pData );
 
   if ( msg_ptr )
   {
@@ -322,10 +336,21 @@ void MT_BuildAndSendZToolResponse(uint8 cmdType, uint8 cmdId, uint8 dataLen, uin
 #else
   if ((msg_ptr = MT_TransportAlloc((mtRpcCmdType_t)(cmdType & 0xE0), dataLen)) != NULL)
   {
-    msg_ptr[MT_RPC_POS_LEN] = dataLen;
+#if defined ( MT_EXT_FRAMES )
+    if (dataLen > MT_RPC_DATA_MAX)
+    {
+      msg_ptr[MT_RPC_POS_LEN] = MT_RPC_EXT_LEN;
+      msg_ptr[MT_RPC_POS_EXT_LEN] = LO_UINT16(dataLen);
+      msg_ptr[MT_RPC_POS_EXT_LEN+1] = HI_UINT16(dataLen);
+    }
+    else
+#endif
+    {
+      msg_ptr[MT_RPC_POS_LEN] = (uint8)dataLen;
+    }
     msg_ptr[MT_RPC_POS_CMD0] = cmdType;
     msg_ptr[MT_RPC_POS_CMD1] = cmdId;
-    (void)osal_memcpy(msg_ptr+MT_RPC_POS_DAT0, pData, dataLen);
+    (void)osal_memcpy(MT_RPC_DATA_PTR(msg_ptr), pData, dataLen);
 
     MT_TransportSend(msg_ptr);
   }
@@ -350,8 +375,21 @@ void MT_ProcessIncoming(uint8 *pBuf)
   rsp[1] = pBuf[MT_RPC_POS_CMD0];
   rsp[2] = pBuf[MT_RPC_POS_CMD1];
 
+#if defined ( MT_EXT_FRAMES )
+  /* A host running version negotiation in a general format frame may not take extended frames */
+  if ((rsp[1] == ((uint8)MT_RPC_CMD_SREQ | (uint8)MT_RPC_SYS_SYS)) && (rsp[2] == MT_SYS_VERSION)
+      && !MT_RPC_IS_EXT(pBuf))
+  {
+    MT_ExtFrames = FALSE;
+  }
+#endif
+
   /* check length */
-  if (pBuf[MT_RPC_POS_LEN] > MT_RPC_DATA_MAX)
+  if ((pBuf[MT_RPC_POS_LEN] > MT_RPC_DATA_MAX)
+#if defined ( MT_EXT_FRAMES )
+      && !MT_ExtFrameAccept(pBuf)
+#endif
+     )
   {
     rsp[0] = MT_RPC_ERR_LENGTH;
   }
@@ -383,6 +421,79 @@ void MT_ProcessIncoming(uint8 *pBuf)
   }
 }
 
+#if defined ( MT_EXT_FRAMES )
+/***************************************************************************************************
+ * @fn      MT_ExtFramesAvail
+ *
+ * @brief   Check if the transport in use carries extended frames. The ZNP SPI transport does not.
+ *
+ * @param   None
+ *
+ * @return  TRUE if extended frames can be used, FALSE otherwise
+ ***************************************************************************************************/
+uint8 MT_ExtFramesAvail(void)
+{
+#if defined ( ZNP_CFG1_UART ) && !defined ( CC2531ZNP )
+  return (znpCfg1 == ZNP_CFG1_UART);
+#else
+  return TRUE;
+#endif
+}
+
+/***************************************************************************************************
+ * @fn      MT_ExtFrameAccept
+ *
+ * @brief   Check an incoming extended frame. The first extended frame from the host turns on
+ *          extended frames towards the host. A frame whose data fits MT_RPC_DATA_MAX is turned
+ *          into a general format frame in place, so that all commands can take it; longer data
+ *          is only passed to the commands that parse extended frames.
+ *
+ * @param   pBuf - pointer to the incoming frame
+ *
+ * @return  TRUE if the frame can be processed, FALSE otherwise
+ ***************************************************************************************************/
+static uint8 MT_ExtFrameAccept( uint8 *pBuf )
+{
+  uint16 dataLen;
+
+  if (!MT_RPC_IS_EXT(pBuf) || !MT_ExtFramesAvail())
+  {
+    return FALSE;
+  }
+
+  MT_ExtFrames = TRUE;
+  dataLen = MT_RPC_DATA_LEN(pBuf);
+
+  if (dataLen <= MT_RPC_DATA_MAX)
+  {
+    /* Move the data down over the 2-byte length */
+    pBuf[MT_RPC_POS_LEN] = (uint8)dataLen;
+    (void)osal_memcpy(pBuf + MT_RPC_POS_DAT0, pBuf + MT_RPC_EXT_HDR_SZ, dataLen);
+    return TRUE;
+  }
+
+  switch (((uint16)pBuf[MT_RPC_POS_CMD0] << 8) | pBuf[MT_RPC_POS_CMD1])
+  {
+#if defined ( MT_SYS_FUNC )
+    case ((((uint16)MT_RPC_CMD_SREQ | MT_RPC_SYS_SYS) << 8) | MT_SYS_OSAL_NV_WRITE_EXT):
+#if defined ( OSAL_NV_BULK )
+    case ((((uint16)MT_RPC_CMD_SREQ | MT_RPC_SYS_SYS) << 8) | MT_SYS_OSAL_NV_RESTORE):
+#endif
+      return TRUE;
+#endif
+
+#if defined ( MT_AF_FUNC )
+    case ((((uint16)MT_RPC_CMD_SREQ | MT_RPC_SYS_AF) << 8) | MT_AF_DATA_REQUEST_EXT):
+    case ((((uint16)MT_RPC_CMD_AREQ | MT_RPC_SYS_AF) << 8) | MT_AF_DATA_REQUEST_EXT):
+      return TRUE;
+#endif
+
+    default:
+      return FALSE;
+  }
+}
+#endif
+
 /***************************************************************************************************
  * @fn      MTProcessAppRspMsg
  *
@@ -103,6 +103,11 @@ extern "C"
 #define MT_SYS_ZDIAGS_SAVE_STATS_TO_NV       0x1B
 #define MT_SYS_OSAL_NV_READ_EXT              0x1C
 #define MT_SYS_OSAL_NV_WRITE_EXT             0x1D
+#define MT_SYS_OSAL_PROFILER                 0x1E
+#define MT_SYS_HEAP_SITES                    0x1F
+#define MT_SYS_OSAL_NV_DUMP                  0x20
+#define MT_SYS_OSAL_NV_RESTORE               0x21
+#define MT_SYS_ZNP_UART_TX_STATS             0x22
 
 /* Extended Non-Vloatile Memory */
 #define MT_SYS_NV_CREATE                     0x30
@@ -127,6 +132,22 @@ extern "C"
 #define MT_SYS_SNIFFER_ENABLE        1
 #define MT_SYS_SNIFFER_GET_SETTING   2
 
+#define MT_SYS_OSAL_PROF_GET_HIST    0
+#define MT_SYS_OSAL_PROF_GET_RING    1
+#define MT_SYS_OSAL_PROF_RESET       2
+
+#define MT_SYS_HEAP_SITES_GET        0
+#define MT_SYS_HEAP_SITES_RESET      1
+
+#define MT_SYS_ZNP_UART_TX_STATS_GET   0
+#define MT_SYS_ZNP_UART_TX_STATS_CLEAR 1
+
+/* MT_SYS_OSAL_NV_DUMP record length flag: the item does not fit a frame and carries no data */
+#define MT_SYS_NV_DUMP_NO_DATA       0x8000
+
+/* MT_SYS_OSAL_NV_RESTORE options */
+#define MT_SYS_NV_RESTORE_COMPACT    0x01
+
 /***************************************************************************************************
  * MAC COMMANDS
  ***************************************************************************************************/
@@ -879,10 +900,33 @@ extern MT_msg_queue_t *_pMtMsgQueue;
 extern MT_msg_queue_t *_pLastInQueue;
 extern MT_msg_queue_t *_pCurQueueElem;
 
+#if defined ( MT_EXT_FRAMES )
+/* Set once the host has sent an extended frame; until then only general format frames are sent.
+ * Cleared again by SYS_RESET_REQ and by a SYS_VERSION request sent in a general format frame.
+ */
+extern uint8 MT_ExtFrames;
+
+/* Maximum data length of an extended frame sent to the host. The MT task transport writes each
+ * frame to the UART driver in one call, so its frames must also fit the driver TX buffer.
+ */
+#if defined ( MT_TASK )
+#define MT_RPC_EXT_TX_MAX   MIN(MT_RPC_EXT_DATA_MAX, \
+                                MT_UART_DEFAULT_MAX_TX_BUFF - MT_UART_FRAME_OVHD - MT_RPC_EXT_HDR_SZ)
+#else
+#define MT_RPC_EXT_TX_MAX   MT_RPC_EXT_DATA_MAX
+#endif
+
+/* Maximum data length of a frame that can be sent to the host now */
+#define MT_RPC_TX_DATA_MAX  ((MT_ExtFrames && (MT_RPC_EXT_TX_MAX > MT_RPC_DATA_MAX)) ? \
+                             MT_RPC_EXT_TX_MAX : MT_RPC_DATA_MAX)
+#else
+#define MT_RPC_TX_DATA_MAX  MT_RPC_DATA_MAX
+#endif
+
 /*
  * Build and send a ZTool response message
  */
-extern void MT_BuildAndSendZToolResponse(uint8 cmdType, uint8 cmdId, uint8 dataLen, uint8 *dataPtr);
+extern void MT_BuildAndSendZToolResponse(uint8 cmdType, uint8 cmdId, uint16 dataLen, uint8 *dataPtr);
 
 /*
  * Temp test function
@@ -927,13 +971,20 @@ extern void MT_ProcessIncoming(uint8 *pBuf);
 /*
  * Callback function to allocate message buffer
  */
-extern uint8 *MT_TransportAlloc(uint8 cmd0, uint8 len);
+extern uint8 *MT_TransportAlloc(uint8 cmd0, uint16 len);
 
 /*
  * Callback function to send message buffer
  */
 extern void MT_TransportSend(uint8 *pBuf);
 
+#if defined ( MT_EXT_FRAMES )
+/*
+ * Check if the transport in use carries extended frames
+ */
+extern uint8 MT_ExtFramesAvail(void);
+#endif
+
 /*
  * Utility function to build endpoint descriptor from incoming buffer
  */
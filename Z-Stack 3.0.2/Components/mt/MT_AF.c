@@ -343,12 +343,13 @@ static void MT_AfDataRequest(uint8 *pBuf)
   uint8 transId, txOpts, radius;
   uint8 cmd0, cmd1;
   uint8 retValue = ZFailure;
-  uint16 dataLen, tempLen;
+  uint16 dataLen, tempLen, frameLen;
 
   /* Parse header */
   cmd0 = pBuf[MT_RPC_POS_CMD0];
   cmd1 = pBuf[MT_RPC_POS_CMD1];
-  pBuf += MT_RPC_FRAME_HDR_SZ;
+  frameLen = MT_RPC_DATA_LEN(pBuf);
+  pBuf = MT_RPC_DATA_PTR(pBuf);
 
   if (cmd1 == MT_AF_DATA_REQUEST_EXT)
   {
@@ -413,8 +414,9 @@ static void MT_AfDataRequest(uint8 *pBuf)
   {
     retValue = afStatus_INVALID_PARAMETER;
   }
-  else if (tempLen > (uint16)MT_RPC_DATA_MAX)
+  else if ((tempLen > (uint16)MT_RPC_DATA_MAX) && (tempLen > frameLen))
   {
+    /* The data did not come in an extended frame; the host will MT_AF_DATA_STORE it */
     if (pMtAfDataReq != NULL)
     {
       retValue = afStatus_INVALID_PARAMETER;
@@ -685,7 +687,7 @@ void MT_AfIncomingMsg(afIncomingMSGPacket_t *pMsg)
     respLen += MT_AF_INC_MSG_EXT;
   }
 
-  if (respLen > (uint16)MT_RPC_DATA_MAX)
+  if (respLen > (uint16)MT_RPC_TX_DATA_MAX)
   {
     if ((pItem = (mtAfInMsgList_t *)osal_mem_alloc(sizeof(mtAfInMsgList_t) + dataLen)) == NULL)
     {
@@ -50,6 +50,7 @@
 #include "bdb.h"
 #include "bdb_interface.h"
 #include "ZDApp.h"
+#include "ZDSecMgr.h"
  
 /***************************************************************************************************
 * LOCAL FUNCTIONs
@@ -323,6 +324,7 @@ static void MT_AppCnfBDBAddInstallCode(uint8* pBuf)
     break;
     case BDB_INSTALL_CODE_USE_KEY:
       retValue = APSME_AddTCLinkKey(pBuf,pExtAddr);
+      ZDSecMgrTCLKIndexReload();
     break;
   }
   
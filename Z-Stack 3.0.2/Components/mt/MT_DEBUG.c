@@ -45,13 +45,17 @@
 #include "MT.h"
 #include "MT_DEBUG.h"
 #include "MT_UART.h"
+#if !defined HAL_MCU_POSIX
 #include "mac_main.h"
 #include "mac_data.h"
 #include "mac_rx.h"
 #include "mac_tx.h"
+#endif
 #include "nwk_globals.h"
 #include "nwk_util.h"
+#if !defined HAL_MCU_POSIX
 #include "mac_radio_defs.h"
+#endif
 #include "OSAL_Nv.h"
 
 #include "bdb.h"
@@ -242,6 +246,10 @@ static void MT_DebugMacDataDump(void)
   *pBuf++ = BREAK_UINT32(rxCrcSuccess, 2);
   *pBuf++ = BREAK_UINT32(rxCrcSuccess, 3);
 #endif
+#if defined HAL_MCU_POSIX
+  // The host has no radio or low level MAC to report on.
+  (void)osal_memset(pBuf, 0, (uint16)(buf + sizeof(buf) - pBuf));
+#else
 #if defined MAC_RADIO_CC2520
   *pBuf++ = macSpiReadReg(FSMSTAT0);
   *pBuf++ = macSpiReadReg(FSMSTAT1);
@@ -254,6 +262,7 @@ static void MT_DebugMacDataDump(void)
   *pBuf++ = macMain.state;
   *pBuf++ = macRxActive;
   *pBuf   = macTxActive;
+#endif
 
   MT_BuildAndSendZToolResponse(((uint8)MT_RPC_CMD_SRSP | (uint8)MT_RPC_SYS_DBG),
                                        MT_DEBUG_MAC_DATA_DUMP, sizeof(buf), buf);
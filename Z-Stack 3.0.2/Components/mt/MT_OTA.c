@@ -147,7 +147,7 @@ uint8 MT_OtaFileReadReq(afAddrType_t *pAddr, zclOTA_FileID_t *pFileId, uint8 len
 
   // Check if the requested length is longer than the RX receive buffer
   if (len + MT_OTA_FILE_READ_RSP_LEN + SPI_0DATA_MSG_LEN > MT_UART_RX_BUFF_MAX)
-    return 0;
+    return ZInvalidParameter;
   
   // Get length
   msgLen = MT_OTA_FILE_READ_REQ_LEN;
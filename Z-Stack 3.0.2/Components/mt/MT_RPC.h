@@ -76,6 +76,30 @@ extern "C" {
 #define MT_RPC_POS_CMD1       2
 #define MT_RPC_POS_DAT0       3
 
+/* Extended frame format (MT_EXT_FRAMES), for data longer than MT_RPC_DATA_MAX. The length byte
+ * is MT_RPC_EXT_LEN and the 2-byte data length follows the command field, LSB first:
+ * | 0xFF | CMD0 | CMD1 | LEN_LO | LEN_HI | DATA |
+ * so the command field is where it is in the general format frame. On the UART the frame is
+ * wrapped with SOF and FCS as usual, the FCS covering all bytes of the above.
+ */
+#define MT_RPC_EXT_LEN        0xFF
+#define MT_RPC_EXT_HDR_SZ     5
+#define MT_RPC_POS_EXT_LEN    3
+
+/* Maximum length of data in an extended frame, limited by heap for the frame buffers */
+#if !defined MT_RPC_EXT_DATA_MAX
+#define MT_RPC_EXT_DATA_MAX   1024
+#endif
+
+/* Data length, data pointer and header size of a general format or extended frame */
+#define MT_RPC_IS_EXT(pBuf)   ((pBuf)[MT_RPC_POS_LEN] == MT_RPC_EXT_LEN)
+#define MT_RPC_HDR_SZ(pBuf)   (MT_RPC_IS_EXT(pBuf) ? MT_RPC_EXT_HDR_SZ : MT_RPC_FRAME_HDR_SZ)
+#define MT_RPC_DATA_LEN(pBuf) (MT_RPC_IS_EXT(pBuf) ?                                         \
+                               BUILD_UINT16((pBuf)[MT_RPC_POS_EXT_LEN],                         \
+                                            (pBuf)[MT_RPC_POS_EXT_LEN+1]) :                     \
+                               (uint16)(pBuf)[MT_RPC_POS_LEN])
+#define MT_RPC_DATA_PTR(pBuf) ((pBuf) + MT_RPC_HDR_SZ(pBuf))
+
 /* Error codes */
 #define MT_RPC_SUCCESS        0     /* success */
 #define MT_RPC_ERR_SUBSYSTEM  1     /* invalid subsystem */
@@ -45,8 +45,8 @@
 #include "MT_SYS.h"
 #include "MT_VERSION.h"
 #include "OSAL.h"
-#include "OSAL_NV.h"
-#include "Onboard.h"
+#include "OSAL_Nv.h"
+#include "OnBoard.h"
 #include "OSAL_Clock.h"
 #include "mac_low_level.h"
 #include "ZMAC.h"
@@ -57,6 +57,7 @@
 #endif
 #if !defined( CC253X_MACNP )
   #include "ZGlobals.h"
+  #include "ZDSecMgr.h"
 #endif
 #if defined( FEATURE_NVEXID )
   #include "zstackconfig.h"
@@ -67,6 +68,9 @@
 #if defined( FEATURE_SYSTEM_STATS )
 #include "ZDiags.h"
 #endif
+#if defined( MT_ZNP_FUNC )
+  #include "znp_app.h"
+#endif
 #if defined( MT_SYS_JAMMER_FEATURE )
   #include "mac_rx.h"
   #include "mac_radio_defs.h"
@@ -90,6 +94,14 @@
 /* Max possible MT response data length, MT protocol overhead */
 #define MT_MAX_RSP_DATA_LEN  ( (MT_MAX_RSP_LEN - 1) - SPI_0DATA_MSG_LEN )
 
+/* Max MT response data length once the host has sent an extended frame */
+#if defined( MT_EXT_FRAMES )
+#define MT_MAX_RSP_EXT_DATA_LEN  ( (MT_ExtFrames && (MT_RPC_EXT_TX_MAX > MT_MAX_RSP_DATA_LEN)) ? \
+                                   MT_RPC_EXT_TX_MAX : MT_MAX_RSP_DATA_LEN )
+#else
+#define MT_MAX_RSP_EXT_DATA_LEN  MT_MAX_RSP_DATA_LEN
+#endif
+
 #define MT_SYS_DEVICE_INFO_RESPONSE_LEN 14
 
 #if !defined HAL_GPIO || !HAL_GPIO
@@ -228,6 +240,11 @@ static void MT_SysOsalNVLength(uint8 *pBuf);
 static void MT_SysOsalNVRead(uint8 *pBuf);
 static void MT_SysOsalNVWrite(uint8 *pBuf);
 static uint8 MT_CheckNvId(uint16 nvId);
+static void MT_SysNvChanged(uint16 nvId);
+#if defined( OSAL_NV_BULK )
+static void MT_SysOsalNVDump(uint8 *pBuf);
+static void MT_SysOsalNVRestore(uint8 *pBuf);
+#endif /* OSAL_NV_BULK */
 #if defined( FEATURE_NVEXID )
 static void MT_SysNvCompact(uint8 *pBuf);
 static void MT_SysNvCreate(uint8 *pBuf);
@@ -245,6 +262,15 @@ static void MT_SysJammerParameters( uint8 *pBuf );
 #if defined( MT_SYS_SNIFFER_FEATURE )
 static void MT_SysSnifferParameters( uint8 *pBuf );
 #endif /* MT_SYS_SNIFFER_FEATURE */
+#if defined( OSAL_PROFILER )
+static void MT_SysOsalProfiler(uint8 *pBuf);
+#endif /* OSAL_PROFILER */
+#if ( OSALMEM_SITES )
+static void MT_SysHeapSites(uint8 *pBuf);
+#endif /* OSALMEM_SITES */
+#if defined( MT_ZNP_FUNC )
+static void MT_SysZnpUartTxStats(uint8 *pBuf);
+#endif /* MT_ZNP_FUNC */
 #if defined( FEATURE_SYSTEM_STATS )
 static void MT_SysZDiagsInitStats(void);
 static void MT_SysZDiagsClearStats(uint8 *pBuf);
@@ -358,6 +384,16 @@ uint8 MT_SysCommandProcessing(uint8 *pBuf)
       MT_SysOsalNVWrite(pBuf);
       break;
 
+#if defined( OSAL_NV_BULK )
+    case MT_SYS_OSAL_NV_DUMP:
+      MT_SysOsalNVDump(pBuf);
+      break;
+
+    case MT_SYS_OSAL_NV_RESTORE:
+      MT_SysOsalNVRestore(pBuf);
+      break;
+#endif /* OSAL_NV_BULK */
+
 #if defined( FEATURE_NVEXID )
     case MT_SYS_NV_COMPACT:
       MT_SysNvCompact(pBuf);
@@ -400,6 +436,24 @@ uint8 MT_SysCommandProcessing(uint8 *pBuf)
 #endif  /* MT_SYS_SNIFFER_FEATURE */
 #endif /* !CC26XX */
 
+#if defined( OSAL_PROFILER )
+    case MT_SYS_OSAL_PROFILER:
+      MT_SysOsalProfiler(pBuf);
+      break;
+#endif /* OSAL_PROFILER */
+
+#if ( OSALMEM_SITES )
+    case MT_SYS_HEAP_SITES:
+      MT_SysHeapSites(pBuf);
+      break;
+#endif /* OSALMEM_SITES */
+
+#if defined( MT_ZNP_FUNC )
+    case MT_SYS_ZNP_UART_TX_STATS:
+      MT_SysZnpUartTxStats(pBuf);
+      break;
+#endif /* MT_ZNP_FUNC */
+
 #if defined( FEATURE_SYSTEM_STATS )
     case MT_SYS_ZDIAGS_INIT_STATS:
       MT_SysZDiagsInitStats();
@@ -440,6 +494,11 @@ uint8 MT_SysCommandProcessing(uint8 *pBuf)
  *****************************************************************************/
 void MT_SysReset( uint8 *pBuf )
 {
+#if defined( MT_EXT_FRAMES )
+  /* The host that connects after the reset has to negotiate extended frames again */
+  MT_ExtFrames = FALSE;
+#endif
+
   switch( pBuf[MT_RPC_POS_DAT0] )
   {
     case MT_SYS_RESET_HARD:
@@ -503,11 +562,27 @@ static void MT_SysPing(void)
 static void MT_SysVersion(void)
 {
 #if !defined( INCLUDE_REVISION_INFORMATION )
+#if !defined( MT_EXT_FRAMES )
   /* Build and send back the default response */
   MT_BuildAndSendZToolResponse( MT_SRSP_SYS, MT_SYS_VERSION,
                                 sizeof(MTVersionString),(uint8*)MTVersionString);
 #else
+  uint8 verStr[sizeof(MTVersionString) + 1];
+
+  osal_memcpy(verStr, (uint8 *)MTVersionString, sizeof(MTVersionString));
+
+  /* Trailing transport capability byte */
+  verStr[sizeof(MTVersionString)] = MT_ExtFramesAvail() ? MT_VERSION_CAP_EXT_FRAMES : 0;
+
+  MT_BuildAndSendZToolResponse( MT_SRSP_SYS, MT_SYS_VERSION,
+                                sizeof(verStr), verStr);
+#endif
+#else
+#if !defined( MT_EXT_FRAMES )
   uint8 verStr[sizeof(MTVersionString) + 4];
+#else
+  uint8 verStr[sizeof(MTVersionString) + 4 + 1];
+#endif
   uint8 *pBuf = &verStr[sizeof(MTVersionString)];
 #if (defined MAKE_CRC_SHDW) || (defined FAKE_CRC_SHDW)  //built for bootloader
   uint32 sblSig;
@@ -541,6 +616,11 @@ static void MT_SysVersion(void)
   // Plug the SBL revision indication
   UINT32_TO_BUF_LITTLE_ENDIAN(pBuf,sblRev);
 
+#if defined( MT_EXT_FRAMES )
+  // Trailing transport capability byte
+  *pBuf = MT_ExtFramesAvail() ? MT_VERSION_CAP_EXT_FRAMES : 0;
+#endif
+
   /* Build and send back the response */
   MT_BuildAndSendZToolResponse( MT_SRSP_SYS, MT_SYS_VERSION,
                                 sizeof(verStr), verStr);
@@ -635,6 +715,27 @@ static uint8 MT_CheckNvId( uint16 nvId )
   return( ZSuccess );
 }
 
+/******************************************************************************
+ * @fn      MT_SysNvChanged
+ *
+ * @brief   Let the stack reload RAM copies of an NV item changed by the host
+ *
+ * @param   nvId - NV item ID
+ *
+ * @return  None
+ *****************************************************************************/
+static void MT_SysNvChanged( uint16 nvId )
+{
+#if !defined( CC253X_MACNP )
+  if ( (nvId >= ZCD_NV_TCLK_TABLE_START) && (nvId <= ZCD_NV_TCLK_TABLE_END) )
+  {
+    ZDSecMgrTCLKIndexSet( nvId, NULL );
+  }
+#else
+  (void)nvId;
+#endif
+}
+
 /******************************************************************************
  * @fn      MT_SysOsalNVRead
  *
@@ -719,13 +820,20 @@ static void MT_SysOsalNVRead(uint8 *pBuf)
   if( error == ZSuccess )
   {
     uint8 *pRetBuf;
-    uint8 respLen = 2;  /* Response header: [0]=status,[1]=length */
+    uint16 respLen = 2;  /* Response header: [0]=status,[1]=length */
+    uint16 maxLen = MT_MAX_RSP_DATA_LEN;
+
+    if( cmdId == MT_SYS_OSAL_NV_READ_EXT )
+    {
+      /* Return as much as fits one frame, extended if the host speaks them */
+      maxLen = MT_MAX_RSP_EXT_DATA_LEN;
+    }
 
     dataLen = nvItemLen - dataOfs;
-    if (dataLen > (uint16)(MT_MAX_RSP_DATA_LEN - respLen))
+    if (dataLen > (uint16)(maxLen - respLen))
     {
       /* Data length is limited by TX buffer size and MT protocol */
-      dataLen = (MT_MAX_RSP_DATA_LEN - respLen);
+      dataLen = (maxLen - respLen);
     }
     respLen += dataLen;
 
@@ -736,7 +844,8 @@ static void MT_SysOsalNVRead(uint8 *pBuf)
       if (((osal_nv_read( nvId, dataOfs, dataLen, &pRetBuf[2] )) == ZSUCCESS))
       {
         pRetBuf[0] = ZSuccess;
-        pRetBuf[1] = dataLen;
+        /* 0xFF: the data runs to the end of an extended frame */
+        pRetBuf[1] = (dataLen < 0xFF) ? (uint8)dataLen : 0xFF;
         MT_BuildAndSendZToolResponse( MT_SRSP_SYS, cmdId,
                                       respLen, pRetBuf );
       }
@@ -781,8 +890,8 @@ static void MT_SysOsalNVWrite(uint8 *pBuf)
 
   /* MT command ID */
   cmdId = pBuf[MT_RPC_POS_CMD1];
-  /* Skip over RPC header */
-  pBuf += MT_RPC_FRAME_HDR_SZ;
+  /* Skip over RPC header, which is longer for an extended frame */
+  pBuf = MT_RPC_DATA_PTR(pBuf);
 
   /* NV item ID */
   nvId = osal_build_uint16( pBuf );
@@ -836,6 +945,8 @@ static void MT_SysOsalNVWrite(uint8 *pBuf)
       {
         rtrn = ZMacSetReq(ZMacExtAddr, pBuf);
       }
+
+      MT_SysNvChanged( nvId );
     }
     else
     {
@@ -906,6 +1017,8 @@ static void MT_SysOsalNVItemInit(uint8 *pBuf)
       /* Attempt to create/initialize a new NV item */
       ret = osal_nv_item_init( nvId, nvLen, pBuf );
     }
+
+    MT_SysNvChanged( nvId );
   }
 
   /* Build and send back the response */
@@ -949,6 +1062,8 @@ static void MT_SysOsalNVDelete(uint8 *pBuf)
   {
     /* Attempt to delete the NV item */
     ret = osal_nv_delete( nvId, nvLen );
+
+    MT_SysNvChanged( nvId );
   }
 
   /* Build and send back the response */
@@ -998,6 +1113,214 @@ static void MT_SysOsalNVLength(uint8 *pBuf)
                                 sizeof(rsp), rsp);
 }
 
+#if defined( OSAL_NV_BULK )
+/******************************************************************************
+ * @fn      MT_SysOsalNVDump
+ *
+ * @brief   Read as many whole NV items as fit in one response, in item Id order.
+ *          Items that MT_CheckNvId() blocks are left out. An item too long for
+ *          any frame is listed with MT_SYS_NV_DUMP_NO_DATA set in its length,
+ *          to be read with MT_SYS_OSAL_NV_READ_EXT.
+ *
+ * @param   pBuf - MT message containing the Id of the last item received,
+ *                 zero to start from the first item
+ *
+ * @return  None
+ *****************************************************************************/
+static void MT_SysOsalNVDump(uint8 *pBuf)
+{
+  uint8 *retBuf;
+  uint8 *pRsp;
+  uint8 *pCnt;
+  uint16 rspMax;
+  uint16 nvId;
+
+  /* Skip over RPC header */
+  pBuf += MT_RPC_FRAME_HDR_SZ;
+
+  nvId = osal_build_uint16( pBuf );
+
+  /* Fill the largest frame that the host can take now */
+  rspMax = MT_MAX_RSP_EXT_DATA_LEN;
+  retBuf = osal_mem_alloc( rspMax );
+
+  if ( retBuf == NULL )
+  {
+    uint8 status = ZMemError;
+    MT_BuildAndSendZToolResponse( MT_SRSP_SYS, MT_SYS_OSAL_NV_DUMP,
+                                  sizeof(status), &status );
+    return;
+  }
+
+  /* Response header: status, Id of the last item in the response, item count */
+  retBuf[0] = ZSuccess;
+  pRsp = retBuf + 3;
+  pCnt = pRsp++;
+  *pCnt = 0;
+
+  while ( (nvId = osal_nv_item_next( nvId )) != 0 )
+  {
+    uint16 nvLen;
+
+    if ( MT_CheckNvId( nvId ) != ZSuccess )
+    {
+      continue;
+    }
+
+    nvLen = osal_nv_item_len( nvId );
+
+    /* Record: Id, length, data */
+    if ( (4 + nvLen) <= (uint16)(rspMax - (pRsp - retBuf)) )
+    {
+      if ( osal_nv_read( nvId, 0, nvLen, pRsp + 4 ) != ZSUCCESS )
+      {
+        retBuf[0] = NV_OPER_FAILED;
+        break;
+      }
+    }
+    else if ( *pCnt == 0 )
+    {
+      nvLen |= MT_SYS_NV_DUMP_NO_DATA;
+    }
+    else
+    {
+      /* Start the next response with this item */
+      break;
+    }
+
+    retBuf[1] = LO_UINT16( nvId );
+    retBuf[2] = HI_UINT16( nvId );
+
+    *pRsp++ = LO_UINT16( nvId );
+    *pRsp++ = HI_UINT16( nvId );
+    *pRsp++ = LO_UINT16( nvLen );
+    *pRsp++ = HI_UINT16( nvLen );
+    if ( !(nvLen & MT_SYS_NV_DUMP_NO_DATA) )
+    {
+      pRsp += nvLen;
+    }
+    (*pCnt)++;
+
+    if ( *pCnt == 0xFF )
+    {
+      break;
+    }
+  }
+
+  if ( *pCnt == 0 )
+  {
+    /* End of the items; the host passes back the last Id, so echo it */
+    retBuf[1] = pBuf[0];
+    retBuf[2] = pBuf[1];
+  }
+
+  MT_BuildAndSendZToolResponse( MT_SRSP_SYS, MT_SYS_OSAL_NV_DUMP,
+                                (uint16)(pRsp - retBuf), retBuf );
+
+  osal_mem_free( retBuf );
+}
+
+/******************************************************************************
+ * @fn      MT_SysOsalNVRestore
+ *
+ * @brief   Write a series of whole NV items, creating the ones that do not
+ *          exist and re-creating the ones whose length has changed. With
+ *          MT_SYS_NV_RESTORE_COMPACT set, all of the NV pages are compacted
+ *          first, so that the writes of a whole restore just append.
+ *
+ * @param   pBuf - MT message containing the options, the record count and
+ *                 the records of Id, length and data
+ *
+ * @return  None
+ *****************************************************************************/
+static void MT_SysOsalNVRestore(uint8 *pBuf)
+{
+  uint8 rsp[4];
+  uint8 *pEnd;
+  uint8 options;
+  uint8 cnt;
+  uint16 nvId = 0;
+
+  pEnd = MT_RPC_DATA_PTR(pBuf) + MT_RPC_DATA_LEN(pBuf);
+  pBuf = MT_RPC_DATA_PTR(pBuf);
+
+  options = *pBuf++;
+  cnt = *pBuf++;
+
+  /* Response: status, number of items written, Id of the item that failed */
+  rsp[0] = ZSuccess;
+  rsp[1] = 0;
+
+  if ( options & MT_SYS_NV_RESTORE_COMPACT )
+  {
+    rsp[0] = osal_nv_compact();
+  }
+
+  while ( (rsp[0] == ZSuccess) && (rsp[1] < cnt) )
+  {
+    uint16 nvLen;
+    uint16 itemLen;
+
+    if ( (pEnd - pBuf) < 4 )
+    {
+      rsp[0] = ZInvalidParameter;
+      break;
+    }
+
+    nvId = osal_build_uint16( pBuf );
+    nvLen = osal_build_uint16( pBuf+2 );
+    pBuf += 4;
+
+    if ( (nvLen > (uint16)(pEnd - pBuf)) || (MT_CheckNvId( nvId ) != ZSuccess) )
+    {
+      rsp[0] = ZInvalidParameter;
+      break;
+    }
+
+    itemLen = osal_nv_item_len( nvId );
+
+    if ( (itemLen != 0) && (itemLen != nvLen) )
+    {
+      /* Re-create the item with the new length */
+      if ( osal_nv_delete( nvId, itemLen ) != ZSUCCESS )
+      {
+        rsp[0] = NV_OPER_FAILED;
+        break;
+      }
+      itemLen = 0;
+    }
+
+    if ( itemLen == 0 )
+    {
+      /* A new item is written along with its header */
+      if ( osal_nv_item_init( nvId, nvLen, pBuf ) != NV_ITEM_UNINIT )
+      {
+        rsp[0] = NV_OPER_FAILED;
+        break;
+      }
+    }
+    else if ( osal_nv_write( nvId, 0, nvLen, pBuf ) != ZSUCCESS )
+    {
+      rsp[0] = NV_OPER_FAILED;
+      break;
+    }
+
+    /* Set the Z-Globals value of this NV item */
+    zgSetItem( nvId, nvLen, pBuf );
+    MT_SysNvChanged( nvId );
+
+    pBuf += nvLen;
+    rsp[1]++;
+  }
+
+  rsp[2] = LO_UINT16( nvId );
+  rsp[3] = HI_UINT16( nvId );
+
+  MT_BuildAndSendZToolResponse( MT_SRSP_SYS, MT_SYS_OSAL_NV_RESTORE,
+                                sizeof(rsp), rsp );
+}
+#endif /* OSAL_NV_BULK */
+
 #if defined( FEATURE_NVEXID )
 /******************************************************************************
  * @fn      MT_ParseNvExtId
@@ -2129,6 +2452,285 @@ static void MT_SysSnifferParameters( uint8 *pBuf )
 }
 #endif // MT_SYS_SNIFFER_FEATURE
 
+#if defined( OSAL_PROFILER )
+/******************************************************************************
+ * @fn      MT_SysOsalProfiler
+ *
+ * @brief   Read or reset the OSAL task profiler.
+ *
+ * @param   pBuf - MT message containing the operation:
+ *                 MT_SYS_OSAL_PROF_GET_HIST, task ID
+ *                 MT_SYS_OSAL_PROF_GET_RING, maximum number of task runs
+ *                 MT_SYS_OSAL_PROF_RESET
+ *
+ * @return  None
+ *****************************************************************************/
+static void MT_SysOsalProfiler(uint8 *pBuf)
+{
+  uint8 *retBuf;
+  uint8 *pRsp;
+  uint8 op;
+  uint8 param;
+  uint8 status = SUCCESS;
+
+  // Adjust for the data
+  pBuf += MT_RPC_FRAME_HDR_SZ;
+
+  op = *pBuf++;
+  param = *pBuf;
+
+  if ( op == MT_SYS_OSAL_PROF_GET_RING )
+  {
+    // Task runs are 9 bytes each after the 3 byte header
+    if ( param > ( ( MT_RPC_DATA_MAX - 3 ) / 9 ) )
+    {
+      param = ( MT_RPC_DATA_MAX - 3 ) / 9;
+    }
+    retBuf = osal_mem_alloc( 3 + ( 9 * param ) );
+  }
+  else
+  {
+    retBuf = osal_mem_alloc( 10 + ( 4 * OSAL_PROF_BUCKETS ) );
+  }
+
+  if ( retBuf == NULL )
+  {
+    // Send back the failure only
+    status = ZMemError;
+    MT_BuildAndSendZToolResponse( MT_SRSP_SYS, MT_SYS_OSAL_PROFILER,
+                                  sizeof(status), &status );
+    return;
+  }
+
+  pRsp = retBuf;
+  *pRsp++ = status;
+  *pRsp++ = op;
+
+  if ( op == MT_SYS_OSAL_PROF_GET_HIST )
+  {
+    osalProfHist_t *pHist = osal_prof_get_hist( param );
+
+    if ( pHist != NULL )
+    {
+      uint8 i;
+
+      *pRsp++ = param;
+      *pRsp++ = OSAL_PROF_BUCKETS;
+      *pRsp++ = LO_UINT16( pHist->count );
+      *pRsp++ = HI_UINT16( pHist->count );
+      *pRsp++ = LO_UINT16( pHist->maxLatency );
+      *pRsp++ = HI_UINT16( pHist->maxLatency );
+      *pRsp++ = LO_UINT16( pHist->maxExec );
+      *pRsp++ = HI_UINT16( pHist->maxExec );
+
+      for ( i = 0; i < OSAL_PROF_BUCKETS; i++ )
+      {
+        *pRsp++ = LO_UINT16( pHist->latency[i] );
+        *pRsp++ = HI_UINT16( pHist->latency[i] );
+      }
+
+      for ( i = 0; i < OSAL_PROF_BUCKETS; i++ )
+      {
+        *pRsp++ = LO_UINT16( pHist->exec[i] );
+        *pRsp++ = HI_UINT16( pHist->exec[i] );
+      }
+    }
+    else
+    {
+      retBuf[0] = INVALIDPARAMETER;
+    }
+  }
+  else if ( op == MT_SYS_OSAL_PROF_GET_RING )
+  {
+    osalProfRec_t rec;
+    uint8 *pCnt = pRsp++;
+
+    *pCnt = 0;
+    while ( ( *pCnt < param ) && osal_prof_ring_read( &rec ) )
+    {
+      *pRsp++ = rec.taskId;
+      *pRsp++ = LO_UINT16( rec.timestamp );
+      *pRsp++ = HI_UINT16( rec.timestamp );
+      *pRsp++ = LO_UINT16( rec.events );
+      *pRsp++ = HI_UINT16( rec.events );
+      *pRsp++ = LO_UINT16( rec.latency );
+      *pRsp++ = HI_UINT16( rec.latency );
+      *pRsp++ = LO_UINT16( rec.exec );
+      *pRsp++ = HI_UINT16( rec.exec );
+      (*pCnt)++;
+    }
+  }
+  else if ( op == MT_SYS_OSAL_PROF_RESET )
+  {
+    osal_prof_reset();
+  }
+  else
+  {
+    retBuf[0] = INVALIDPARAMETER;
+  }
+
+  /* Build and send back the response */
+  MT_BuildAndSendZToolResponse( MT_SRSP_SYS, MT_SYS_OSAL_PROFILER,
+                                (uint8)(pRsp - retBuf), retBuf );
+
+  osal_mem_free( retBuf );
+}
+#endif /* OSAL_PROFILER */
+
+#if ( OSALMEM_SITES )
+/******************************************************************************
+ * @fn      MT_SysHeapSites
+ *
+ * @brief   Read or reset the heap usage of the allocating call sites.
+ *
+ * @param   pBuf - MT message containing the operation:
+ *                 MT_SYS_HEAP_SITES_GET, index of the first site
+ *                 MT_SYS_HEAP_SITES_RESET
+ *
+ * @return  None
+ *****************************************************************************/
+static void MT_SysHeapSites(uint8 *pBuf)
+{
+  uint8 *retBuf;
+  uint8 *pRsp;
+  uint8 op;
+  uint8 idx;
+  uint8 cnt;
+
+  // Adjust for the data
+  pBuf += MT_RPC_FRAME_HDR_SZ;
+
+  op = *pBuf++;
+  idx = *pBuf;
+
+  // Sites are 11 bytes each after the 9 byte header
+  cnt = osal_heap_site_cnt();
+  cnt = ( idx < cnt ) ? ( cnt - idx ) : 0;
+  if ( cnt > ( ( MT_RPC_DATA_MAX - 9 ) / 11 ) )
+  {
+    cnt = ( MT_RPC_DATA_MAX - 9 ) / 11;
+  }
+
+  retBuf = osal_mem_alloc( 9 + ( 11 * cnt ) );
+
+  if ( retBuf == NULL )
+  {
+    // Send back the failure only
+    op = ZMemError;
+    MT_BuildAndSendZToolResponse( MT_SRSP_SYS, MT_SYS_HEAP_SITES,
+                                  sizeof(op), &op );
+    return;
+  }
+
+  pRsp = retBuf;
+  *pRsp++ = SUCCESS;
+  *pRsp++ = op;
+
+  if ( op == MT_SYS_HEAP_SITES_GET )
+  {
+    osalMemSite_t site;
+    uint32 now = osal_GetSystemClock();
+
+    // Timestamp in ms so the host can turn allocation counts into rates
+    *pRsp++ = BREAK_UINT32( now, 0 );
+    *pRsp++ = BREAK_UINT32( now, 1 );
+    *pRsp++ = BREAK_UINT32( now, 2 );
+    *pRsp++ = BREAK_UINT32( now, 3 );
+    *pRsp++ = osal_heap_site_cnt();
+    *pRsp++ = idx;
+    *pRsp++ = cnt;
+
+    while ( cnt-- && osal_heap_site_get( idx++, &site ) )
+    {
+      *pRsp++ = site.file;
+      *pRsp++ = LO_UINT16( site.line );
+      *pRsp++ = HI_UINT16( site.line );
+      *pRsp++ = LO_UINT16( site.liveCnt );
+      *pRsp++ = HI_UINT16( site.liveCnt );
+      *pRsp++ = LO_UINT16( site.liveBytes );
+      *pRsp++ = HI_UINT16( site.liveBytes );
+      *pRsp++ = LO_UINT16( site.peakBytes );
+      *pRsp++ = HI_UINT16( site.peakBytes );
+      *pRsp++ = LO_UINT16( site.allocCnt );
+      *pRsp++ = HI_UINT16( site.allocCnt );
+    }
+  }
+  else if ( op == MT_SYS_HEAP_SITES_RESET )
+  {
+    osal_heap_site_reset();
+  }
+  else
+  {
+    retBuf[0] = INVALIDPARAMETER;
+  }
+
+  /* Build and send back the response */
+  MT_BuildAndSendZToolResponse( MT_SRSP_SYS, MT_SYS_HEAP_SITES,
+                                (uint8)(pRsp - retBuf), retBuf );
+
+  osal_mem_free( retBuf );
+}
+#endif /* OSALMEM_SITES */
+
+#if defined( MT_ZNP_FUNC )
+/******************************************************************************
+ * @fn      MT_SysZnpUartTxStats
+ *
+ * @brief   Read or clear the ZNP UART transmit counters.
+ *
+ * @param   pBuf - MT message containing the operation:
+ *                 MT_SYS_ZNP_UART_TX_STATS_GET
+ *                 MT_SYS_ZNP_UART_TX_STATS_CLEAR
+ *
+ * @return  None
+ *****************************************************************************/
+static void MT_SysZnpUartTxStats(uint8 *pBuf)
+{
+  uint8 retBuf[16];
+  uint8 *pRsp = retBuf;
+  uint8 op;
+
+  // Adjust for the data
+  pBuf += MT_RPC_FRAME_HDR_SZ;
+  op = *pBuf;
+
+  *pRsp++ = SUCCESS;
+  *pRsp++ = op;
+
+  if ( op == MT_SYS_ZNP_UART_TX_STATS_GET )
+  {
+    *pRsp++ = BREAK_UINT32( znpUartTxStats.bytes, 0 );
+    *pRsp++ = BREAK_UINT32( znpUartTxStats.bytes, 1 );
+    *pRsp++ = BREAK_UINT32( znpUartTxStats.bytes, 2 );
+    *pRsp++ = BREAK_UINT32( znpUartTxStats.bytes, 3 );
+    *pRsp++ = BREAK_UINT32( znpUartTxStats.frames, 0 );
+    *pRsp++ = BREAK_UINT32( znpUartTxStats.frames, 1 );
+    *pRsp++ = BREAK_UINT32( znpUartTxStats.frames, 2 );
+    *pRsp++ = BREAK_UINT32( znpUartTxStats.frames, 3 );
+    *pRsp++ = LO_UINT16( znpUartTxStats.stalls );
+    *pRsp++ = HI_UINT16( znpUartTxStats.stalls );
+    *pRsp++ = znpUartTxStats.depth;
+    *pRsp++ = znpUartTxStats.depthMax;
+  }
+  else if ( op == MT_SYS_ZNP_UART_TX_STATS_CLEAR )
+  {
+    // The depth counts frames still queued, so it is not cleared
+    znpUartTxStats.bytes = 0;
+    znpUartTxStats.frames = 0;
+    znpUartTxStats.stalls = 0;
+    znpUartTxStats.depthMax = znpUartTxStats.depth;
+  }
+  else
+  {
+    retBuf[0] = INVALIDPARAMETER;
+  }
+
+  /* Build and send back the response */
+  MT_BuildAndSendZToolResponse( MT_SRSP_SYS, MT_SYS_ZNP_UART_TX_STATS,
+                                (uint8)(pRsp - retBuf), retBuf );
+}
+#endif /* MT_ZNP_FUNC */
+
 #if defined( ENABLE_MT_SYS_RESET_SHUTDOWN )
 /******************************************************************************
  * @fn          powerOffSoc
@@ -119,7 +119,7 @@ UINT16 MT_ProcessEvent(uint8 task_id, uint16 events)
     if (msg_ptr != NULL)
     {
       MT_ProcessIncomingCommand((mtOSALSerialData_t *)msg_ptr);
-      osal_msg_deallocate(msg_ptr);
+      MT_UartMsgDeallocate(msg_ptr);
     }
 
     /* Return unproccessed events */
@@ -314,16 +314,24 @@ static void MT_ProcessIncomingCommand( mtOSALSerialData_t *msg )
  * @brief   Allocate memory for transport msg
  *
  * @param   uint8 cmd0 - The first byte of the MT command id containing the command type and subsystem.
- *          uint8 len - length
+ *          uint16 len - length
  *
  * @return  pointer the allocated memory or NULL if fail to allocate the memory
  ***************************************************************************************************/
-uint8 *MT_TransportAlloc(uint8 cmd0, uint8 len)
+uint8 *MT_TransportAlloc(uint8 cmd0, uint16 len)
 {
   uint8 *p;
 
   (void)cmd0;  // Intentionally unreferenced parameter
 
+#if defined ( MT_EXT_FRAMES )
+  /* Make room for the 2-byte length of an extended frame */
+  if (len > MT_RPC_DATA_MAX)
+  {
+    len += (MT_RPC_EXT_HDR_SZ - MT_RPC_FRAME_HDR_SZ);
+  }
+#endif
+
   /* Allocate a buffer of data length + SOP+CMD+FCS (5 bytes) */
   p = osal_msg_allocate(len + SPI_0DATA_MSG_LEN);
 
@@ -350,7 +358,7 @@ uint8 *MT_TransportAlloc(uint8 cmd0, uint8 len)
 void MT_TransportSend(uint8 *pBuf)
 {
   uint8 *msgPtr;
-  uint8 dataLen = pBuf[0]; /* Data length is on byte #1 from the pointer */
+  uint16 frameLen = MT_RPC_HDR_SZ(pBuf) + MT_RPC_DATA_LEN(pBuf); /* Frame without SOP and FCS */
 
   /* Move back to the SOP */
   msgPtr = pBuf-1;
@@ -359,11 +367,11 @@ void MT_TransportSend(uint8 *pBuf)
   msgPtr[0] = MT_UART_SOF;
 
   /* Insert FCS */
-  msgPtr[SPI_0DATA_MSG_LEN - 1 + dataLen] = MT_UartCalcFCS (pBuf, (3 + dataLen));
+  pBuf[frameLen] = MT_UartCalcFCS (pBuf, frameLen);
 
   /* Send to UART */
 #ifdef MT_UART_DEFAULT_PORT
-  HalUARTWrite(MT_UART_DEFAULT_PORT, msgPtr, dataLen + SPI_0DATA_MSG_LEN);
+  HalUARTWrite(MT_UART_DEFAULT_PORT, msgPtr, frameLen + MT_UART_FRAME_OVHD);
 #endif
 
   /* Deallocate */
@@ -62,6 +62,12 @@
 #define LEN_STATE      0x03
 #define DATA_STATE     0x04
 #define FCS_STATE      0x05
+#if defined ( MT_EXT_FRAMES )
+#define EXT_CMD_STATE1 0x06
+#define EXT_CMD_STATE2 0x07
+#define EXT_LEN_STATE1 0x08
+#define EXT_LEN_STATE2 0x09
+#endif
 
 /***************************************************************************************************
  *                                         GLOBAL VARIABLES
@@ -72,10 +78,21 @@ byte App_TaskID;
 /* ZTool protocal parameters */
 uint8 state;
 uint8  CMD_Token[2];
-uint8  LEN_Token;
-uint8  FSC_Token;
+uint16 LEN_Token;
+uint8  FSC_Token;      /* Running FCS of the frame being received */
 mtOSALSerialData_t  *pMsg;
-uint8  tempDataLen;
+uint16 tempDataLen;
+
+/* Bytes read from the UART ahead of the ZTool parser */
+static uint8 rxChunk[MT_UART_RX_CHUNK];
+static uint8 rxChunkIdx;
+static uint8 rxChunkCnt;
+
+#if ( MT_UART_FRAME_POOL > 0 )
+/* Preallocated ZTool frames, allocated on first use and then kept */
+static mtOSALSerialData_t *framePool[MT_UART_FRAME_POOL];
+static uint8 framePoolBusy;   /* Bit map of the frames being filled or handed off */
+#endif
 
 #if defined (ZAPP_P1) || defined (ZAPP_P2)
 uint16  MT_UartMaxZAppBufLen;
@@ -86,6 +103,11 @@ bool    MT_UartZAppRxStatus;
 /***************************************************************************************************
  *                                          LOCAL FUNCTIONS
  ***************************************************************************************************/
+static mtOSALSerialData_t *MT_UartFrameAlloc( uint16 len );
+static void MT_UartFrameSend( void );
+#if ( MT_UART_FRAME_POOL > 0 )
+static uint8 MT_UartFramePoolIdx( uint8 *pFrame );
+#endif
 
 /***************************************************************************************************
  * @fn      MT_UartInit
@@ -159,13 +181,13 @@ void MT_UartRegisterTaskID( byte taskID )
  *          Remember to NOT include SOP and FCS fields, so start at the CMD field.
  *
  * @param   byte *msg_ptr - message pointer
- * @param   byte len - length (in bytes) of message
+ * @param   uint16 len - length (in bytes) of message
  *
  * @return  result byte
  ***************************************************************************************************/
-byte MT_UartCalcFCS( uint8 *msg_ptr, uint8 len )
+byte MT_UartCalcFCS( uint8 *msg_ptr, uint16 len )
 {
-  byte x;
+  uint16 x;
   byte xorResult;
 
   xorResult = 0;
@@ -183,9 +205,17 @@ byte MT_UartCalcFCS( uint8 *msg_ptr, uint8 len )
  * @brief   | SOP | Data Length  |   CMD   |   Data   |  FCS  |
  *          |  1  |     1        |    2    |  0-Len   |   1   |
  *
+ *          or, with MT_EXT_FRAMES, the extended frame
+ *          | SOP | 0xFF |   CMD   | Data Length |   Data   |  FCS  |
+ *          |  1  |  1   |    2    |      2      |  0-Len   |   1   |
+ *
  *          Parses the data and determine either is SPI or just simply serial data
  *          then send the data to correct place (MT or APP)
  *
+ *          The UART is read in chunks of up to MT_UART_RX_CHUNK bytes rather than a byte at a
+ *          time; the frame data is copied out of a chunk, or read straight from the UART into the
+ *          frame when the chunk is used up, and the FCS is accumulated as the frame is filled.
+ *
  * @param   port     - UART port
  *          event    - Event that causes the callback
  *
@@ -195,52 +225,102 @@ byte MT_UartCalcFCS( uint8 *msg_ptr, uint8 len )
 void MT_UartProcessZToolData ( uint8 port, uint8 event )
 {
   uint8  ch;
-  uint8  bytesInRxBuffer;
-  
+  uint16 spanLen;
+  uint8  *pData;
+
   (void)event;  // Intentionally unreferenced parameter
 
-  while (Hal_UART_RxBufLen(port))
+  while (TRUE)
   {
-    HalUARTRead (port, &ch, 1);
+    if (rxChunkIdx == rxChunkCnt)
+    {
+      if (state == DATA_STATE)
+      {
+        /* Read as much of the remaining data as there is straight into the frame */
+        pData = MT_RPC_DATA_PTR(pMsg->msg) + tempDataLen;
+        spanLen = HalUARTRead (port, pData, LEN_Token - tempDataLen);
+
+        if (spanLen == 0)
+        {
+          break;
+        }
+
+        FSC_Token ^= MT_UartCalcFCS (pData, spanLen);
+        tempDataLen += spanLen;
+
+        /* If number of bytes read is equal to data length, time to move on to FCS */
+        if (tempDataLen == LEN_Token)
+        {
+          state = FCS_STATE;
+        }
+        continue;
+      }
+
+      rxChunkCnt = (uint8)HalUARTRead (port, rxChunk, MT_UART_RX_CHUNK);
+      rxChunkIdx = 0;
+
+      if (rxChunkCnt == 0)
+      {
+        break;
+      }
+    }
 
     switch (state)
     {
       case SOP_STATE:
-        if (ch == MT_UART_SOF)
-          state = LEN_STATE;
+        /* Skip everything up to the next SOF */
+        while (rxChunkIdx < rxChunkCnt)
+        {
+          if (rxChunk[rxChunkIdx++] == MT_UART_SOF)
+          {
+            state = LEN_STATE;
+            break;
+          }
+        }
         break;
 
       case LEN_STATE:
-        LEN_Token = ch;
+        LEN_Token = rxChunk[rxChunkIdx++];
 
         tempDataLen = 0;
 
-        /* Allocate memory for the data */
-        pMsg = (mtOSALSerialData_t *)osal_msg_allocate( sizeof ( mtOSALSerialData_t ) +
-                                                        MT_RPC_FRAME_HDR_SZ + LEN_Token );
+#if defined ( MT_EXT_FRAMES )
+        if (LEN_Token == MT_RPC_EXT_LEN)
+        {
+          /* The data length follows the command field */
+          FSC_Token = MT_RPC_EXT_LEN;
+          state = EXT_CMD_STATE1;
+          break;
+        }
+#endif
+
+        /* Get a frame for the data */
+        pMsg = MT_UartFrameAlloc (MT_RPC_FRAME_HDR_SZ + LEN_Token);
 
         if (pMsg)
         {
           /* Fill up what we can */
-          pMsg->hdr.event = CMD_SERIAL_MSG;
-          pMsg->msg = (uint8*)(pMsg+1);
-          pMsg->msg[MT_RPC_POS_LEN] = LEN_Token;
+          pMsg->msg[MT_RPC_POS_LEN] = (uint8)LEN_Token;
+          FSC_Token = (uint8)LEN_Token;
           state = CMD_STATE1;
         }
         else
         {
           state = SOP_STATE;
-          return;
         }
         break;
 
       case CMD_STATE1:
+        ch = rxChunk[rxChunkIdx++];
         pMsg->msg[MT_RPC_POS_CMD0] = ch;
+        FSC_Token ^= ch;
         state = CMD_STATE2;
         break;
 
       case CMD_STATE2:
+        ch = rxChunk[rxChunkIdx++];
         pMsg->msg[MT_RPC_POS_CMD1] = ch;
+        FSC_Token ^= ch;
         /* If there is no data, skip to FCS state */
         if (LEN_Token)
         {
@@ -252,45 +332,81 @@ void MT_UartProcessZToolData ( uint8 port, uint8 event )
         }
         break;
 
-      case DATA_STATE:
+#if defined ( MT_EXT_FRAMES )
+      case EXT_CMD_STATE1:
+      case EXT_CMD_STATE2:
+        ch = rxChunk[rxChunkIdx++];
+        CMD_Token[state - EXT_CMD_STATE1] = ch;
+        FSC_Token ^= ch;
+        state++;
+        break;
 
-        /* Fill in the buffer the first byte of the data */
-        pMsg->msg[MT_RPC_FRAME_HDR_SZ + tempDataLen++] = ch;
+      case EXT_LEN_STATE1:
+        ch = rxChunk[rxChunkIdx++];
+        LEN_Token = ch;
+        FSC_Token ^= ch;
+        state = EXT_LEN_STATE2;
+        break;
 
-        /* Check number of bytes left in the Rx buffer */
-        bytesInRxBuffer = Hal_UART_RxBufLen(port);
+      case EXT_LEN_STATE2:
+        ch = rxChunk[rxChunkIdx++];
+        LEN_Token |= ((uint16)ch << 8);
+        FSC_Token ^= ch;
 
-        /* If the remain of the data is there, read them all, otherwise, just read enough */
-        if (bytesInRxBuffer <= LEN_Token - tempDataLen)
+        /* Get a frame for the data, unless it is too long to take */
+        pMsg = NULL;
+        if (LEN_Token <= MT_RPC_EXT_DATA_MAX)
         {
-          HalUARTRead (port, &pMsg->msg[MT_RPC_FRAME_HDR_SZ + tempDataLen], bytesInRxBuffer);
-          tempDataLen += bytesInRxBuffer;
+          pMsg = MT_UartFrameAlloc (MT_RPC_EXT_HDR_SZ + LEN_Token);
+        }
+
+        if (pMsg)
+        {
+          pMsg->msg[MT_RPC_POS_LEN] = MT_RPC_EXT_LEN;
+          pMsg->msg[MT_RPC_POS_CMD0] = CMD_Token[0];
+          pMsg->msg[MT_RPC_POS_CMD1] = CMD_Token[1];
+          pMsg->msg[MT_RPC_POS_EXT_LEN] = LO_UINT16(LEN_Token);
+          pMsg->msg[MT_RPC_POS_EXT_LEN+1] = HI_UINT16(LEN_Token);
+          state = (LEN_Token) ? DATA_STATE : FCS_STATE;
         }
         else
         {
-          HalUARTRead (port, &pMsg->msg[MT_RPC_FRAME_HDR_SZ + tempDataLen], LEN_Token - tempDataLen);
-          tempDataLen += (LEN_Token - tempDataLen);
+          state = SOP_STATE;
         }
+        break;
+#endif
 
-        /* If number of bytes read is equal to data length, time to move on to FCS */
-        if ( tempDataLen == LEN_Token )
-            state = FCS_STATE;
+      case DATA_STATE:
+        /* Copy as much of the remaining data as the chunk holds */
+        pData = MT_RPC_DATA_PTR(pMsg->msg) + tempDataLen;
+        spanLen = rxChunkCnt - rxChunkIdx;
+        if (spanLen > LEN_Token - tempDataLen)
+        {
+          spanLen = LEN_Token - tempDataLen;
+        }
 
+        (void)osal_memcpy (pData, &rxChunk[rxChunkIdx], spanLen);
+        FSC_Token ^= MT_UartCalcFCS (pData, spanLen);
+        rxChunkIdx += spanLen;
+        tempDataLen += spanLen;
+
+        /* If number of bytes read is equal to data length, time to move on to FCS */
+        if (tempDataLen == LEN_Token)
+        {
+          state = FCS_STATE;
+        }
         break;
 
       case FCS_STATE:
-
-        FSC_Token = ch;
-
         /* Make sure it's correct */
-        if ((MT_UartCalcFCS ((uint8*)&pMsg->msg[0], MT_RPC_FRAME_HDR_SZ + LEN_Token) == FSC_Token))
+        if (rxChunk[rxChunkIdx++] == FSC_Token)
         {
-          osal_msg_send( App_TaskID, (byte *)pMsg );
+          MT_UartFrameSend ();
         }
         else
         {
           /* deallocate the msg */
-          osal_msg_deallocate ( (uint8 *)pMsg );
+          MT_UartMsgDeallocate ((uint8 *)pMsg);
         }
 
         /* Reset the state, send or discard the buffers at this point */
@@ -299,11 +415,140 @@ void MT_UartProcessZToolData ( uint8 port, uint8 event )
         break;
 
       default:
-       break;
+        rxChunkIdx = rxChunkCnt;
+        break;
     }
   }
 }
 
+/***************************************************************************************************
+ * @fn      MT_UartFrameAlloc
+ *
+ * @brief   Get a message to receive a ZTool frame into. A free frame of the pool is used when
+ *          there is one, otherwise a message of just the frame size is allocated.
+ *
+ * @param   len - length of the frame header and data
+ *
+ * @return  Pointer to the message, NULL if out of memory
+ ***************************************************************************************************/
+static mtOSALSerialData_t *MT_UartFrameAlloc( uint16 len )
+{
+  mtOSALSerialData_t *pFrame = NULL;
+
+#if ( MT_UART_FRAME_POOL > 0 )
+  if (len <= MT_RPC_FRAME_HDR_SZ + MT_RPC_DATA_MAX)
+  {
+    uint8 idx;
+
+    for (idx = 0; idx < MT_UART_FRAME_POOL; idx++)
+    {
+      if (!(framePoolBusy & BV(idx)))
+      {
+        if (framePool[idx] == NULL)
+        {
+          framePool[idx] = (mtOSALSerialData_t *)osal_msg_allocate( sizeof ( mtOSALSerialData_t ) +
+                                                        MT_RPC_FRAME_HDR_SZ + MT_RPC_DATA_MAX );
+        }
+
+        if (framePool[idx] != NULL)
+        {
+          framePoolBusy |= BV(idx);
+          pFrame = framePool[idx];
+        }
+        break;
+      }
+    }
+  }
+
+  if (pFrame == NULL)
+#endif
+  {
+    pFrame = (mtOSALSerialData_t *)osal_msg_allocate( sizeof ( mtOSALSerialData_t ) + len );
+  }
+
+  if (pFrame)
+  {
+    pFrame->hdr.event = CMD_SERIAL_MSG;
+    pFrame->msg = (uint8*)(pFrame+1);
+  }
+
+  return pFrame;
+}
+
+/***************************************************************************************************
+ * @fn      MT_UartFrameSend
+ *
+ * @brief   Hand the received ZTool frame off to the application task.
+ *
+ * @param   None
+ *
+ * @return  None
+ ***************************************************************************************************/
+static void MT_UartFrameSend( void )
+{
+#if ( MT_UART_FRAME_POOL > 0 )
+  uint8 idx = MT_UartFramePoolIdx( (uint8 *)pMsg );
+
+  if ((osal_msg_send( App_TaskID, (byte *)pMsg ) != SUCCESS) && (idx < MT_UART_FRAME_POOL))
+  {
+    /* OSAL has freed the message, so the pool frame has to be allocated again */
+    framePool[idx] = NULL;
+    framePoolBusy &= ~BV(idx);
+  }
+#else
+  osal_msg_send( App_TaskID, (byte *)pMsg );
+#endif
+}
+
+#if ( MT_UART_FRAME_POOL > 0 )
+/***************************************************************************************************
+ * @fn      MT_UartFramePoolIdx
+ *
+ * @brief   Find a message in the frame pool.
+ *
+ * @param   pFrame - message
+ *
+ * @return  Index of the message in the pool, MT_UART_FRAME_POOL if it is not a pool frame
+ ***************************************************************************************************/
+static uint8 MT_UartFramePoolIdx( uint8 *pFrame )
+{
+  uint8 idx;
+
+  for (idx = 0; idx < MT_UART_FRAME_POOL; idx++)
+  {
+    if ((uint8 *)framePool[idx] == pFrame)
+    {
+      break;
+    }
+  }
+
+  return idx;
+}
+
+/***************************************************************************************************
+ * @fn      MT_UartMsgDeallocate
+ *
+ * @brief   Free a message received by a task, returning pool frames to the pool.
+ *
+ * @param   pMsg - message
+ *
+ * @return  None
+ ***************************************************************************************************/
+void MT_UartMsgDeallocate( uint8 *pMsg )
+{
+  uint8 idx = MT_UartFramePoolIdx( pMsg );
+
+  if (idx < MT_UART_FRAME_POOL)
+  {
+    framePoolBusy &= ~BV(idx);
+  }
+  else
+  {
+    osal_msg_deallocate( pMsg );
+  }
+}
+#endif
+
 #if defined (ZAPP_P1) || defined (ZAPP_P2)
 /***************************************************************************************************
  * @fn      MT_UartProcessZAppData
@@ -47,7 +47,7 @@ extern "C"
 /***************************************************************************************************
  *                                               INCLUDES
  ***************************************************************************************************/
-#include "Onboard.h"
+#include "OnBoard.h"
 #include "OSAL.h"
 
 /***************************************************************************************************
@@ -81,6 +81,19 @@ extern "C"
 #endif
 #define MT_UART_DEFAULT_IDLE_TIMEOUT     MT_UART_IDLE_TIMEOUT
 
+/* Number of bytes pulled from the UART driver per read while parsing ZTool frames */
+#if !defined( MT_UART_RX_CHUNK )
+  #define MT_UART_RX_CHUNK               16
+#endif
+
+/* Number of preallocated ZTool frames (0 - 8). When non-zero, incoming frames are filled into
+ * full-size messages that are kept across frames instead of allocating a message per frame.
+ * Receivers of CMD_SERIAL_MSG must then free messages with MT_UartMsgDeallocate().
+ */
+#if !defined( MT_UART_FRAME_POOL )
+  #define MT_UART_FRAME_POOL             0
+#endif
+
 /* Application Flow Control */
 #define MT_UART_ZAPP_RX_NOT_READY         0x00
 #define MT_UART_ZAPP_RX_READY             0x01
@@ -109,7 +122,16 @@ void MT_UartProcessZAppData ( uint8 port, uint8 event );
 /*
  * Calculate the check sum
  */
-extern uint8 MT_UartCalcFCS( uint8 *msg_ptr, uint8 length );
+extern uint8 MT_UartCalcFCS( uint8 *msg_ptr, uint16 length );
+
+/*
+ * Free a received message, returning it to the frame pool if it came from there
+ */
+#if ( MT_UART_FRAME_POOL > 0 )
+extern void MT_UartMsgDeallocate( uint8 *pMsg );
+#else
+#define MT_UartMsgDeallocate( pMsg )  osal_msg_deallocate( pMsg )
+#endif
 
 /*
  * Register TaskID for the application
@@ -44,6 +44,9 @@ extern "C"
 {
 #endif
 
+/* Transport capability bits, sent after the version string by MT_EXT_FRAMES builds */
+#define MT_VERSION_CAP_EXT_FRAMES  0x01  // Extended-length frames are understood
+
 #if !defined ( INCLUDE_REVISION_INFORMATION )
 extern const uint8 MTVersionString[5];
 #else
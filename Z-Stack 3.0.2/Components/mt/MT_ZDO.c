@@ -1282,6 +1282,7 @@ static void MT_ZdoRemoveLinkKey(uint8 *pBuf)
       
       osal_memset(&TCLKDevEntry,0,sizeof(APSME_TCLKDevEntry_t));
       osal_nv_write( ( tempIndex), 0, sizeof(APSME_TCLKDevEntry_t), &TCLKDevEntry );
+      ZDSecMgrTCLKIndexSet( tempIndex, &TCLKDevEntry );
       retValue = ZSuccess;
     }
   }
@@ -43,10 +43,14 @@
  * INCLUDES
  */
 
+// Call site file id for heap usage attribution (OSALMEM_SITES)
+#define OSALMEM_SITE_FILE  OSALMEM_FILE_OSAL
+
 #include <string.h>
 
 #include "comdef.h"
 #include "hal_board.h"
+#include "hal_assert.h"
 #include "OSAL.h"
 #include "OSAL_Tasks.h"
 #include "OSAL_Memory.h"
@@ -79,17 +83,58 @@
 #define OSAL_PROXY_ID_FLAG       0x80
 #endif // USE_ICALL
 
+// Keep a bitmap of tasks with events pending for osal_run_system(). It is
+// only a hint kept by osal_set_event(), so the tasks below the one it gives
+// and, when it is empty, all of tasksEvents[] are still scanned.
+#if !defined ( OSAL_READY_BITMAP )
+  #define OSAL_READY_BITMAP FALSE
+#endif
+
+// Number of event passes a task may be given in a row by osal_run_system()
+// while no higher priority task is ready
+#if !defined ( OSAL_TASK_DRAIN_MAX )
+  #define OSAL_TASK_DRAIN_MAX 1
+#endif
+
+#if ( OSAL_READY_BITMAP == TRUE )
+  #define OSAL_READY_BITMAP_TASKS 32
+#endif
+
+#if defined ( OSAL_PROFILER )
+  // 16 bit free running profiler clock, 320us MAC timer ticks by default
+  #if !defined ( OSAL_PROF_TIMESTAMP )
+    #ifdef USE_ICALL
+      #define OSAL_PROF_TIMESTAMP()  ( (uint16)ICall_getTicks() )
+    #else
+      #define OSAL_PROF_TIMESTAMP()  ( (uint16)macMcuPrecisionCount() )
+    #endif
+  #endif
+#endif
+
 /*********************************************************************
  * TYPEDEFS
  */
 
+// Message queue of a single task
+typedef struct
+{
+  osal_msg_q_t head;
+  void         *tail;
+} osal_task_q_t;
+
+#if defined ( OSAL_PROFILER )
+// Profiler data of a single task
+typedef struct
+{
+  osalProfHist_t hist;
+  uint16         setTime[16];   // when each pending event bit was set
+} osal_prof_task_t;
+#endif
+
 /*********************************************************************
  * GLOBAL VARIABLES
  */
 
-// Message Pool Definitions
-osal_msg_q_t osal_qHead;
-
 #ifdef USE_ICALL
 // OSAL event loop hook function pointer 
 void (*osal_eventloop_hook)(void) = NULL;
@@ -102,6 +147,9 @@ void (*osal_eventloop_hook)(void) = NULL;
 /*********************************************************************
  * EXTERNAL FUNCTIONS
  */
+#if defined ( OSAL_PROFILER ) && !defined ( USE_ICALL )
+extern uint32 macMcuPrecisionCount(void);
+#endif
 
 /*********************************************************************
  * LOCAL VARIABLES
@@ -110,6 +158,28 @@ void (*osal_eventloop_hook)(void) = NULL;
 // Index of active task
 static uint8 activeTaskID = TASK_NO_TASK;
 
+// Message Pool Definitions, one FIFO per task
+static osal_task_q_t *osal_taskQ = NULL;
+
+#if ( OSAL_READY_BITMAP == TRUE )
+// Bit n is set if task n may have events pending
+static uint32 osal_readyTasks = 0;
+
+// Lowest bit set in a non-zero nibble
+static CONST uint8 osal_lowestBit[16] =
+  { 0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0 };
+#endif
+
+#if defined ( OSAL_PROFILER )
+// Profiler data, one per task
+static osal_prof_task_t *osal_prof = NULL;
+
+// Most recent task runs, oldest first from osal_profRingHead - osal_profRingCnt
+static osalProfRec_t osal_profRing[OSAL_PROF_RING_SIZE];
+static uint8 osal_profRingHead = 0;
+static uint8 osal_profRingCnt = 0;
+#endif
+
 #ifdef USE_ICALL
 // Maximum number of proxy tasks
 #ifndef OSAL_MAX_NUM_PROXY_TASKS
@@ -155,6 +225,12 @@ static uint8 osal_notask_entity;
  */
 
 static uint8 osal_msg_enqueue_push( uint8 destination_task, uint8 *msg_ptr, uint8 urgent );
+static uint8 osal_next_ready_task( void );
+static void osal_run_task( uint8 idx );
+#if defined ( OSAL_PROFILER )
+static void osal_prof_event_set( uint8 task_id, uint16 events );
+static void osal_prof_task_run( uint8 task_id, uint16 events, uint16 start, uint16 end );
+#endif
 
 #ifdef USE_ICALL
 static uint8 osal_alien2proxy(ICall_EntityID entity);
@@ -381,11 +457,11 @@ uint32 osal_build_uint32( uint8 *swapped, uint8 len )
  *
  * @return  pointer to buffer
  */
-unsigned char * _ltoa(unsigned long l, unsigned char *buf, unsigned char radix)
+uint8 * _ltoa(uint32 l, uint8 *buf, uint8 radix)
 {
 #if defined (__TI_COMPILER_VERSION)
   return ( (unsigned char*)ltoa( l, (char *)buf ) );
-#elif defined( __GNUC__ )
+#elif defined( __GNUC__ ) && !defined( HAL_MCU_POSIX )
   return ( (char*)ltoa( l, buf, radix ) );
 #else
   unsigned char tmp1[10] = "", tmp2[10] = "", tmp3[10] = "";
@@ -707,6 +783,9 @@ uint8 osal_msg_push_front( uint8 destination_task, uint8 *msg_ptr )
  */
 static uint8 osal_msg_enqueue_push( uint8 destination_task, uint8 *msg_ptr, uint8 push )
 {
+  osal_task_q_t *q;
+  halIntState_t  intState;
+
   if ( msg_ptr == NULL )
   {
     return ( INVALID_MSG_POINTER );
@@ -735,17 +814,39 @@ static uint8 osal_msg_enqueue_push( uint8 destination_task, uint8 *msg_ptr, uint
 
   OSAL_MSG_ID( msg_ptr ) = destination_task;
 
+  q = &osal_taskQ[destination_task];
+
+  // Hold off interrupts
+  HAL_ENTER_CRITICAL_SECTION(intState);
+
   if ( push == TRUE )
   {
     // prepend the message
-    osal_msg_push( &osal_qHead, msg_ptr );
+    OSAL_MSG_NEXT( msg_ptr ) = q->head;
+    q->head = msg_ptr;
+
+    if ( q->tail == NULL )
+    {
+      q->tail = msg_ptr;
+    }
   }
   else
   {
     // append the message
-    osal_msg_enqueue( &osal_qHead, msg_ptr );
+    if ( q->tail == NULL )
+    {
+      q->head = msg_ptr;
+    }
+    else
+    {
+      OSAL_MSG_NEXT( q->tail ) = msg_ptr;
+    }
+    q->tail = msg_ptr;
   }
 
+  // Re-enable interrupts
+  HAL_EXIT_CRITICAL_SECTION(intState);
+
   // Signal the task that a message is waiting
   osal_set_event( destination_task, SYS_EVENT_MSG );
 
@@ -767,42 +868,37 @@ static uint8 osal_msg_enqueue_push( uint8 destination_task, uint8 *msg_ptr, uint
  */
 uint8 *osal_msg_receive( uint8 task_id )
 {
-  osal_msg_hdr_t *listHdr;
-  osal_msg_hdr_t *prevHdr = NULL;
-  osal_msg_hdr_t *foundHdr = NULL;
-  halIntState_t   intState;
+  osal_task_q_t *q;
+  void          *foundHdr;
+  halIntState_t  intState;
+
+  if ( task_id >= tasksCnt )
+  {
+    return ( NULL );
+  }
+
+  q = &osal_taskQ[task_id];
 
   // Hold off interrupts
   HAL_ENTER_CRITICAL_SECTION(intState);
 
-  // Point to the top of the queue
-  listHdr = osal_qHead;
+  // Take the first message of the asking task
+  foundHdr = q->head;
 
-  // Look through the queue for a message that belongs to the asking task
-  while ( listHdr != NULL )
+  if ( foundHdr != NULL )
   {
-    if ( (listHdr - 1)->dest_id == task_id )
+    q->head = OSAL_MSG_NEXT( foundHdr );
+    if ( q->head == NULL )
     {
-      if ( foundHdr == NULL )
-      {
-        // Save the first one
-        foundHdr = listHdr;
-      }
-      else
-      {
-        // Second msg found, stop looking
-        break;
-      }
+      q->tail = NULL;
     }
-    if ( foundHdr == NULL )
-    {
-      prevHdr = listHdr;
-    }
-    listHdr = OSAL_MSG_NEXT( listHdr );
+
+    OSAL_MSG_NEXT( foundHdr ) = NULL;
+    OSAL_MSG_ID( foundHdr ) = TASK_NO_TASK;
   }
 
-  // Is there more than one?
-  if ( listHdr != NULL )
+  // Is there another one?
+  if ( q->head != NULL )
   {
     // Yes, Signal the task that a message is waiting
     osal_set_event( task_id, SYS_EVENT_MSG );
@@ -813,13 +909,6 @@ uint8 *osal_msg_receive( uint8 task_id )
     osal_clear_event( task_id, SYS_EVENT_MSG );
   }
 
-  // Did we find a message?
-  if ( foundHdr != NULL )
-  {
-    // Take out of the link list
-    osal_msg_extract( &osal_qHead, foundHdr, prevHdr );
-  }
-
   // Release interrupts
   HAL_EXIT_CRITICAL_SECTION(intState);
 
@@ -849,14 +938,19 @@ osal_event_hdr_t *osal_msg_find(uint8 task_id, uint8 event)
   osal_msg_hdr_t *pHdr;
   halIntState_t intState;
 
+  if (task_id >= tasksCnt)
+  {
+    return NULL;
+  }
+
   HAL_ENTER_CRITICAL_SECTION(intState);  // Hold off interrupts.
 
-  pHdr = osal_qHead;  // Point to the top of the queue.
+  pHdr = osal_taskQ[task_id].head;  // Point to the top of the task's queue.
 
-  // Look through the queue for a message that matches the task_id and event parameters.
+  // Look through the queue for a message that matches the event parameter.
   while (pHdr != NULL)
   {
-    if (((pHdr-1)->dest_id == task_id) && (((osal_event_hdr_t *)pHdr)->event == event))
+    if (((osal_event_hdr_t *)pHdr)->event == event)
     {
       break;
     }
@@ -894,15 +988,19 @@ uint8 osal_msg_count( uint8 task_id, uint8 event )
   osal_msg_hdr_t *pHdr;
   halIntState_t intState;
 
+  if (task_id >= tasksCnt)
+  {
+    return ( 0 );
+  }
+
   HAL_ENTER_CRITICAL_SECTION(intState);  // Hold off interrupts.
 
-  pHdr = osal_qHead;  // Point to the top of the queue.
+  pHdr = osal_taskQ[task_id].head;  // Point to the top of the task's queue.
 
-  // Look through the queue for a message that matches the task_id and event parameters.
+  // Look through the queue for a message that matches the event parameter.
   while (pHdr != NULL)
   {
-    if ( ((pHdr-1)->dest_id == task_id) 
-        && ((event == 0xFF) || (((osal_event_hdr_t *)pHdr)->event == event)) )
+    if ( (event == 0xFF) || (((osal_event_hdr_t *)pHdr)->event == event) )
     {
       count++;
     }
@@ -1185,7 +1283,16 @@ uint8 osal_set_event( uint8 task_id, uint16 event_flag )
   {
     halIntState_t   intState;
     HAL_ENTER_CRITICAL_SECTION(intState);    // Hold off interrupts
+#if defined ( OSAL_PROFILER )
+    osal_prof_event_set( task_id, event_flag & ~tasksEvents[task_id] );
+#endif
     tasksEvents[task_id] |= event_flag;  // Stuff the event bit(s)
+#if ( OSAL_READY_BITMAP == TRUE )
+    if ( ( event_flag != 0 ) && ( task_id < OSAL_READY_BITMAP_TASKS ) )
+    {
+      osal_readyTasks |= ( (uint32)1 << task_id );
+    }
+#endif
     HAL_EXIT_CRITICAL_SECTION(intState);     // Release interrupts
 #ifdef USE_ICALL
     ICall_signal(osal_semaphore);
@@ -1218,6 +1325,12 @@ uint8 osal_clear_event( uint8 task_id, uint16 event_flag )
     halIntState_t   intState;
     HAL_ENTER_CRITICAL_SECTION(intState);    // Hold off interrupts
     tasksEvents[task_id] &= ~(event_flag);   // Clear the event bit(s)
+#if ( OSAL_READY_BITMAP == TRUE )
+    if ( ( tasksEvents[task_id] == 0 ) && ( task_id < OSAL_READY_BITMAP_TASKS ) )
+    {
+      osal_readyTasks &= ~( (uint32)1 << task_id );
+    }
+#endif
     HAL_EXIT_CRITICAL_SECTION(intState);     // Release interrupts
     return ( SUCCESS );
   }
@@ -1319,7 +1432,8 @@ uint8 osal_int_disable( uint8 interrupt_id )
  *
  * @param   void
  *
- * @return  SUCCESS
+ * @return  SUCCESS, or FAILURE if the message queues could not be
+ *          allocated, in which case no task is initialized
  */
 uint8 osal_init_system( void )
 {
@@ -1328,8 +1442,23 @@ uint8 osal_init_system( void )
   osal_mem_init();
 #endif /* !defined USE_ICALL && !defined OSAL_PORT2TIRTOS */
 
-  // Initialize the message queue
-  osal_qHead = NULL;
+  // Initialize the message queues
+  osal_taskQ = osal_mem_alloc( sizeof( osal_task_q_t ) * tasksCnt );
+  if ( osal_taskQ == NULL )
+  {
+    HAL_ASSERT_FORCED();
+    return ( FAILURE );
+  }
+  osal_memset( osal_taskQ, 0, sizeof( osal_task_q_t ) * tasksCnt );
+
+#if defined ( OSAL_PROFILER )
+  // Initialize the task profiler
+  osal_prof = osal_mem_alloc( sizeof( osal_prof_task_t ) * tasksCnt );
+  if ( osal_prof != NULL )
+  {
+    osal_memset( osal_prof, 0, sizeof( osal_prof_task_t ) * tasksCnt );
+  }
+#endif
 
   // Initialize the timers
   osalTimerInit();
@@ -1538,6 +1667,137 @@ ICall_Errno osal_service_entry(ICall_FuncArgsHdr *args)
 }
 #endif /* USE_ICALL */
 
+/*********************************************************************
+ * @fn      osal_next_ready_task
+ *
+ * @brief
+ *
+ *   Find the highest priority task with events pending. With
+ *   OSAL_READY_BITMAP the lowest task in the ready bitmap is taken,
+ *   unless a task below it has events set without osal_set_event().
+ *   tasksEvents[] is scanned in full only when the bitmap is empty.
+ *
+ * @param   void
+ *
+ * @return  task ID, tasksCnt if no task is ready
+ */
+static uint8 osal_next_ready_task( void )
+{
+  uint8 idx = 0;
+
+#if ( OSAL_READY_BITMAP == TRUE )
+  halIntState_t intState;
+  uint32 ready;
+  uint8 i;
+
+  HAL_ENTER_CRITICAL_SECTION(intState);
+
+  while ( osal_readyTasks != 0 )
+  {
+    // Find the lowest bit set, a byte then a nibble at a time
+    ready = osal_readyTasks;
+    idx = 0;
+    while ( (uint8)ready == 0 )
+    {
+      ready >>= 8;
+      idx += 8;
+    }
+    if ( ((uint8)ready & 0x0F) == 0 )
+    {
+      ready >>= 4;
+      idx += 4;
+    }
+    idx += osal_lowestBit[(uint8)ready & 0x0F];
+
+    if ( tasksEvents[idx] )
+    {
+      HAL_EXIT_CRITICAL_SECTION(intState);
+
+      // Events set without osal_set_event(), such as by the MAC library,
+      // have no bit, so a higher priority task may still be ready
+      for ( i = 0; i < idx; i++ )
+      {
+        if ( tasksEvents[i] )
+        {
+          return ( i );
+        }
+      }
+      return ( idx );
+    }
+
+    // Events were cleared without osal_clear_event(), drop the stale bit
+    osal_readyTasks &= ~( (uint32)1 << idx );
+  }
+
+  HAL_EXIT_CRITICAL_SECTION(intState);
+
+  idx = 0;
+#endif
+
+  do {
+    if (tasksEvents[idx])  // Task is highest priority that is ready.
+    {
+      break;
+    }
+  } while (++idx < tasksCnt);
+
+  return ( idx );
+}
+
+/*********************************************************************
+ * @fn      osal_run_task
+ *
+ * @brief
+ *
+ *   Call the event processor of a task with all of its pending events
+ *   and add back the events it did not process.
+ *
+ * @param   uint8 idx - task ID
+ *
+ * @return  none
+ */
+static void osal_run_task( uint8 idx )
+{
+  uint16 events;
+  halIntState_t intState;
+#if defined ( OSAL_PROFILER )
+  uint16 pending;
+  uint16 start;
+#endif
+
+  HAL_ENTER_CRITICAL_SECTION(intState);
+  events = tasksEvents[idx];
+  tasksEvents[idx] = 0;  // Clear the Events for this task.
+#if ( OSAL_READY_BITMAP == TRUE )
+  if ( idx < OSAL_READY_BITMAP_TASKS )
+  {
+    osal_readyTasks &= ~( (uint32)1 << idx );
+  }
+#endif
+#if defined ( OSAL_PROFILER )
+  pending = events;
+  start = OSAL_PROF_TIMESTAMP();
+#endif
+  HAL_EXIT_CRITICAL_SECTION(intState);
+
+  activeTaskID = idx;
+  events = (tasksArr[idx])( idx, events );
+  activeTaskID = TASK_NO_TASK;
+
+  HAL_ENTER_CRITICAL_SECTION(intState);
+#if defined ( OSAL_PROFILER )
+  osal_prof_task_run( idx, pending & ~events, start, OSAL_PROF_TIMESTAMP() );
+#endif
+  tasksEvents[idx] |= events;  // Add back unprocessed events to the current task.
+#if ( OSAL_READY_BITMAP == TRUE )
+  if ( ( events != 0 ) && ( idx < OSAL_READY_BITMAP_TASKS ) )
+  {
+    osal_readyTasks |= ( (uint32)1 << idx );
+  }
+#endif
+  HAL_EXIT_CRITICAL_SECTION(intState);
+}
+
 /*********************************************************************
  * @fn      osal_run_system
  *
@@ -1554,7 +1814,7 @@ ICall_Errno osal_service_entry(ICall_FuncArgsHdr *args)
  */
 void osal_run_system( void )
 {
-  uint8 idx = 0;
+  uint8 idx;
 
 #ifdef USE_ICALL
   uint32 next_timeout_prior = osal_next_timeout();
@@ -1641,30 +1901,20 @@ void osal_run_system( void )
   }
 #endif /* USE_ICALL */
 
-  do {
-    if (tasksEvents[idx])  // Task is highest priority that is ready.
-    {
-      break;
-    }
-  } while (++idx < tasksCnt);
+  idx = osal_next_ready_task();  // Task is highest priority that is ready.
 
   if (idx < tasksCnt)
   {
-    uint16 events;
-    halIntState_t intState;
-
-    HAL_ENTER_CRITICAL_SECTION(intState);
-    events = tasksEvents[idx];
-    tasksEvents[idx] = 0;  // Clear the Events for this task.
-    HAL_EXIT_CRITICAL_SECTION(intState);
+#if ( OSAL_TASK_DRAIN_MAX > 1 )
+    uint8 drain = OSAL_TASK_DRAIN_MAX;
 
-    activeTaskID = idx;
-    events = (tasksArr[idx])( idx, events );
-    activeTaskID = TASK_NO_TASK;
-
-    HAL_ENTER_CRITICAL_SECTION(intState);
-    tasksEvents[idx] |= events;  // Add back unprocessed events to the current task.
-    HAL_EXIT_CRITICAL_SECTION(intState);
+    // Keep serving this task while it is still the highest priority one ready
+    do {
+      osal_run_task( idx );
+    } while ( ( --drain != 0 ) && ( osal_next_ready_task() == idx ) );
+#else
+    osal_run_task( idx );
+#endif
   }
 #if defined( POWER_SAVING ) && !defined(USE_ICALL)
   else  // Complete pass through all task events with no activity?
@@ -1817,5 +2067,230 @@ uint8 osal_self( void )
   return ( activeTaskID );
 }
 
+#if defined ( OSAL_PROFILER )
+/*********************************************************************
+ * @fn      osal_prof_bucket
+ *
+ * @brief
+ *
+ *   Find the log2 histogram bucket of a number of profiler ticks.
+ *
+ * @param   uint16 ticks - profiler ticks
+ *
+ * @return  bucket index
+ */
+static uint8 osal_prof_bucket( uint16 ticks )
+{
+  uint8 bucket = 0;
+
+  while ( ( ticks != 0 ) && ( bucket < ( OSAL_PROF_BUCKETS - 1 ) ) )
+  {
+    ticks >>= 1;
+    bucket++;
+  }
+
+  return ( bucket );
+}
+
+/*********************************************************************
+ * @fn      osal_prof_event_set
+ *
+ * @brief
+ *
+ *   Timestamp events that were not pending for a task. Called with
+ *   interrupts held off.
+ *
+ * @param   uint8 task_id - task ID
+ * @param   uint16 events - events newly set
+ *
+ * @return  none
+ */
+static void osal_prof_event_set( uint8 task_id, uint16 events )
+{
+  uint16 now;
+  uint8 bit;
+
+  if ( ( osal_prof == NULL ) || ( events == 0 ) )
+  {
+    return;
+  }
+
+  now = OSAL_PROF_TIMESTAMP();
+
+  for ( bit = 0; events != 0; bit++, events >>= 1 )
+  {
+    if ( events & 0x0001 )
+    {
+      osal_prof[task_id].setTime[bit] = now;
+    }
+  }
+}
+
+/*********************************************************************
+ * @fn      osal_prof_task_run
+ *
+ * @brief
+ *
+ *   Add a task run to the histograms of the task and the ring buffer.
+ *
+ * @param   uint8 task_id - task ID
+ * @param   uint16 events - events processed by the run
+ * @param   uint16 start - profiler time the run started
+ * @param   uint16 end - profiler time the run ended
+ *
+ * @return  none
+ */
+static void osal_prof_task_run( uint8 task_id, uint16 events, uint16 start, uint16 end )
+{
+  osalProfHist_t *pHist;
+  osalProfRec_t *pRec;
+  uint16 latency = 0;
+  uint16 exec = end - start;
+  uint8 bit;
+
+  if ( osal_prof == NULL )
+  {
+    return;
+  }
+
+  pHist = &osal_prof[task_id].hist;
+
+  // Latency of the oldest event processed
+  for ( bit = 0; bit < 16; bit++ )
+  {
+    if ( ( events & ( (uint16)1 << bit ) ) &&
+         ( (uint16)( start - osal_prof[task_id].setTime[bit] ) > latency ) )
+    {
+      latency = start - osal_prof[task_id].setTime[bit];
+    }
+  }
+
+  if ( pHist->count != 0xFFFF )
+  {
+    pHist->count++;
+  }
+  if ( latency > pHist->maxLatency )
+  {
+    pHist->maxLatency = latency;
+  }
+  if ( exec > pHist->maxExec )
+  {
+    pHist->maxExec = exec;
+  }
+
+  bit = osal_prof_bucket( latency );
+  if ( pHist->latency[bit] != 0xFFFF )
+  {
+    pHist->latency[bit]++;
+  }
+  bit = osal_prof_bucket( exec );
+  if ( pHist->exec[bit] != 0xFFFF )
+  {
+    pHist->exec[bit]++;
+  }
+
+  // Log the run, overwriting the oldest one when full
+  pRec = &osal_profRing[osal_profRingHead];
+  pRec->taskId = task_id;
+  pRec->timestamp = start;
+  pRec->events = events;
+  pRec->latency = latency;
+  pRec->exec = exec;
+
+  if ( ++osal_profRingHead >= OSAL_PROF_RING_SIZE )
+  {
+    osal_profRingHead = 0;
+  }
+  if ( osal_profRingCnt < OSAL_PROF_RING_SIZE )
+  {
+    osal_profRingCnt++;
+  }
+}
+
+/*********************************************************************
+ * @fn      osal_prof_get_hist
+ *
+ * @brief
+ *
+ *   Get the event latency and execution time histograms of a task.
+ *
+ * @param   uint8 task_id - task ID
+ *
+ * @return  histograms, NULL if the task ID is invalid
+ */
+osalProfHist_t *osal_prof_get_hist( uint8 task_id )
+{
+  if ( ( osal_prof == NULL ) || ( task_id >= tasksCnt ) )
+  {
+    return ( NULL );
+  }
+
+  return ( &osal_prof[task_id].hist );
+}
+
+/*********************************************************************
+ * @fn      osal_prof_ring_read
+ *
+ * @brief
+ *
+ *   Take the oldest task run out of the profiler ring buffer.
+ *
+ * @param   osalProfRec_t *pRec - buffer for the task run
+ *
+ * @return  TRUE if a task run was read, FALSE if the ring is empty
+ */
+uint8 osal_prof_ring_read( osalProfRec_t *pRec )
+{
+  halIntState_t intState;
+  uint8 idx;
+
+  if ( osal_profRingCnt == 0 )
+  {
+    return ( FALSE );
+  }
+
+  HAL_ENTER_CRITICAL_SECTION(intState);
+  idx = ( osal_profRingHead + OSAL_PROF_RING_SIZE - osal_profRingCnt ) % OSAL_PROF_RING_SIZE;
+  osal_memcpy( pRec, &osal_profRing[idx], sizeof( osalProfRec_t ) );
+  osal_profRingCnt--;
+  HAL_EXIT_CRITICAL_SECTION(intState);
+
+  return ( TRUE );
+}
+
+/*********************************************************************
+ * @fn      osal_prof_reset
+ *
+ * @brief
+ *
+ *   Clear the profiler histograms and ring buffer. Pending event
+ *   timestamps are kept.
+ *
+ * @param   void
+ *
+ * @return  none
+ */
+void osal_prof_reset( void )
+{
+  halIntState_t intState;
+  uint8 idx;
+
+  HAL_ENTER_CRITICAL_SECTION(intState);
+
+  if ( osal_prof != NULL )
+  {
+    for ( idx = 0; idx < tasksCnt; idx++ )
+    {
+      osal_memset( &osal_prof[idx].hist, 0, sizeof( osalProfHist_t ) );
+    }
+  }
+
+  osal_profRingHead = 0;
+  osal_profRingCnt = 0;
+
+  HAL_EXIT_CRITICAL_SECTION(intState);
+}
+#endif // OSAL_PROFILER
+
 /*********************************************************************
  */
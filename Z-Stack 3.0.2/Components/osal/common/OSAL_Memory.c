@@ -52,6 +52,11 @@
 #include "hal_mcu.h"
 #include "hal_assert.h"
 
+#if OSALMEM_SITES
+// Stack libraries call the plain function; it is defined below rather than mapped to a site.
+#undef osal_mem_alloc
+#endif
+
 /* ------------------------------------------------------------------------------------------------
  *                                           Constants
  * ------------------------------------------------------------------------------------------------
@@ -130,10 +135,81 @@
 #define OSALMEM_BIGBLK_IDX        (OSALMEM_SMALLBLK_HDRCNT + 1)
 // The size of the wilderness after losing the small-block heap, the wasted header to block the
 // small-block heap from being coalesced, and the wasted header to mark the end of the heap.
-#define OSALMEM_BIGBLK_SZ         (MAXMEMHEAP - OSALMEM_SMALLBLK_BUCKET - OSALMEM_HDRSZ*2)
+#define OSALMEM_BIGBLK_SZ         (OSALMEM_HEAPSZ - OSALMEM_SMALLBLK_BUCKET - OSALMEM_HDRSZ*2)
 // Index of the last available osalMemHdr_t at the end of the heap which will be set to zero for
 // fast comparisons with zero to determine the end of the heap.
-#define OSALMEM_LASTBLK_IDX      ((MAXMEMHEAP / OSALMEM_HDRSZ) - 1)
+#define OSALMEM_LASTBLK_IDX      ((OSALMEM_HEAPSZ / OSALMEM_HDRSZ) - 1)
+
+/*
+ * Optional size-class slabs. When OSALMEM_SLAB is TRUE, allocations made after osal_mem_kick()
+ * that fit one of the size classes below are served from a free list of fixed-size blocks in
+ * constant time, without a block header and without walking or fragmenting the heap. A request
+ * falls back to the heap when its class is exhausted, or when it is larger than the biggest class.
+ * The slabs are carved from MAXMEMHEAP, so the total RAM used is unchanged.
+ *
+ * Size the classes from the OSALMEM_PROFILER proMax[] counts of the application under load and
+ * check osal_heap_slab_max() and osal_heap_slab_miss() afterwards. Each size must be an even
+ * multiple of OSALMEM_SLAB_ALIGN and the sizes must be in ascending order.
+ *
+ * With OSALMEM_METRICS, the bytes held in slab blocks are counted by osal_heap_mem_used() and
+ * osal_heap_high_water(); the block counts of osal_heap_block_cnt() and friends describe the
+ * first-fit heap only.
+ */
+#if OSALMEM_SLAB
+/* Preprocessor value of the slab alignment, since OSALMEM_HDRSZ is a sizeof() that #if cannot use.
+ * The default of 8 is the largest OSALMEM_HDRSZ of any target and also holds a free-list link.
+ */
+#if !defined OSALMEM_SLAB_ALIGN
+#define OSALMEM_SLAB_ALIGN         8
+#endif
+#if !defined OSALMEM_SLAB_SZ0
+#define OSALMEM_SLAB_SZ0           16
+#endif
+#if !defined OSALMEM_SLAB_CNT0
+#define OSALMEM_SLAB_CNT0          8
+#endif
+#if !defined OSALMEM_SLAB_SZ1
+#define OSALMEM_SLAB_SZ1           32
+#endif
+#if !defined OSALMEM_SLAB_CNT1
+#define OSALMEM_SLAB_CNT1          4
+#endif
+#if !defined OSALMEM_SLAB_SZ2
+#define OSALMEM_SLAB_SZ2           64
+#endif
+#if !defined OSALMEM_SLAB_CNT2
+#define OSALMEM_SLAB_CNT2          4
+#endif
+#if !defined OSALMEM_SLAB_SZ3
+#define OSALMEM_SLAB_SZ3           128
+#endif
+#if !defined OSALMEM_SLAB_CNT3
+#define OSALMEM_SLAB_CNT3          2
+#endif
+
+// Total bytes taken from MAXMEMHEAP by the slabs.
+#define OSALMEM_SLAB_TOTAL        ((OSALMEM_SLAB_SZ0 * OSALMEM_SLAB_CNT0) + \
+                                   (OSALMEM_SLAB_SZ1 * OSALMEM_SLAB_CNT1) + \
+                                   (OSALMEM_SLAB_SZ2 * OSALMEM_SLAB_CNT2) + \
+                                   (OSALMEM_SLAB_SZ3 * OSALMEM_SLAB_CNT3))
+
+#if ((OSALMEM_SLAB_SZ0 % OSALMEM_SLAB_ALIGN) || (OSALMEM_SLAB_SZ1 % OSALMEM_SLAB_ALIGN) || \
+     (OSALMEM_SLAB_SZ2 % OSALMEM_SLAB_ALIGN) || (OSALMEM_SLAB_SZ3 % OSALMEM_SLAB_ALIGN))
+#error OSALMEM_SLAB_SZx must be even multiples of OSALMEM_SLAB_ALIGN!
+#endif
+#if ((OSALMEM_SLAB_SZ0 == 0) || (OSALMEM_SLAB_SZ0 >= OSALMEM_SLAB_SZ1) || \
+     (OSALMEM_SLAB_SZ1 >= OSALMEM_SLAB_SZ2) || (OSALMEM_SLAB_SZ2 >= OSALMEM_SLAB_SZ3))
+#error OSALMEM_SLAB_SZx must be in ascending order!
+#endif
+#if (OSALMEM_SLAB_TOTAL >= (MAXMEMHEAP / 2))
+#error OSALMEM_SLAB_TOTAL takes too much of MAXMEMHEAP!
+#endif
+
+// Size of the first-fit heap after the slabs are taken out.
+#define OSALMEM_HEAPSZ            (MAXMEMHEAP - OSALMEM_SLAB_TOTAL)
+#else
+#define OSALMEM_HEAPSZ             MAXMEMHEAP
+#endif
 
 // For information about memory profiling, refer to SWRA204 "Heap Memory Management", section 1.5.
 #if !defined OSALMEM_PROFILER
@@ -143,6 +219,18 @@
 #define OSALMEM_PROFILER_LL        FALSE  // Special profiling of the Long-Lived bucket.
 #endif
 
+/*
+ * Optional call site attribution. When OSALMEM_SITES is TRUE, every osal_mem_alloc() compiled
+ * against OSAL_Memory.h passes its source file id and line, and each block carries one extra
+ * OSALMEM_HDRSZ tag in front of the user data with the index of its site in the table below.
+ * The table keeps the live count, live bytes, peak bytes and allocation count of each site, so a
+ * host can read it over MT at any time and derive the allocation rate from successive reads.
+ * Allocations from the stack libraries are attributed to OSALMEM_FILE_UNKNOWN, line 0.
+ */
+#if OSALMEM_SITES && defined DPRINTF_OSALHEAPTRACE
+#error OSALMEM_SITES and DPRINTF_OSALHEAPTRACE cannot be used together.
+#endif
+
 #if OSALMEM_PROFILER
 #define OSALMEM_INIT              'X'
 #define OSALMEM_ALOC              'A'
@@ -170,21 +258,53 @@ typedef union {
   osalMemHdrHdr_t hdr;
 } osalMemHdr_t;
 
+#if OSALMEM_SLAB
+// A free slab block holds the link to the next free block of its size class.
+typedef struct osalMemSlabBlk {
+  struct osalMemSlabBlk *next;
+} osalMemSlabBlk_t;
+
+/* OSALMEM_SLAB_ALIGN is checked against the target sizes it stands in for by the same
+ * negative-array-size typedef as HAL_ASSERT_SIZE(); no memory is consumed by the check.
+ */
+typedef char osalMemSlabAlign_assert_t[-1+10*(((OSALMEM_SLAB_ALIGN % OSALMEM_HDRSZ) == 0) &&
+                                              (OSALMEM_SLAB_ALIGN >= sizeof(osalMemSlabBlk_t)))];
+#endif
+
 /* ------------------------------------------------------------------------------------------------
  *                                           Local Variables
  * ------------------------------------------------------------------------------------------------
  */
 
 #if !defined ( ZBIT ) && defined ewarm
-static __no_init osalMemHdr_t theHeap[MAXMEMHEAP / OSALMEM_HDRSZ];
+static __no_init osalMemHdr_t theHeap[OSALMEM_HEAPSZ / OSALMEM_HDRSZ];
 static __no_init osalMemHdr_t *ff1;  // First free block in the small-block bucket.
 #else
-static osalMemHdr_t theHeap[MAXMEMHEAP / OSALMEM_HDRSZ];
+static osalMemHdr_t theHeap[OSALMEM_HEAPSZ / OSALMEM_HDRSZ];
 static osalMemHdr_t *ff1;  // First free block in the small-block bucket.
 #endif
 
 static uint8 osalMemStat;            // Discrete status flags: 0x01 = kicked.
 
+#if OSALMEM_SLAB
+#if !defined ( ZBIT ) && defined ewarm
+static __no_init osalMemHdr_t theSlabs[OSALMEM_SLAB_TOTAL / OSALMEM_HDRSZ];
+#else
+static osalMemHdr_t theSlabs[OSALMEM_SLAB_TOTAL / OSALMEM_HDRSZ];
+#endif
+
+static const uint16 slabSz[OSALMEM_SLAB_CLASSES] = {
+OSALMEM_SLAB_SZ0, OSALMEM_SLAB_SZ1, OSALMEM_SLAB_SZ2, OSALMEM_SLAB_SZ3 };
+static const uint8 slabCnt[OSALMEM_SLAB_CLASSES] = {
+OSALMEM_SLAB_CNT0, OSALMEM_SLAB_CNT1, OSALMEM_SLAB_CNT2, OSALMEM_SLAB_CNT3 };
+
+static uint8 *slabEnd[OSALMEM_SLAB_CLASSES];            // First byte past each size class.
+static osalMemSlabBlk_t *slabFree[OSALMEM_SLAB_CLASSES]; // Free list of each size class.
+static uint8 slabCur[OSALMEM_SLAB_CLASSES];   // Current cnt of blocks allocated.
+static uint8 slabMax[OSALMEM_SLAB_CLASSES];   // Max cnt of blocks ever allocated at once.
+static uint16 slabMiss[OSALMEM_SLAB_CLASSES]; // Cnt of allocations that fell back to the heap.
+#endif
+
 #if OSALMEM_METRICS
 static uint16 blkMax;  // Max cnt of all blocks ever seen at once.
 static uint16 blkCnt;  // Current cnt of all blocks.
@@ -207,6 +327,11 @@ static uint16 proTot[OSALMEM_PROMAX] = { 0 };
 static uint16 proSmallBlkMiss;
 #endif
 
+#if OSALMEM_SITES
+static osalMemSite_t sites[OSALMEM_SITE_MAX];
+static uint8 siteCnt;  // Number of entries of sites[] in use.
+#endif
+
 /* ------------------------------------------------------------------------------------------------
  *                                           Global Variables
  * ------------------------------------------------------------------------------------------------
@@ -216,6 +341,25 @@ static uint16 proSmallBlkMiss;
 extern int dprintf(const char *fmt, ...);
 #endif /* DPRINTF_HEAPTRACE */
 
+/* ------------------------------------------------------------------------------------------------
+ *                                           Local Functions
+ * ------------------------------------------------------------------------------------------------
+ */
+
+#if OSALMEM_SLAB
+static void osalMemSlabInit(void);
+static void *osalMemSlabAlloc(uint16 size);
+static uint8 osalMemSlabClass(void *ptr);
+static uint8 osalMemSlabFree(void *ptr);
+#endif
+
+#if OSALMEM_SITES
+static void *osalMemAlloc(uint16 size);
+static void osalMemFree(void *ptr);
+static uint8 osalMemSiteFind(uint8 file, uint16 line);
+static uint16 osalMemBlkSize(void *ptr);
+#endif
+
 /**************************************************************************************************
  * @fn          osal_mem_init
  *
@@ -238,7 +382,7 @@ void osal_mem_init(void)
   HAL_ASSERT(((OSALMEM_SMALL_BLKSZ % OSALMEM_HDRSZ) == 0));
 
 #if OSALMEM_PROFILER
-  (void)osal_memset(theHeap, OSALMEM_INIT, MAXMEMHEAP);
+  (void)osal_memset(theHeap, OSALMEM_INIT, OSALMEM_HEAPSZ);
 #endif
 
   // Setup a NULL block at the end of the heap for fast comparisons with zero.
@@ -260,6 +404,10 @@ void osal_mem_init(void)
    */
   blkCnt = blkFree = 2;
 #endif
+
+#if OSALMEM_SLAB
+  osalMemSlabInit();
+#endif
 }
 
 /**************************************************************************************************
@@ -283,7 +431,11 @@ void osal_mem_init(void)
 void osal_mem_kick(void)
 {
   halIntState_t intState;
+#if OSALMEM_SITES
+  osalMemHdr_t *tmp = osalMemAlloc(1);
+#else
   osalMemHdr_t *tmp = osal_mem_alloc(1);
+#endif
 
   HAL_ASSERT((tmp != NULL));
   HAL_ENTER_CRITICAL_SECTION(intState);  // Hold off interrupts.
@@ -293,7 +445,11 @@ void osal_mem_kick(void)
    * for sizes meeting the OSALMEM_SMALL_BLKSZ criteria.
    */
   ff1 = tmp - 1;       // Set 'ff1' to point to the first available memory after the LL block.
+#if OSALMEM_SITES
+  osalMemFree(tmp);
+#else
   osal_mem_free(tmp);
+#endif
   osalMemStat = 0x01;  // Set 'osalMemStat' after the free because it enables memory profiling.
 
   HAL_EXIT_CRITICAL_SECTION(intState);  // Re-enable interrupts.
@@ -314,7 +470,9 @@ void osal_mem_kick(void)
  *
  * @return      None.
  */
-#ifdef DPRINTF_OSALHEAPTRACE
+#if OSALMEM_SITES
+static void *osalMemAlloc( uint16 size )
+#elif defined DPRINTF_OSALHEAPTRACE
 void *osal_mem_alloc_dbg( uint16 size, const char *fname, unsigned lnum )
 #else /* DPRINTF_OSALHEAPTRACE */
 void *osal_mem_alloc( uint16 size )
@@ -325,6 +483,22 @@ void *osal_mem_alloc( uint16 size )
   halIntState_t intState;
   uint8 coal = 0;
 
+#if OSALMEM_SLAB
+  // Long-lived allocations made before osal_mem_kick() stay in the LL block.
+  if ( osalMemStat != 0 )
+  {
+    hdr = osalMemSlabAlloc( size );
+
+    if ( hdr != NULL )
+    {
+#ifdef DPRINTF_OSALHEAPTRACE
+      dprintf("osal_mem_alloc(%u)->%lx:%s:%u\n", size, (unsigned) hdr, fname, lnum);
+#endif /* DPRINTF_OSALHEAPTRACE */
+      return (void *)hdr;
+    }
+  }
+#endif
+
   size += OSALMEM_HDRSZ;
 
   // Calculate required bytes to add to 'size' to align to halDataAlign_t.
@@ -508,7 +682,9 @@ void *osal_mem_alloc( uint16 size )
  *
  * @return      None.
  */
-#ifdef DPRINTF_OSALHEAPTRACE
+#if OSALMEM_SITES
+static void osalMemFree(void *ptr)
+#elif defined DPRINTF_OSALHEAPTRACE
 void osal_mem_free_dbg(void *ptr, const char *fname, unsigned lnum)
 #else /* DPRINTF_OSALHEAPTRACE */
 void osal_mem_free(void *ptr)
@@ -521,7 +697,14 @@ void osal_mem_free(void *ptr)
   dprintf("osal_mem_free(%lx):%s:%u\n", (unsigned) ptr, fname, lnum);
 #endif /* DPRINTF_OSALHEAPTRACE */
 
-  HAL_ASSERT(((uint8 *)ptr >= (uint8 *)theHeap) && ((uint8 *)ptr < (uint8 *)theHeap+MAXMEMHEAP));
+#if OSALMEM_SLAB
+  if ( osalMemSlabFree( ptr ) )
+  {
+    return;
+  }
+#endif
+
+  HAL_ASSERT(((uint8 *)ptr >= (uint8 *)theHeap) && ((uint8 *)ptr < (uint8 *)theHeap+OSALMEM_HEAPSZ));
   HAL_ASSERT(hdr->hdr.inUse);
 
   HAL_ENTER_CRITICAL_SECTION( intState );  // Hold off interrupts.
@@ -560,6 +743,255 @@ void osal_mem_free(void *ptr)
   HAL_EXIT_CRITICAL_SECTION( intState );  // Re-enable interrupts.
 }
 
+#if OSALMEM_SITES
+/**************************************************************************************************
+ * @fn          osal_mem_alloc_site
+ *
+ * @brief       Allocate a block of memory on behalf of a call site and account for it in the
+ *              heap usage of that site.
+ *
+ * input parameters
+ *
+ * @param size - the number of bytes to allocate from the HEAP.
+ * @param file - OSALMEM_FILE_xxx identifier of the calling source file.
+ * @param line - source line of the call.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      Pointer to the allocated memory, or NULL if the allocation failed.
+ */
+void *osal_mem_alloc_site( uint16 size, uint8 file, uint16 line )
+{
+  osalMemHdr_t *tag = osalMemAlloc( size + OSALMEM_HDRSZ );
+  halIntState_t intState;
+
+  if ( tag != NULL )
+  {
+    osalMemSite_t *pSite;
+    uint8 idx;
+
+    HAL_ENTER_CRITICAL_SECTION( intState );  // Hold off interrupts.
+
+    idx = osalMemSiteFind( file, line );
+    pSite = &sites[idx];
+    pSite->liveCnt++;
+    pSite->liveBytes += osalMemBlkSize( tag );
+    pSite->allocCnt++;
+    if ( pSite->peakBytes < pSite->liveBytes )
+    {
+      pSite->peakBytes = pSite->liveBytes;
+    }
+
+    HAL_EXIT_CRITICAL_SECTION( intState );  // Re-enable interrupts.
+
+    tag->val = idx;
+    tag++;
+  }
+
+  return (void *)tag;
+}
+
+/**************************************************************************************************
+ * @fn          osal_mem_alloc
+ *
+ * @brief       Allocate a block of memory for a caller that was not compiled against
+ *              OSAL_Memory.h with OSALMEM_SITES, i.e. the stack libraries.
+ *
+ * input parameters
+ *
+ * @param size - the number of bytes to allocate from the HEAP.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      Pointer to the allocated memory, or NULL if the allocation failed.
+ */
+void *osal_mem_alloc( uint16 size )
+{
+  return osal_mem_alloc_site( size, OSALMEM_FILE_UNKNOWN, 0 );
+}
+
+/**************************************************************************************************
+ * @fn          osal_mem_free
+ *
+ * @brief       Free a block of memory and take it off the heap usage of its call site.
+ *
+ * input parameters
+ *
+ * @param ptr - A valid pointer (i.e. a pointer returned by osal_mem_alloc()) to the memory to free.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      None.
+ */
+void osal_mem_free( void *ptr )
+{
+  osalMemHdr_t *tag = (osalMemHdr_t *)ptr - 1;
+  osalMemSite_t *pSite;
+  halIntState_t intState;
+
+  HAL_ASSERT((tag->val < siteCnt));
+
+  HAL_ENTER_CRITICAL_SECTION( intState );  // Hold off interrupts.
+
+  pSite = &sites[tag->val];
+  pSite->liveCnt--;
+  pSite->liveBytes -= osalMemBlkSize( tag );
+
+  HAL_EXIT_CRITICAL_SECTION( intState );  // Re-enable interrupts.
+
+  osalMemFree( tag );
+}
+
+/**************************************************************************************************
+ * @fn          osalMemSiteFind
+ *
+ * @brief       Find the table entry of a call site, adding one if the site is new. Once the
+ *              table is full, all new sites share a last entry marked OSALMEM_FILE_OVERFLOW.
+ *              Must be called with interrupts held off.
+ *
+ * input parameters
+ *
+ * @param file - OSALMEM_FILE_xxx identifier of the calling source file.
+ * @param line - source line of the call.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      Index of the entry in sites[].
+ */
+static uint8 osalMemSiteFind(uint8 file, uint16 line)
+{
+  uint8 idx;
+
+  for ( idx = 0; idx < siteCnt; idx++ )
+  {
+    if ( (sites[idx].line == line) && (sites[idx].file == file) )
+    {
+      return idx;
+    }
+  }
+
+  if ( siteCnt == OSALMEM_SITE_MAX )
+  {
+    return (OSALMEM_SITE_MAX - 1);
+  }
+
+  if ( siteCnt == (OSALMEM_SITE_MAX - 1) )
+  {
+    file = OSALMEM_FILE_OVERFLOW;
+    line = 0;
+  }
+
+  sites[idx].file = file;
+  sites[idx].line = line;
+  siteCnt++;
+
+  return idx;
+}
+
+/**************************************************************************************************
+ * @fn          osalMemBlkSize
+ *
+ * @brief       Return the number of bytes a block takes out of the heap or out of its slab.
+ *
+ * input parameters
+ *
+ * @param ptr - pointer returned by osalMemAlloc().
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      Size of the block, including its header.
+ */
+static uint16 osalMemBlkSize(void *ptr)
+{
+#if OSALMEM_SLAB
+  uint8 cls = osalMemSlabClass( ptr );
+
+  if ( cls < OSALMEM_SLAB_CLASSES )
+  {
+    return slabSz[cls];
+  }
+#endif
+
+  return ((osalMemHdr_t *)ptr - 1)->hdr.len;
+}
+
+/*********************************************************************
+ * @fn      osal_heap_site_cnt
+ *
+ * @brief   Return the number of call sites now tracked.
+ *
+ * @param   none
+ *
+ * @return  Number of entries in use, at most OSALMEM_SITE_MAX.
+ */
+uint8 osal_heap_site_cnt( void )
+{
+  return siteCnt;
+}
+
+/*********************************************************************
+ * @fn      osal_heap_site_get
+ *
+ * @brief   Copy out the heap usage of a tracked call site.
+ *
+ * @param   idx - entry index, less than osal_heap_site_cnt().
+ * @param   pSite - buffer to receive the entry.
+ *
+ * @return  TRUE if the entry was copied, FALSE if idx is out of range.
+ */
+uint8 osal_heap_site_get( uint8 idx, osalMemSite_t *pSite )
+{
+  halIntState_t intState;
+
+  if ( idx >= siteCnt )
+  {
+    return FALSE;
+  }
+
+  HAL_ENTER_CRITICAL_SECTION( intState );  // Hold off interrupts.
+  *pSite = sites[idx];
+  HAL_EXIT_CRITICAL_SECTION( intState );  // Re-enable interrupts.
+
+  return TRUE;
+}
+
+/*********************************************************************
+ * @fn      osal_heap_site_reset
+ *
+ * @brief   Restart the peak and allocation counts of all call sites. The live counts, and the
+ *          sites themselves, are kept since their blocks are still allocated.
+ *
+ * @param   none
+ *
+ * @return  none
+ */
+void osal_heap_site_reset( void )
+{
+  halIntState_t intState;
+  uint8 idx;
+
+  HAL_ENTER_CRITICAL_SECTION( intState );  // Hold off interrupts.
+
+  for ( idx = 0; idx < siteCnt; idx++ )
+  {
+    sites[idx].peakBytes = sites[idx].liveBytes;
+    sites[idx].allocCnt = 0;
+  }
+
+  HAL_EXIT_CRITICAL_SECTION( intState );  // Re-enable interrupts.
+}
+#endif
+
 #if OSALMEM_METRICS
 /*********************************************************************
  * @fn      osal_heap_block_max
@@ -618,6 +1050,241 @@ uint16 osal_heap_mem_used( void )
 }
 #endif
 
+#if OSALMEM_SLAB
+/**************************************************************************************************
+ * @fn          osalMemSlabInit
+ *
+ * @brief       Thread every block of each slab size class onto the free list of its class.
+ *
+ * input parameters
+ *
+ * None.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      None.
+ */
+static void osalMemSlabInit(void)
+{
+  uint8 *pBlk = (uint8 *)theSlabs;
+  uint8 cls;
+  uint8 cnt;
+
+  for ( cls = 0; cls < OSALMEM_SLAB_CLASSES; cls++ )
+  {
+    slabFree[cls] = NULL;
+
+    // Thread the blocks in reverse so the list starts at the lowest address.
+    for ( cnt = slabCnt[cls]; cnt > 0; cnt-- )
+    {
+      osalMemSlabBlk_t *blk = (osalMemSlabBlk_t *)(pBlk + ((cnt - 1) * slabSz[cls]));
+
+      blk->next = slabFree[cls];
+      slabFree[cls] = blk;
+    }
+
+    pBlk += (slabCnt[cls] * slabSz[cls]);
+    slabEnd[cls] = pBlk;
+  }
+}
+
+/**************************************************************************************************
+ * @fn          osalMemSlabAlloc
+ *
+ * @brief       Allocate a block from the smallest slab size class that fits the request.
+ *              Only the one class is tried so that the larger classes remain available to the
+ *              requests that need them; a miss is counted and left for the heap.
+ *
+ * input parameters
+ *
+ * @param size - the number of bytes requested.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      Pointer to the block, or NULL if the size has no class or the class is exhausted.
+ */
+static void *osalMemSlabAlloc(uint16 size)
+{
+  osalMemSlabBlk_t *blk;
+  halIntState_t intState;
+  uint8 cls;
+
+  for ( cls = 0; cls < OSALMEM_SLAB_CLASSES; cls++ )
+  {
+    if ( size <= slabSz[cls] )
+    {
+      break;
+    }
+  }
+
+  if ( cls == OSALMEM_SLAB_CLASSES )
+  {
+    return NULL;
+  }
+
+  HAL_ENTER_CRITICAL_SECTION( intState );  // Hold off interrupts.
+
+  blk = slabFree[cls];
+
+  if ( blk != NULL )
+  {
+    slabFree[cls] = blk->next;
+
+    if ( slabMax[cls] < ++slabCur[cls] )
+    {
+      slabMax[cls] = slabCur[cls];
+    }
+
+#if OSALMEM_METRICS
+    memAlo += slabSz[cls];
+    if ( memMax < memAlo )
+    {
+      memMax = memAlo;
+    }
+#endif
+  }
+  else
+  {
+    slabMiss[cls]++;
+  }
+
+  HAL_EXIT_CRITICAL_SECTION( intState );  // Re-enable interrupts.
+
+  return (void *)blk;
+}
+
+/**************************************************************************************************
+ * @fn          osalMemSlabClass
+ *
+ * @brief       Find the slab size class a pointer belongs to.
+ *
+ * input parameters
+ *
+ * @param ptr - pointer to a block.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      Size class index, or OSALMEM_SLAB_CLASSES if the pointer belongs to the heap.
+ */
+static uint8 osalMemSlabClass(void *ptr)
+{
+  uint8 cls;
+
+  if ( ((uint8 *)ptr < (uint8 *)theSlabs) || ((uint8 *)ptr >= slabEnd[OSALMEM_SLAB_CLASSES-1]) )
+  {
+    return OSALMEM_SLAB_CLASSES;
+  }
+
+  for ( cls = 0; (uint8 *)ptr >= slabEnd[cls]; cls++ );
+
+  return cls;
+}
+
+/**************************************************************************************************
+ * @fn          osalMemSlabFree
+ *
+ * @brief       Return a block to the free list of its slab size class.
+ *
+ * input parameters
+ *
+ * @param ptr - pointer being freed.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      TRUE if the pointer belonged to a slab, FALSE if it belongs to the heap.
+ */
+static uint8 osalMemSlabFree(void *ptr)
+{
+  osalMemSlabBlk_t *blk = (osalMemSlabBlk_t *)ptr;
+  halIntState_t intState;
+  uint8 cls = osalMemSlabClass( ptr );
+
+  if ( cls == OSALMEM_SLAB_CLASSES )
+  {
+    return FALSE;
+  }
+
+  HAL_ASSERT((slabCur[cls] != 0));
+  HAL_ENTER_CRITICAL_SECTION( intState );  // Hold off interrupts.
+
+  blk->next = slabFree[cls];
+  slabFree[cls] = blk;
+  slabCur[cls]--;
+#if OSALMEM_METRICS
+  memAlo -= slabSz[cls];
+#endif
+
+  HAL_EXIT_CRITICAL_SECTION( intState );  // Re-enable interrupts.
+
+  return TRUE;
+}
+
+/*********************************************************************
+ * @fn      osal_heap_slab_size
+ *
+ * @brief   Return the data size of the blocks in a slab size class.
+ *
+ * @param   cls - size class index, less than OSALMEM_SLAB_CLASSES.
+ *
+ * @return  Block size in bytes.
+ */
+uint16 osal_heap_slab_size( uint8 cls )
+{
+  return (cls < OSALMEM_SLAB_CLASSES) ? slabSz[cls] : 0;
+}
+
+/*********************************************************************
+ * @fn      osal_heap_slab_cnt
+ *
+ * @brief   Return the current number of blocks allocated from a slab size class.
+ *
+ * @param   cls - size class index, less than OSALMEM_SLAB_CLASSES.
+ *
+ * @return  Current number of blocks allocated.
+ */
+uint8 osal_heap_slab_cnt( uint8 cls )
+{
+  return (cls < OSALMEM_SLAB_CLASSES) ? slabCur[cls] : 0;
+}
+
+/*********************************************************************
+ * @fn      osal_heap_slab_max
+ *
+ * @brief   Return the maximum number of blocks ever allocated at once from a slab size class.
+ *
+ * @param   cls - size class index, less than OSALMEM_SLAB_CLASSES.
+ *
+ * @return  High-water count of blocks allocated.
+ */
+uint8 osal_heap_slab_max( uint8 cls )
+{
+  return (cls < OSALMEM_SLAB_CLASSES) ? slabMax[cls] : 0;
+}
+
+/*********************************************************************
+ * @fn      osal_heap_slab_miss
+ *
+ * @brief   Return the number of allocations of a slab size class that found the class
+ *          exhausted and fell back to the heap.
+ *
+ * @param   cls - size class index, less than OSALMEM_SLAB_CLASSES.
+ *
+ * @return  Number of misses.
+ */
+uint16 osal_heap_slab_miss( uint8 cls )
+{
+  return (cls < OSALMEM_SLAB_CLASSES) ? slabMiss[cls] : 0;
+}
+#endif
+
 #if defined (ZTOOL_P1) || defined (ZTOOL_P2)
 /*********************************************************************
  * @fn      osal_heap_high_water
@@ -65,6 +65,12 @@ typedef union {
   uint8 time8[4];
 } osalTime_t;
 
+/*
+ * The timer list is kept sorted by expiration time (delta list).
+ * Each record's timeout is relative to the expiration of the record
+ * ahead of it, so the head holds the time to the next expiration and
+ * a tick only has to touch the records that actually expire.
+ */
 typedef struct
 {
   void   *next;
@@ -94,12 +100,17 @@ osalTimerRec_t *timerHead;
 // Milliseconds since last reboot
 static uint32 osal_systemClock;
 
+// Number of records in the timer list
+static uint8 osal_timerCount;
+
 /*********************************************************************
  * LOCAL FUNCTION PROTOTYPES
  */
 osalTimerRec_t  *osalAddTimer( uint8 task_id, uint16 event_flag, uint32 timeout );
 osalTimerRec_t *osalFindTimer( uint8 task_id, uint16 event_flag );
 void osalDeleteTimer( osalTimerRec_t *rmTimer );
+static void osalInsertTimer( osalTimerRec_t *newTimer, uint32 timeout );
+static void osalUnlinkTimer( osalTimerRec_t *rmTimer );
 
 /*********************************************************************
  * FUNCTIONS
@@ -119,6 +130,94 @@ void osalTimerInit( void )
   osal_systemClock = 0;
 }
 
+/*********************************************************************
+ * @fn      osalInsertTimer
+ *
+ * @brief   Insert a timer record into the sorted timer list.
+ *          Ints must be disabled.
+ *
+ * @param   newTimer - record to insert (not in the list)
+ * @param   timeout - absolute time to expiration, in milliseconds
+ *
+ * @return  none
+ */
+static void osalInsertTimer( osalTimerRec_t *newTimer, uint32 timeout )
+{
+  osalTimerRec_t *srchTimer;
+  osalTimerRec_t *prevTimer = NULL;
+
+  srchTimer = timerHead;
+
+  // Timers with an equal timeout stay in the order they were started
+  while ( (srchTimer != NULL) && (srchTimer->timeout.time32 <= timeout) )
+  {
+    timeout -= srchTimer->timeout.time32;
+    prevTimer = srchTimer;
+    srchTimer = srchTimer->next;
+  }
+
+  newTimer->timeout.time32 = timeout;
+  newTimer->next = srchTimer;
+
+  // The record behind the new one is now relative to it
+  if ( srchTimer != NULL )
+  {
+    srchTimer->timeout.time32 -= timeout;
+  }
+
+  if ( prevTimer == NULL )
+  {
+    timerHead = newTimer;
+  }
+  else
+  {
+    prevTimer->next = newTimer;
+  }
+
+  osal_timerCount++;
+}
+
+/*********************************************************************
+ * @fn      osalUnlinkTimer
+ *
+ * @brief   Take a timer record out of the timer list without freeing it.
+ *          Ints must be disabled.
+ *
+ * @param   rmTimer - record to unlink (must be in the list)
+ *
+ * @return  none
+ */
+static void osalUnlinkTimer( osalTimerRec_t *rmTimer )
+{
+  osalTimerRec_t *srchTimer;
+  osalTimerRec_t *nextTimer = rmTimer->next;
+
+  if ( timerHead == rmTimer )
+  {
+    timerHead = nextTimer;
+  }
+  else
+  {
+    srchTimer = timerHead;
+
+    while ( srchTimer->next != rmTimer )
+    {
+      srchTimer = srchTimer->next;
+    }
+
+    srchTimer->next = nextTimer;
+  }
+
+  // Give the removed delta to the record behind it
+  if ( nextTimer != NULL )
+  {
+    nextTimer->timeout.time32 += rmTimer->timeout.time32;
+  }
+
+  rmTimer->next = NULL;
+  osal_timerCount--;
+}
+
 /*********************************************************************
  * @fn      osalAddTimer
  *
@@ -134,57 +233,33 @@ void osalTimerInit( void )
 osalTimerRec_t * osalAddTimer( uint8 task_id, uint16 event_flag, uint32 timeout )
 {
   osalTimerRec_t *newTimer;
-  osalTimerRec_t *srchTimer;
 
   // Look for an existing timer first
   newTimer = osalFindTimer( task_id, event_flag );
   if ( newTimer )
   {
-    // Timer is found - update it.
-    newTimer->timeout.time32 = timeout;
-
-    return ( newTimer );
+    // Timer is found - move it to its new position.
+    osalUnlinkTimer( newTimer );
   }
   else
   {
     // New Timer
     newTimer = osal_mem_alloc( sizeof( osalTimerRec_t ) );
 
-    if ( newTimer )
-    {
-      // Fill in new timer
-      newTimer->task_id = task_id;
-      newTimer->event_flag = event_flag;
-      newTimer->timeout.time32 = timeout;
-      newTimer->next = (void *)NULL;
-      newTimer->reloadTimeout = 0;
-
-      // Does the timer list already exist
-      if ( timerHead == NULL )
-      {
-        // Start task list
-        timerHead = newTimer;
-      }
-      else
-      {
-        // Add it to the end of the timer list
-        srchTimer = timerHead;
-
-        // Stop at the last record
-        while ( srchTimer->next )
-          srchTimer = srchTimer->next;
-
-        // Add to the list
-        srchTimer->next = newTimer;
-      }
-
-      return ( newTimer );
-    }
-    else
+    if ( newTimer == NULL )
     {
       return ( (osalTimerRec_t *)NULL );
     }
+
+    // Fill in new timer
+    newTimer->task_id = task_id;
+    newTimer->event_flag = event_flag;
+    newTimer->reloadTimeout = 0;
   }
+
+  osalInsertTimer( newTimer, timeout );
+
+  return ( newTimer );
 }
 
 /*********************************************************************
@@ -225,8 +300,8 @@ osalTimerRec_t *osalFindTimer( uint8 task_id, uint16 event_flag )
  * @fn      osalDeleteTimer
  *
  * @brief   Delete a timer from a timer list.
+ *          Ints must be disabled. The caller frees the record.
  *
- * @param   table
  * @param   rmTimer
  *
  * @return  none
@@ -236,9 +311,7 @@ void osalDeleteTimer( osalTimerRec_t *rmTimer )
   // Does the timer list really exist
   if ( rmTimer )
   {
-    // Clear the event flag and osalTimerUpdate() will delete
-    // the timer from the list.
-    rmTimer->event_flag = 0;
+    osalUnlinkTimer( rmTimer );
   }
 }
 
@@ -336,6 +409,11 @@ uint8 osal_stop_timerEx( uint8 task_id, uint16 event_id )
 
   HAL_EXIT_CRITICAL_SECTION( intState );   // Re-enable interrupts.
 
+  if ( foundTimer )
+  {
+    osal_mem_free( foundTimer );
+  }
+
   return ( (foundTimer != NULL) ? SUCCESS : INVALID_EVENT_ID );
 }
 
@@ -353,15 +431,28 @@ uint32 osal_get_timeoutEx( uint8 task_id, uint16 event_id )
 {
   halIntState_t intState;
   uint32 rtrn = 0;
-  osalTimerRec_t *tmr;
+  osalTimerRec_t *srchTimer;
 
   HAL_ENTER_CRITICAL_SECTION( intState );  // Hold off interrupts.
 
-  tmr = osalFindTimer( task_id, event_id );
+  // Sum the deltas up to the timer
+  srchTimer = timerHead;
+  while ( srchTimer )
+  {
+    rtrn += srchTimer->timeout.time32;
 
-  if ( tmr )
+    if ( srchTimer->event_flag == event_id &&
+         srchTimer->task_id == task_id )
+    {
+      break;
+    }
+
+    srchTimer = srchTimer->next;
+  }
+
+  if ( srchTimer == NULL )
   {
-    rtrn = tmr->timeout.time32;
+    rtrn = 0;
   }
 
   HAL_EXIT_CRITICAL_SECTION( intState );   // Re-enable interrupts.
@@ -380,25 +471,7 @@ uint32 osal_get_timeoutEx( uint8 task_id, uint16 event_id )
  */
 uint8 osal_timer_num_active( void )
 {
-  halIntState_t intState;
-  uint8 num_timers = 0;
-  osalTimerRec_t *srchTimer;
-
-  HAL_ENTER_CRITICAL_SECTION( intState );  // Hold off interrupts.
-
-  // Head of the timer list
-  srchTimer = timerHead;
-
-  // Count timers in the list
-  while ( srchTimer != NULL )
-  {
-    num_timers++;
-    srchTimer = srchTimer->next;
-  }
-
-  HAL_EXIT_CRITICAL_SECTION( intState );   // Re-enable interrupts.
-
-  return num_timers;
+  return osal_timerCount;
 }
 
 /*********************************************************************
@@ -406,6 +479,11 @@ uint8 osal_timer_num_active( void )
  *
  * @brief   Update the timer structures for a timer tick.
  *
+ *          Only the head of the sorted list is decremented; the
+ *          records that expire are taken off the front one at a
+ *          time, so the work done is independent of the number of
+ *          timers still pending.
+ *
  * @param   none
  *
  * @return  none
@@ -413,114 +491,64 @@ uint8 osal_timer_num_active( void )
 void osalTimerUpdate( uint32 updateTime )
 {
   halIntState_t intState;
-  osalTimerRec_t *srchTimer;
-  osalTimerRec_t *prevTimer;
-
-  osalTime_t timeUnion;
-  timeUnion.time32 = updateTime;
+  osalTimerRec_t *expTimer;
 
   HAL_ENTER_CRITICAL_SECTION( intState );  // Hold off interrupts.
   // Update the system time
   osal_systemClock += updateTime;
   HAL_EXIT_CRITICAL_SECTION( intState );   // Re-enable interrupts.
 
-  // Look for open timer slot
-  if ( timerHead != NULL )
+  for ( ;; )
   {
-    // Add it to the end of the timer list
-    srchTimer = timerHead;
-    prevTimer = (void *)NULL;
+    HAL_ENTER_CRITICAL_SECTION( intState );  // Hold off interrupts.
 
-    // Look for open timer slot
-    while ( srchTimer )
-    {
-      osalTimerRec_t *freeTimer = NULL;
+    expTimer = timerHead;
 
-      HAL_ENTER_CRITICAL_SECTION( intState );  // Hold off interrupts.
-
-      // To minimize time in this critical section, avoid 32-bit math
-      if ((timeUnion.time16[1] == 0) && (timeUnion.time8[1] == 0))
-      {
-        // If upper 24 bits are zero, check lower 8 bits for roll over
-        if (srchTimer->timeout.time8[0] >= timeUnion.time8[0])
-        {
-          // 8-bit math
-          srchTimer->timeout.time8[0] -= timeUnion.time8[0];
-        }
-        else
-        {
-          // 32-bit math
-          if (srchTimer->timeout.time32 > timeUnion.time32)
-          {
-            srchTimer->timeout.time32 -= timeUnion.time32;
-          }
-          else
-          {
-            srchTimer->timeout.time32 = 0;
-          }
-        }
-      }
-      else
-      {
-          // 32-bit math
-        if (srchTimer->timeout.time32 > timeUnion.time32)
-        {
-          srchTimer->timeout.time32 -= timeUnion.time32;
-        }
-        else
-        {
-          srchTimer->timeout.time32 = 0;
-        }
-      }
+    if ( expTimer == NULL )
+    {
+      HAL_EXIT_CRITICAL_SECTION( intState );   // Re-enable interrupts.
+      break;
+    }
 
-      // Check for reloading
-      if ( (srchTimer->timeout.time16[0] == 0) && (srchTimer->timeout.time16[1] == 0) &&
-           (srchTimer->reloadTimeout) && (srchTimer->event_flag) )
-      {
-        // Notify the task of a timeout
-        osal_set_event( srchTimer->task_id, srchTimer->event_flag );
+    if ( expTimer->timeout.time32 > updateTime )
+    {
+      // Nothing else expires in this update
+      expTimer->timeout.time32 -= updateTime;
+      HAL_EXIT_CRITICAL_SECTION( intState );   // Re-enable interrupts.
+      break;
+    }
 
-        // Reload the timer timeout value
-        srchTimer->timeout.time32 = srchTimer->reloadTimeout;
-      }
+    // Take the expired timer off the front; the next delta is
+    // already relative to this expiration.
+    updateTime -= expTimer->timeout.time32;
+    timerHead = expTimer->next;
+    expTimer->next = NULL;
+    osal_timerCount--;
 
-      // When timeout or delete (event_flag == 0)
-      if ( ((srchTimer->timeout.time16[0] == 0) && (srchTimer->timeout.time16[1] == 0)) ||
-            (srchTimer->event_flag == 0) )
+    if ( expTimer->reloadTimeout )
+    {
+      // Reload the timer timeout value. The time left in this update
+      // is added back so the reloaded timer fires at most once per update.
+      if ( expTimer->reloadTimeout > (0xFFFFFFFF - updateTime) )
       {
-        // Take out of list
-        if ( prevTimer == NULL )
-        {
-          timerHead = srchTimer->next;
-        }
-        else
-        {
-          prevTimer->next = srchTimer->next;
-        }
-
-        // Setup to free memory
-        freeTimer = srchTimer;
-
-        // Next
-        srchTimer = srchTimer->next;
+        osalInsertTimer( expTimer, 0xFFFFFFFF );
       }
       else
       {
-        // Get next
-        prevTimer = srchTimer;
-        srchTimer = srchTimer->next;
+        osalInsertTimer( expTimer, expTimer->reloadTimeout + updateTime );
       }
 
+      // Notify the task of a timeout
+      osal_set_event( expTimer->task_id, expTimer->event_flag );
+
+      HAL_EXIT_CRITICAL_SECTION( intState );   // Re-enable interrupts.
+    }
+    else
+    {
       HAL_EXIT_CRITICAL_SECTION( intState );   // Re-enable interrupts.
 
-      if ( freeTimer )
-      {
-        if ( (freeTimer->timeout.time16[0] == 0) && (freeTimer->timeout.time16[1] == 0) )
-        {
-          osal_set_event( freeTimer->task_id, freeTimer->event_flag );
-        }
-        osal_mem_free( freeTimer );
-      }
+      osal_set_event( expTimer->task_id, expTimer->event_flag );
+      osal_mem_free( expTimer );
     }
   }
 }
@@ -552,14 +580,15 @@ void osal_adjust_timers( void )
 }
 #endif /* POWER_SAVING */
 
-#if defined POWER_SAVING || defined USE_ICALL
+#if defined POWER_SAVING || defined USE_ICALL || defined HAL_MCU_POSIX
 /*********************************************************************
  * @fn      osal_next_timeout
  *
  * @brief
  *
- *   Search timer table to return the lowest timeout value. If the
- *   timer list is empty, then the returned timeout will be zero.
+ *   Return the lowest timeout value, which is held by the head of the
+ *   sorted timer list. If the timer list is empty, then the returned
+ *   timeout will be zero.
  *
  * @param   none
  *
@@ -568,23 +597,14 @@ void osal_adjust_timers( void )
 uint32 osal_next_timeout( void )
 {
   uint32 nextTimeout;
-  osalTimerRec_t *srchTimer;
 
   if ( timerHead != NULL )
   {
-    // Head of the timer list
-    srchTimer = timerHead;
-    nextTimeout = OSAL_TIMERS_MAX_TIMEOUT;
+    nextTimeout = timerHead->timeout.time32;
 
-    // Look for the next timeout timer
-    while ( srchTimer != NULL )
+    if ( nextTimeout > OSAL_TIMERS_MAX_TIMEOUT )
     {
-      if (srchTimer->timeout.time32 < nextTimeout)
-      {
-        nextTimeout = srchTimer->timeout.time32;
-      }
-      // Check next timer
-      srchTimer = srchTimer->next;
+      nextTimeout = OSAL_TIMERS_MAX_TIMEOUT;
     }
   }
   else
@@ -67,6 +67,9 @@ extern "C"
  */
 #if ( UINT_MAX == 65535 ) /* 8-bit and 16-bit devices */
   #define osal_offsetof(type, member) ((uint16) &(((type *) 0)->member))
+#elif ( ULONG_MAX > UINT_MAX ) /* 64-bit hosts (POSIX port) */
+  #include <stddef.h>
+  #define osal_offsetof(type, member) ((uint32) offsetof(type, member))
 #else /* 32-bit devices */
   #define osal_offsetof(type, member) ((uint32) &(((type *) 0)->member))
 #endif
@@ -90,6 +93,19 @@ extern "C"
 /*** Interrupts ***/
 #define INTS_ALL    0xFF
 
+/*** Task Profiler ***/
+#if defined ( OSAL_PROFILER )
+  // Number of log2 buckets in each histogram: 0, 1, 2-3, 4-7, ... ticks
+  #if !defined ( OSAL_PROF_BUCKETS )
+    #define OSAL_PROF_BUCKETS    8
+  #endif
+
+  // Number of task runs kept in the profiler ring buffer
+  #if !defined ( OSAL_PROF_RING_SIZE )
+    #define OSAL_PROF_RING_SIZE  16
+  #endif
+#endif
+
 /*********************************************************************
  * TYPEDEFS
  */
@@ -117,6 +133,28 @@ typedef struct
 
 typedef void * osal_msg_q_t;
 
+#if defined ( OSAL_PROFILER )
+// Event latency and execution time histograms of a task, in profiler ticks
+typedef struct
+{
+  uint16 count;                         // task runs
+  uint16 maxLatency;
+  uint16 maxExec;
+  uint16 latency[OSAL_PROF_BUCKETS];    // event set to task run start
+  uint16 exec[OSAL_PROF_BUCKETS];       // task run start to end
+} osalProfHist_t;
+
+// One task run in the profiler ring buffer
+typedef struct
+{
+  uint8  taskId;
+  uint16 timestamp;                     // task run start
+  uint16 events;                        // events processed by the run
+  uint16 latency;                       // of the oldest event processed
+  uint16 exec;
+} osalProfRec_t;
+#endif
+
 #ifdef USE_ICALL
 /* High resolution timer callback function type */
 typedef void (*osal_highres_timer_cback_t)(void *arg);
@@ -218,6 +256,26 @@ extern void (*osal_eventloop_hook)(void);
   extern uint8 osal_clear_event( uint8 task_id, uint16 event_flag );
 
 
+/*** Task Profiler ***/
+
+#if defined ( OSAL_PROFILER )
+  /*
+   * Get the histograms of a task
+   */
+  extern osalProfHist_t *osal_prof_get_hist( uint8 task_id );
+
+  /*
+   * Take the oldest task run out of the ring buffer
+   */
+  extern uint8 osal_prof_ring_read( osalProfRec_t *pRec );
+
+  /*
+   * Clear the histograms and the ring buffer
+   */
+  extern void osal_prof_reset( void );
+#endif
+
+
 /*** Interrupt Management  ***/
 
   /*
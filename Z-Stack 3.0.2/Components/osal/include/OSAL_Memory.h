@@ -58,6 +58,41 @@ extern "C"
   #define OSALMEM_METRICS  FALSE
 #endif
 
+// Serve small allocations from fixed size-class slabs (see OSAL_Memory.c).
+#if !defined ( OSALMEM_SLAB )
+  #define OSALMEM_SLAB  FALSE
+#endif
+
+// Number of slab size classes.
+#define OSALMEM_SLAB_CLASSES  4
+
+// Attribute live heap usage to the allocating call sites (see OSAL_Memory.c).
+#if !defined ( OSALMEM_SITES )
+  #define OSALMEM_SITES  FALSE
+#endif
+
+// Number of call sites tracked. Once full, the last entry collects all new sites.
+#if !defined ( OSALMEM_SITE_MAX )
+  #define OSALMEM_SITE_MAX  16
+#endif
+
+// Source file identifiers reported with each call site. A source file defines
+// OSALMEM_SITE_FILE before its first #include to tell its sites from those of other files.
+#define OSALMEM_FILE_UNKNOWN     0     // Untagged sources and the stack libraries
+#define OSALMEM_FILE_OSAL        1
+#define OSALMEM_FILE_ZCL         2
+#define OSALMEM_FILE_ZCL_GENERAL 3
+#define OSALMEM_FILE_ZDAPP       4
+#define OSALMEM_FILE_ZDOBJECT    5
+#define OSALMEM_FILE_ZDPROFILE   6
+#define OSALMEM_FILE_ZDSECMGR    7
+#define OSALMEM_FILE_BDB         8
+#define OSALMEM_FILE_OVERFLOW    0xFF  // All sites found after the table filled up
+
+#if !defined ( OSALMEM_SITE_FILE )
+  #define OSALMEM_SITE_FILE  OSALMEM_FILE_UNKNOWN
+#endif
+
 /*********************************************************************
  * MACROS
  */
@@ -68,6 +103,19 @@ extern "C"
  * TYPEDEFS
  */
 
+#if ( OSALMEM_SITES )
+// Heap usage of one allocating call site
+typedef struct
+{
+  uint16 line;       // Source line of the call
+  uint8  file;       // OSALMEM_FILE_xxx
+  uint16 liveCnt;    // Blocks now allocated
+  uint16 liveBytes;  // Bytes now allocated, including block overhead
+  uint16 peakBytes;  // Max bytes allocated at once since the last reset
+  uint16 allocCnt;   // Allocations since the last reset, wraps around
+} osalMemSite_t;
+#endif
+
 /*********************************************************************
  * GLOBAL VARIABLES
  */
@@ -89,7 +137,11 @@ extern "C"
  /*
   * Allocate a block of memory.
   */
-#ifdef DPRINTF_OSALHEAPTRACE
+#if ( OSALMEM_SITES )
+  void *osal_mem_alloc( uint16 size );
+  void *osal_mem_alloc_site( uint16 size, uint8 file, uint16 line );
+#define osal_mem_alloc(_size ) osal_mem_alloc_site(_size, OSALMEM_SITE_FILE, __LINE__)
+#elif defined DPRINTF_OSALHEAPTRACE
   void *osal_mem_alloc_dbg( uint16 size, const char *fname, unsigned lnum );
 #define osal_mem_alloc(_size ) osal_mem_alloc_dbg(_size, __FILE__, __LINE__)
 #else /* DPRINTF_OSALHEAPTRACE */
@@ -128,6 +180,45 @@ extern "C"
   uint16 osal_heap_mem_used( void );
 #endif
 
+#if ( OSALMEM_SLAB )
+ /*
+  * Return the data size of the blocks in a slab size class.
+  */
+  uint16 osal_heap_slab_size( uint8 cls );
+
+ /*
+  * Return the current number of blocks allocated from a slab size class.
+  */
+  uint8 osal_heap_slab_cnt( uint8 cls );
+
+ /*
+  * Return the maximum number of blocks ever allocated at once from a slab size class.
+  */
+  uint8 osal_heap_slab_max( uint8 cls );
+
+ /*
+  * Return the number of allocations of a slab size class that fell back to the heap.
+  */
+  uint16 osal_heap_slab_miss( uint8 cls );
+#endif
+
+#if ( OSALMEM_SITES )
+ /*
+  * Return the number of call sites now tracked.
+  */
+  uint8 osal_heap_site_cnt( void );
+
+ /*
+  * Copy out the heap usage of a tracked call site.
+  */
+  uint8 osal_heap_site_get( uint8 idx, osalMemSite_t *pSite );
+
+ /*
+  * Restart the peak and allocation counts of all call sites.
+  */
+  void osal_heap_site_reset( void );
+#endif
+
 #if defined (ZTOOL_P1) || defined (ZTOOL_P2)
  /*
   * Return the highest number of bytes ever used in the heap.
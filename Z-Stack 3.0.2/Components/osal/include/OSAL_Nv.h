@@ -101,6 +101,18 @@ extern uint16 osal_nv_item_len( uint16 id );
  */
 extern uint8 osal_nv_delete( uint16 id, uint16 len );
 
+#if defined ( OSAL_NV_BULK )
+/*
+ * Get the next NV item Id, for walking all of the items.
+ */
+extern uint16 osal_nv_item_next( uint16 id );
+
+/*
+ * Compact all of the NV pages ahead of a bulk write.
+ */
+extern uint8 osal_nv_compact( void );
+#endif // OSAL_NV_BULK
+
 #if defined ( OSAL_NV_EXTENDED )
 /*
  * Initialize an item in NV (extended format)
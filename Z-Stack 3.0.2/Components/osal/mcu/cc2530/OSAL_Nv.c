@@ -90,6 +90,26 @@ static const uint16 hotIds[OSAL_NV_MAX_HOT] = {
   ZCD_NV_NWK_ALTERN_KEY_INFO,
 };
 
+/* Number of item locations kept in the RAM index (5 bytes of RAM each). Items in the index are
+ * found without scanning the NV pages; any others fall back to the page scan. Set to 0 to remove.
+ */
+#if !defined OSAL_NV_INDEX_CNT
+#define OSAL_NV_INDEX_CNT       32
+#endif
+#if (OSAL_NV_INDEX_CNT > 255)
+#error OSAL_NV_INDEX_CNT must fit in a uint8.
+#endif
+
+/* Number of item Ids that osal_nv_item_next() collects per scan of the NV pages (2 bytes of RAM
+ * each), so that walking all of the items scans the pages once per this many items.
+ */
+#if !defined OSAL_NV_NEXT_CNT
+#define OSAL_NV_NEXT_CNT        16
+#endif
+#if (OSAL_NV_NEXT_CNT == 0) || (OSAL_NV_NEXT_CNT > 255)
+#error OSAL_NV_NEXT_CNT must be 1 to 255.
+#endif
+
 /*********************************************************************
  * MACROS
  */
@@ -168,6 +188,14 @@ typedef enum
   eNvZero
 } eNvHdrEnum;
 
+// Location of the active copy of an NV item.
+typedef struct
+{
+  uint16 id;
+  uint16 off;   // Offset into the page of the item data.
+  uint8  pg;
+} osalNvIndex_t;
+
 typedef enum
 {
   ePgActive,
@@ -207,6 +235,24 @@ static uint8 findPg;
 static uint8 hotPg[OSAL_NV_MAX_HOT];
 static uint16 hotOff[OSAL_NV_MAX_HOT];
 
+#if OSAL_NV_INDEX_CNT
+// RAM index of item locations, sorted by item Id.
+static osalNvIndex_t nvIndex[OSAL_NV_INDEX_CNT];
+static uint8 nvIndexCnt;
+#endif
+
+#if defined ( OSAL_NV_BULK )
+// Item Ids found by the last osal_nv_item_next() scan, sorted, and the count of them.
+static uint16 nvNextIds[OSAL_NV_NEXT_CNT];
+static uint8 nvNextCnt;
+// Number of nvNextIds returned so far, 0 when they must not be used.
+static uint8 nvNextIdx;
+
+#define OSAL_NV_NEXT_RESET()  (nvNextIdx = 0)
+#else
+#define OSAL_NV_NEXT_RESET()
+#endif
+
 /*********************************************************************
  * LOCAL FUNCTIONS
  */
@@ -236,6 +282,17 @@ static uint8  writeItem( uint8 pg, uint16 id, uint16 len, void *buf, uint8 flag
 static uint8  hotItem(uint16 id);
 static void   hotItemUpdate(uint8 pg, uint16 off, uint16 id);
 
+#if OSAL_NV_INDEX_CNT
+static uint8  indexFind( uint16 id );
+static void   indexUpdate( uint8 pg, uint16 off, uint16 id );
+static void   indexRemove( uint8 pg, uint16 off, uint16 id );
+static void   indexErasePage( uint8 pg );
+#endif
+
+#if defined ( OSAL_NV_BULK )
+static void   nvNextAdd( uint16 id );
+#endif
+
 /*********************************************************************
  * @fn      initNV
  *
@@ -253,6 +310,9 @@ static uint8 initNV( void )
   uint8 pg;
 
   pgRes = OSAL_NV_PAGE_NULL;
+#if OSAL_NV_INDEX_CNT
+  nvIndexCnt = 0;
+#endif
 
   for ( pg = OSAL_NV_PAGE_BEG; pg <= OSAL_NV_PAGE_END; pg++ )
   {
@@ -472,6 +532,13 @@ static uint16 initPage( uint8 pg, uint16 id, uint8 findDups )
           {
             return OSAL_NV_ERASED_ID;
           }
+
+#if OSAL_NV_INDEX_CNT
+          if ( hdr.stat == OSAL_NV_ERASED_ID )
+          {
+            indexUpdate( pg, offset, hdr.id );
+          }
+#endif
         }
         else
         {
@@ -509,6 +576,10 @@ static void erasePage( uint8 pg )
 
   pgOff[pg - OSAL_NV_PAGE_BEG] = OSAL_NV_PAGE_HDR_SIZE;
   pgLost[pg - OSAL_NV_PAGE_BEG] = 0;
+
+#if OSAL_NV_INDEX_CNT
+  indexErasePage( pg );
+#endif
 }
 
 /*********************************************************************
@@ -663,10 +734,29 @@ static uint16 findItem( uint16 id )
   uint16 off;
   uint8 pg;
 
+#if OSAL_NV_INDEX_CNT
+  if ( (id & OSAL_NV_SOURCE_ID) == 0 )
+  {
+    uint8 idx = indexFind( id );
+
+    if ( (idx < nvIndexCnt) && (nvIndex[idx].id == id) )
+    {
+      findPg = nvIndex[idx].pg;
+      return nvIndex[idx].off;
+    }
+  }
+#endif
+
   for ( pg = OSAL_NV_PAGE_BEG; pg <= OSAL_NV_PAGE_END; pg++ )
   {
     if ( (off = initPage( pg, id, FALSE )) != OSAL_NV_ITEM_NULL )
     {
+#if OSAL_NV_INDEX_CNT
+      if ( (id & OSAL_NV_SOURCE_ID) == 0 )
+      {
+        indexUpdate( pg, off, id );
+      }
+#endif
       findPg = pg;
       return off;
     }
@@ -812,6 +902,10 @@ static void setItem( uint8 pg, uint16 offset, eNvHdrEnum stat )
   {
     uint16 sz = ((hdr.len + (OSAL_NV_WORD_SIZE-1)) / OSAL_NV_WORD_SIZE) * OSAL_NV_WORD_SIZE +
                                                                           OSAL_NV_HDR_SIZE;
+#if OSAL_NV_INDEX_CNT
+    indexRemove( pg, offset + OSAL_NV_HDR_SIZE, hdr.id );
+#endif
+
     hdr.id = 0;
     writeWord( pg, offset, (uint8 *)(&hdr) );
     pgLost[pg-OSAL_NV_PAGE_BEG] += sz;
@@ -1175,6 +1269,8 @@ static uint8 hotItem(uint16 id)
  * @fn      hotItemUpdate
  *
  * @brief   If the parameter 'id' is a hot item, update the corresponding hot item data.
+ *          Every new location of a valid item passes through here, so the RAM index is
+ *          updated as well.
  *
  * @param   pg - The new NV page corresponding to the hot item.
  * @param   off - The new NV page offset corresponding to the hot item.
@@ -1186,6 +1282,10 @@ static void hotItemUpdate(uint8 pg, uint16 off, uint16 id)
 {
   uint8 hotIdx = hotItem(id);
 
+#if OSAL_NV_INDEX_CNT
+  indexUpdate( pg, off, id );
+#endif
+
   if (hotIdx < OSAL_NV_MAX_HOT)
   {
     {
@@ -1195,6 +1295,130 @@ static void hotItemUpdate(uint8 pg, uint16 off, uint16 id)
   }
 }
 
+#if OSAL_NV_INDEX_CNT
+/*********************************************************************
+ * @fn      indexFind
+ *
+ * @brief   Binary search of the RAM index for an item Id.
+ *
+ * @param   id - A valid NV item Id.
+ *
+ * @return  Index of the entry for 'id' if it is present; otherwise the index
+ *          at which it would be inserted.
+ */
+static uint8 indexFind( uint16 id )
+{
+  uint8 low = 0;
+  uint8 high = nvIndexCnt;
+
+  while ( low < high )
+  {
+    uint8 mid = (uint8)(((uint16)low + high) / 2);
+
+    if ( nvIndex[mid].id < id )
+    {
+      low = mid + 1;
+    }
+    else
+    {
+      high = mid;
+    }
+  }
+
+  return low;
+}
+
+/*********************************************************************
+ * @fn      indexUpdate
+ *
+ * @brief   Record the location of the active copy of an item in the RAM index.
+ *          A new item is not recorded when the index is full.
+ *
+ * @param   pg - NV page of the item.
+ * @param   off - NV page offset of the item data.
+ * @param   id - A valid NV item Id.
+ *
+ * @return  none
+ */
+static void indexUpdate( uint8 pg, uint16 off, uint16 id )
+{
+  uint8 idx = indexFind( id );
+
+  if ( (idx >= nvIndexCnt) || (nvIndex[idx].id != id) )
+  {
+    uint8 cnt;
+
+    if ( nvIndexCnt >= OSAL_NV_INDEX_CNT )
+    {
+      return;
+    }
+
+    for ( cnt = nvIndexCnt; cnt > idx; cnt-- )
+    {
+      nvIndex[cnt] = nvIndex[cnt-1];
+    }
+
+    nvIndex[idx].id = id;
+    nvIndexCnt++;
+  }
+
+  nvIndex[idx].pg = pg;
+  nvIndex[idx].off = off;
+}
+
+/*********************************************************************
+ * @fn      indexRemove
+ *
+ * @brief   Remove an item from the RAM index if the index holds the given location for it.
+ *
+ * @param   pg - NV page of the item being invalidated.
+ * @param   off - NV page offset of the item data being invalidated.
+ * @param   id - NV item Id read from the header being invalidated.
+ *
+ * @return  none
+ */
+static void indexRemove( uint8 pg, uint16 off, uint16 id )
+{
+  uint8 idx = indexFind( id );
+
+  if ( (idx < nvIndexCnt) && (nvIndex[idx].id == id) &&
+       (nvIndex[idx].pg == pg) && (nvIndex[idx].off == off) )
+  {
+    nvIndexCnt--;
+
+    for ( ; idx < nvIndexCnt; idx++ )
+    {
+      nvIndex[idx] = nvIndex[idx+1];
+    }
+  }
+}
+
+/*********************************************************************
+ * @fn      indexErasePage
+ *
+ * @brief   Remove all of the items located on an NV page from the RAM index.
+ *
+ * @param   pg - NV page being erased.
+ *
+ * @return  none
+ */
+static void indexErasePage( uint8 pg )
+{
+  uint8 src;
+  uint8 dst = 0;
+
+  for ( src = 0; src < nvIndexCnt; src++ )
+  {
+    if ( nvIndex[src].pg != pg )
+    {
+      nvIndex[dst++] = nvIndex[src];
+    }
+  }
+
+  nvIndexCnt = dst;
+}
+#endif
+
 /*********************************************************************
  * @fn      osal_nv_init
  *
@@ -1243,6 +1467,7 @@ uint8 osal_nv_item_init( uint16 id, uint16 len, void *buf )
   }
   else if ( initItem( TRUE, id, len, buf ) != OSAL_NV_PAGE_NULL )
   {
+    OSAL_NV_NEXT_RESET();  // A new Id to walk.
     return NV_ITEM_UNINIT;
   }
   else
@@ -1505,9 +1730,175 @@ uint8 osal_nv_delete( uint16 id, uint16 len )
   else
   {
     // Yes, it's gone
+    OSAL_NV_NEXT_RESET();
     return SUCCESS;
   }
 }
 
+#if defined ( OSAL_NV_BULK )
+/*********************************************************************
+ * @fn      nvNextAdd
+ *
+ * @brief   Add an item Id to the sorted Ids of an osal_nv_item_next() scan, keeping the lowest
+ *          OSAL_NV_NEXT_CNT of them. An Id already there, such as an item caught in the middle
+ *          of a write, is not added again.
+ *
+ * @param   id - Item Id found in NV.
+ *
+ * @return  none
+ */
+static void nvNextAdd( uint16 id )
+{
+  uint8 idx = nvNextCnt;
+
+  while ( (idx > 0) && (nvNextIds[idx-1] >= id) )
+  {
+    if ( nvNextIds[idx-1] == id )
+    {
+      return;
+    }
+    idx--;
+  }
+
+  if ( idx < OSAL_NV_NEXT_CNT )
+  {
+    uint8 cnt = nvNextCnt;
+
+    if ( cnt == OSAL_NV_NEXT_CNT )
+    {
+      cnt--;  // The highest Id drops out.
+    }
+    else
+    {
+      nvNextCnt++;
+    }
+
+    for ( ; cnt > idx; cnt-- )
+    {
+      nvNextIds[cnt] = nvNextIds[cnt-1];
+    }
+
+    nvNextIds[idx] = id;
+  }
+}
+
+/*********************************************************************
+ * @fn      osal_nv_item_next
+ *
+ * @brief   Find the next item for walking all of the NV items in item Id order.
+ *          An item caught in the middle of a write is found by its old copy.
+ *          Each scan of the NV pages collects the next OSAL_NV_NEXT_CNT Ids, so a walk that
+ *          passes back the Id last returned is served from RAM until they run out. Creating or
+ *          deleting an item starts a new scan.
+ *
+ * @param   id - Item Id to start after; zero to find the first item.
+ *
+ * @return  The lowest item Id in NV that is greater than 'id'; zero if there is none.
+ */
+uint16 osal_nv_item_next( uint16 id )
+{
+  uint8 pg;
+
+  if ( (nvNextIdx != 0) && (nvNextIds[nvNextIdx-1] == id) )
+  {
+    if ( nvNextIdx < nvNextCnt )
+    {
+      return nvNextIds[nvNextIdx++];
+    }
+    else if ( nvNextCnt < OSAL_NV_NEXT_CNT )
+    {
+      return OSAL_NV_ITEM_NULL;  // The last scan found every Id after the first one.
+    }
+  }
+
+  nvNextCnt = 0;
+
+  for ( pg = OSAL_NV_PAGE_BEG; pg <= OSAL_NV_PAGE_END; pg++ )
+  {
+    uint16 offset = OSAL_NV_PAGE_HDR_SIZE;
+    uint16 sz;
+    osalNvHdr_t hdr;
+
+    while ( offset < (OSAL_NV_PAGE_SIZE - OSAL_NV_HDR_SIZE) )
+    {
+      HalFlashRead(pg, offset, (uint8 *)(&hdr), OSAL_NV_HDR_SIZE);
+
+      if ( hdr.id == OSAL_NV_ERASED_ID )
+      {
+        break;
+      }
+
+      sz = OSAL_NV_DATA_SIZE( hdr.len );
+
+      if ( sz > (OSAL_NV_PAGE_SIZE - OSAL_NV_HDR_SIZE - offset) )
+      {
+        break;
+      }
+
+      if ( (hdr.id != OSAL_NV_ZEROED_ID) && (hdr.id > id) )
+      {
+        nvNextAdd( hdr.id );
+      }
+
+      offset += (OSAL_NV_HDR_SIZE + sz);
+    }
+  }
+
+  if ( nvNextCnt == 0 )
+  {
+    nvNextIdx = 0;
+    return OSAL_NV_ITEM_NULL;
+  }
+
+  nvNextIdx = 1;
+  return nvNextIds[0];
+}
+
+/*********************************************************************
+ * @fn      osal_nv_compact
+ *
+ * @brief   Compact every NV page that holds any lost bytes, so that a series of item writes
+ *          that follows can append to the pages without compacting them one at a time.
+ *
+ * @param   none
+ *
+ * @return  SUCCESS if all of the pages were compacted, NV_OPER_FAILED otherwise.
+ */
+uint8 osal_nv_compact( void )
+{
+  uint8 rtrn = SUCCESS;
+  uint8 pg;
+
+  if ( !OSAL_NV_CHECK_BUS_VOLTAGE )
+  {
+    return NV_OPER_FAILED;
+  }
+
+  for ( pg = OSAL_NV_PAGE_BEG; pg <= OSAL_NV_PAGE_END; pg++ )
+  {
+    if ( (pg != pgRes) && (pgLost[pg - OSAL_NV_PAGE_BEG] != 0) )
+    {
+      osalNvPgHdr_t pgHdr;
+
+      HalFlashRead(pg, OSAL_NV_PAGE_HDR_OFFSET, (uint8 *)(&pgHdr), OSAL_NV_PAGE_HDR_SIZE);
+      if ( pgHdr.xfer == OSAL_NV_ERASED_ID )
+      {
+        // Mark the old page as being in process of compaction.
+        uint16 tmp = OSAL_NV_ZEROED_ID;
+        writeWordH( pg, OSAL_NV_PG_XFER, (uint8*)(&tmp) );
+      }
+
+      // On success the compacted page becomes the new reserve page.
+      if ( !compactPage( pg, OSAL_NV_ITEM_NULL ) )
+      {
+        rtrn = NV_OPER_FAILED;
+      }
+    }
+  }
+
+  return rtrn;
+}
+#endif // OSAL_NV_BULK
+
 /*********************************************************************
  */
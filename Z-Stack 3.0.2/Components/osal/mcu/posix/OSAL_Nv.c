@@ -0,0 +1,537 @@
+/**************************************************************************************************
+  Filename:       OSAL_Nv.c
+  Revised:        $Date$
+  Revision:       $Revision$
+
+  Description:    This module contains the OSAL non-volatile memory functions
+                  for the host (POSIX) process, kept in a file.
+
+
+  Copyright 2026 Texas Instruments Incorporated. All rights reserved.
+
+  IMPORTANT: Your use of this Software is limited to those specific rights
+  granted under the terms of a software license agreement between the user
+  who downloaded the software, his/her employer (which must be your employer)
+  and Texas Instruments Incorporated (the "License").  You may not use this
+  Software unless you agree to abide by the terms of the License. The License
+  limits your use, and you acknowledge, that the Software may not be modified,
+  copied or distributed unless embedded on a Texas Instruments microcontroller
+  or used solely and exclusively in conjunction with a Texas Instruments radio
+  frequency transceiver, which is integrated into your product.  Other than for
+  the foregoing purpose, you may not use, reproduce, copy, prepare derivative
+  works of, modify, distribute, perform, display or sell this Software and/or
+  its documentation for any purpose.
+
+  YOU FURTHER ACKNOWLEDGE AND AGREE THAT THE SOFTWARE AND DOCUMENTATION ARE
+  PROVIDED AS IS WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+  INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF MERCHANTABILITY, TITLE,
+  NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT SHALL
+  TEXAS INSTRUMENTS OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER CONTRACT,
+  NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR OTHER
+  LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+  INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE
+  OR CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT
+  OF SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+  (INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+
+  Should you have any questions regarding your right to use this Software,
+  contact Texas Instruments Incorporated at www.TI.com.
+**************************************************************************************************/
+
+/*********************************************************************
+ * INCLUDES
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ZComDef.h"
+#include "hal_board_cfg.h"
+#include "OSAL.h"
+#include "OSAL_Nv.h"
+
+/*********************************************************************
+ * CONSTANTS
+ */
+
+// File layout: the magic, then for each item in Id order a little-endian Id and length followed
+// by the item data.
+#define OSAL_NV_FILE_MAGIC      "ZNV1"
+#define OSAL_NV_FILE_MAGIC_LEN  4
+#define OSAL_NV_FILE_HDR_SIZE   4
+
+#define OSAL_NV_ITEM_NULL       0
+
+// Uninitialized item data reads back as erased flash.
+#define OSAL_NV_ERASED          0xFF
+
+#define OSAL_NV_TMP_SUFFIX      ".tmp"
+
+/*********************************************************************
+ * TYPEDEFS
+ */
+
+typedef struct
+{
+  uint16 id;
+  uint16 len;
+  uint8 *buf;
+} osalNvItem_t;
+
+/*********************************************************************
+ * LOCAL VARIABLES
+ */
+
+// The items live in host memory, outside of the OSAL heap, sorted by Id.
+static osalNvItem_t *nvItems;
+static uint16 nvCnt;
+static uint16 nvMax;
+
+static const char *nvFile;
+
+/*********************************************************************
+ * LOCAL FUNCTIONS
+ */
+
+static uint16 findItem( uint16 id, uint8 *found );
+static osalNvItem_t *newItem( uint16 id, uint16 len );
+static void removeItem( uint16 idx );
+static uint8 saveNV( void );
+static void loadNV( void );
+
+/*********************************************************************
+ * @fn      findItem
+ *
+ * @brief   Binary search of the item table.
+ *
+ * @param   id - Valid NV item Id.
+ * @param   found - Set to TRUE if the item exists.
+ *
+ * @return  Index of the item if found, otherwise the index to insert it at.
+ */
+static uint16 findItem( uint16 id, uint8 *found )
+{
+  uint16 lo = 0;
+  uint16 hi = nvCnt;
+
+  while ( lo < hi )
+  {
+    uint16 mid = lo + (hi - lo) / 2;
+
+    if ( nvItems[mid].id < id )
+    {
+      lo = mid + 1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+
+  *found = ( (lo < nvCnt) && (nvItems[lo].id == id) );
+
+  return lo;
+}
+
+/*********************************************************************
+ * @fn      newItem
+ *
+ * @brief   Insert a new, erased item into the item table.
+ *
+ * @param   id  - Valid NV item Id that does not exist yet.
+ * @param   len - Item length.
+ *
+ * @return  Pointer to the new item, NULL if out of memory.
+ */
+static osalNvItem_t *newItem( uint16 id, uint16 len )
+{
+  uint8 found;
+  uint16 idx = findItem( id, &found );
+  uint8 *buf;
+
+  if ( nvCnt == nvMax )
+  {
+    uint16 max = (nvMax == 0) ? 64 : (nvMax * 2);
+    osalNvItem_t *items = (max > nvMax) ? realloc( nvItems, max * sizeof(osalNvItem_t) ) : NULL;
+
+    if ( items == NULL )
+    {
+      return NULL;
+    }
+    nvItems = items;
+    nvMax = max;
+  }
+
+  if ( (buf = malloc( (len == 0) ? 1 : len )) == NULL )
+  {
+    return NULL;
+  }
+  memset( buf, OSAL_NV_ERASED, len );
+
+  memmove( &nvItems[idx+1], &nvItems[idx], (nvCnt - idx) * sizeof(osalNvItem_t) );
+  nvCnt++;
+
+  nvItems[idx].id = id;
+  nvItems[idx].len = len;
+  nvItems[idx].buf = buf;
+
+  return &nvItems[idx];
+}
+
+/*********************************************************************
+ * @fn      removeItem
+ *
+ * @brief   Remove an item from the item table.
+ *
+ * @param   idx - Index of an existing item.
+ *
+ * @return  none
+ */
+static void removeItem( uint16 idx )
+{
+  free( nvItems[idx].buf );
+  nvCnt--;
+  memmove( &nvItems[idx], &nvItems[idx+1], (nvCnt - idx) * sizeof(osalNvItem_t) );
+}
+
+/*********************************************************************
+ * @fn      saveNV
+ *
+ * @brief   Write the whole item table to a temporary file and rename it over the NV file, so
+ *          that the NV file always holds either the old or the new contents if the process is
+ *          killed part way.
+ *
+ * @param   none
+ *
+ * @return  TRUE if the NV file was replaced.
+ */
+static uint8 saveNV( void )
+{
+  char tmpName[256];
+  uint8 hdr[OSAL_NV_FILE_HDR_SIZE];
+  uint8 rtrn = TRUE;
+  uint16 idx;
+  FILE *fp;
+
+  (void)snprintf( tmpName, sizeof(tmpName), "%s" OSAL_NV_TMP_SUFFIX, nvFile );
+  if ( (fp = fopen( tmpName, "wb" )) == NULL )
+  {
+    return FALSE;
+  }
+
+  if ( fwrite( OSAL_NV_FILE_MAGIC, 1, OSAL_NV_FILE_MAGIC_LEN, fp ) != OSAL_NV_FILE_MAGIC_LEN )
+  {
+    rtrn = FALSE;
+  }
+
+  for ( idx = 0; (idx < nvCnt) && rtrn; idx++ )
+  {
+    hdr[0] = LO_UINT16( nvItems[idx].id );
+    hdr[1] = HI_UINT16( nvItems[idx].id );
+    hdr[2] = LO_UINT16( nvItems[idx].len );
+    hdr[3] = HI_UINT16( nvItems[idx].len );
+
+    if ( (fwrite( hdr, 1, OSAL_NV_FILE_HDR_SIZE, fp ) != OSAL_NV_FILE_HDR_SIZE) ||
+         (fwrite( nvItems[idx].buf, 1, nvItems[idx].len, fp ) != nvItems[idx].len) )
+    {
+      rtrn = FALSE;
+    }
+  }
+
+  if ( (fclose( fp ) != 0) || !rtrn || (rename( tmpName, nvFile ) != 0) )
+  {
+    (void)remove( tmpName );
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/*********************************************************************
+ * @fn      loadNV
+ *
+ * @brief   Read the item table from the NV file. A missing file is a blank NV; a truncated
+ *          file keeps the items read up to the damage.
+ *
+ * @param   none
+ *
+ * @return  none
+ */
+static void loadNV( void )
+{
+  uint8 hdr[OSAL_NV_FILE_HDR_SIZE];
+  FILE *fp;
+
+  if ( (fp = fopen( nvFile, "rb" )) == NULL )
+  {
+    return;
+  }
+
+  if ( (fread( hdr, 1, OSAL_NV_FILE_MAGIC_LEN, fp ) == OSAL_NV_FILE_MAGIC_LEN) &&
+       (memcmp( hdr, OSAL_NV_FILE_MAGIC, OSAL_NV_FILE_MAGIC_LEN ) == 0) )
+  {
+    while ( fread( hdr, 1, OSAL_NV_FILE_HDR_SIZE, fp ) == OSAL_NV_FILE_HDR_SIZE )
+    {
+      uint16 id = BUILD_UINT16( hdr[0], hdr[1] );
+      uint16 len = BUILD_UINT16( hdr[2], hdr[3] );
+      osalNvItem_t *item;
+      uint8 found;
+
+      (void)findItem( id, &found );
+      if ( (id == OSAL_NV_ITEM_NULL) || found || ((item = newItem( id, len )) == NULL) )
+      {
+        break;
+      }
+
+      if ( fread( item->buf, 1, len, fp ) != len )
+      {
+        removeItem( findItem( id, &found ) );
+        break;
+      }
+    }
+  }
+
+  (void)fclose( fp );
+}
+
+/*********************************************************************
+ * @fn      osal_nv_init
+ *
+ * @brief   Initialize NV service.
+ *
+ * @param   p - Not used.
+ *
+ * @return  none
+ */
+void osal_nv_init( void *p )
+{
+  uint16 idx;
+
+  (void)p;  // Suppress Lint warning.
+
+  for ( idx = 0; idx < nvCnt; idx++ )
+  {
+    free( nvItems[idx].buf );
+  }
+  nvCnt = 0;
+
+  if ( (nvFile = getenv( "OSAL_NV_FILE" )) == NULL )
+  {
+    nvFile = HAL_NV_FILE;
+  }
+
+  loadNV();
+}
+
+/*********************************************************************
+ * @fn      osal_nv_item_init
+ *
+ * @brief   If the NV item does not already exist, it is created and
+ *          initialized with the data passed to the function, if any.
+ *          This function must be called before calling osal_nv_read() or
+ *          osal_nv_write().
+ *
+ * @param   id  - Valid NV item Id.
+ * @param   len - Item length.
+ * @param  *buf - Pointer to item initalization data. Set to NULL if none.
+ *
+ * @return  NV_ITEM_UNINIT - Id did not exist and was created successfully.
+ *          SUCCESS        - Id already existed, no action taken.
+ *          NV_OPER_FAILED - Failure to find or create Id.
+ */
+uint8 osal_nv_item_init( uint16 id, uint16 len, void *buf )
+{
+  osalNvItem_t *item;
+  uint8 found;
+
+  (void)findItem( id, &found );
+  if ( found )
+  {
+    return SUCCESS;
+  }
+  else if ( (id == OSAL_NV_ITEM_NULL) || ((item = newItem( id, len )) == NULL) )
+  {
+    return NV_OPER_FAILED;
+  }
+
+  if ( buf != NULL )
+  {
+    memcpy( item->buf, buf, len );
+  }
+
+  return ( saveNV() ? NV_ITEM_UNINIT : NV_OPER_FAILED );
+}
+
+/*********************************************************************
+ * @fn      osal_nv_item_len
+ *
+ * @brief   Get the data length of the item stored in NV memory.
+ *
+ * @param   id  - Valid NV item Id.
+ *
+ * @return  Item length, if found; zero otherwise.
+ */
+uint16 osal_nv_item_len( uint16 id )
+{
+  uint8 found;
+  uint16 idx = findItem( id, &found );
+
+  return ( found ? nvItems[idx].len : 0 );
+}
+
+/*********************************************************************
+ * @fn      osal_nv_write
+ *
+ * @brief   Write a data item to NV. Function can write an entire item to NV or
+ *          an element of an item by indexing into the item with an offset.
+ *
+ * @param   id  - Valid NV item Id.
+ * @param   ndx - Index offset into item
+ * @param   len - Length of data to write.
+ * @param  *buf - Data to write.
+ *
+ * @return  SUCCESS if successful, NV_ITEM_UNINIT if item did not
+ *          exist in NV and offset is non-zero, NV_OPER_FAILED if failure.
+ */
+uint8 osal_nv_write( uint16 id, uint16 ndx, uint16 len, void *buf )
+{
+  osalNvItem_t *item;
+  uint8 found;
+  uint16 idx;
+
+  if ( len == 0 )
+  {
+    return SUCCESS;
+  }
+
+  idx = findItem( id, &found );
+  if ( !found )
+  {
+    return NV_ITEM_UNINIT;
+  }
+
+  item = &nvItems[idx];
+  if ( item->len < ((uint32)ndx + len) )
+  {
+    return NV_OPER_FAILED;
+  }
+
+  // As on flash, re-writing identical data does not touch the media.
+  if ( memcmp( item->buf + ndx, buf, len ) == 0 )
+  {
+    return SUCCESS;
+  }
+
+  memcpy( item->buf + ndx, buf, len );
+
+  return ( saveNV() ? SUCCESS : NV_OPER_FAILED );
+}
+
+/*********************************************************************
+ * @fn      osal_nv_read
+ *
+ * @brief   Read data from NV. This function can be used to read an entire item from NV or
+ *          an element of an item by indexing into the item with an offset.
+ *          Read data is copied into *buf.
+ *
+ * @param   id  - Valid NV item Id.
+ * @param   ndx - Index offset into item
+ * @param   len - Length of data to read.
+ * @param  *buf - Data is read into this buffer.
+ *
+ * @return  SUCCESS if NV data was copied to the parameter 'buf'.
+ *          Otherwise, NV_OPER_FAILED for failure.
+ */
+uint8 osal_nv_read( uint16 id, uint16 ndx, uint16 len, void *buf )
+{
+  uint8 found;
+  uint16 idx = findItem( id, &found );
+
+  // Unlike flash there is nothing past the end of an item, so an overrun is a failure.
+  if ( !found || (nvItems[idx].len < ((uint32)ndx + len)) )
+  {
+    return NV_OPER_FAILED;
+  }
+
+  memcpy( buf, nvItems[idx].buf + ndx, len );
+
+  return SUCCESS;
+}
+
+/*********************************************************************
+ * @fn      osal_nv_delete
+ *
+ * @brief   Delete item from NV. This function will fail if the length
+ *          parameter does not match the length of the item in NV.
+ *
+ * @param   id  - Valid NV item Id.
+ * @param   len - Length of item to delete.
+ *
+ * @return  SUCCESS if item was deleted,
+ *          NV_ITEM_UNINIT if item did not exist in NV,
+ *          NV_BAD_ITEM_LEN if length parameter not correct,
+ *          NV_OPER_FAILED if attempted deletion failed.
+ */
+uint8 osal_nv_delete( uint16 id, uint16 len )
+{
+  uint8 found;
+  uint16 idx = findItem( id, &found );
+
+  if ( !found )
+  {
+    // NV item does not exist
+    return NV_ITEM_UNINIT;
+  }
+
+  if ( nvItems[idx].len != len )
+  {
+    // NV item has different length
+    return NV_BAD_ITEM_LEN;
+  }
+
+  removeItem( idx );
+
+  return ( saveNV() ? SUCCESS : NV_OPER_FAILED );
+}
+
+#if defined ( OSAL_NV_BULK )
+/*********************************************************************
+ * @fn      osal_nv_item_next
+ *
+ * @brief   Find the next item for walking all of the NV items in item Id order.
+ *
+ * @param   id - Item Id to start after; zero to find the first item.
+ *
+ * @return  The lowest item Id in NV that is greater than 'id'; zero if there is none.
+ */
+uint16 osal_nv_item_next( uint16 id )
+{
+  uint8 found;
+  uint16 idx = findItem( id, &found );
+
+  if ( found )
+  {
+    idx++;
+  }
+
+  return ( (idx < nvCnt) ? nvItems[idx].id : OSAL_NV_ITEM_NULL );
+}
+
+/*********************************************************************
+ * @fn      osal_nv_compact
+ *
+ * @brief   The NV file never holds stale copies of an item, so there is nothing to compact.
+ *
+ * @param   none
+ *
+ * @return  SUCCESS
+ */
+uint8 osal_nv_compact( void )
+{
+  return SUCCESS;
+}
+#endif // OSAL_NV_BULK
+
+/*********************************************************************
+*********************************************************************/
@@ -41,6 +41,9 @@
  * INCLUDES
  */
 
+// Call site file id for heap usage attribution (OSALMEM_SITES)
+#define OSALMEM_SITE_FILE  OSALMEM_FILE_BDB
+
 #include "bdb.h"
 #include "ZDApp.h"
 #include "OSAL.h"
@@ -60,7 +63,7 @@
 #if !defined (DISABLE_GREENPOWER_BASIC_PROXY) && (ZG_BUILD_RTR_TYPE)
 #include "gp_interface.h"
 #include "gp_common.h"
-#include "dgp_stub.h"
+#include "dGP_stub.h"
 #endif
 
 #include "bdb_interface.h"
@@ -406,6 +409,7 @@ ZStatus_t bdb_setActiveCentralizedLinkKey(uint8 zstack_CentralizedLinkKeyModes,
     case zstack_UseAPSKey:
       //Set the key as global default
       Status = APSME_AddTCLinkKey(pKey,extAddr);
+      ZDSecMgrTCLKIndexReload();
     break;
     
     default:
@@ -434,6 +438,7 @@ ZStatus_t bdb_addInstallCode(uint8* pInstallCode, uint8* pExt)
 {
   uint8  hashOutput[16];
   uint16 CRC;
+  ZStatus_t status;
   
 #if (ZG_BUILD_COORDINATOR_TYPE)
   if(ZG_DEVICE_COORDINATOR_TYPE)
@@ -460,7 +465,10 @@ ZStatus_t bdb_addInstallCode(uint8* pInstallCode, uint8* pExt)
 
   sspMMOHash (NULL, 0, pInstallCode,(INSTALL_CODE_LEN + INSTALL_CODE_CRC_LEN) * BITS_PER_BYTE, hashOutput);
 
-  return APSME_AddTCLinkKey(hashOutput,pExt);
+  status = APSME_AddTCLinkKey(hashOutput,pExt);
+  ZDSecMgrTCLKIndexReload();
+
+  return status;
 }    
     
 
@@ -644,7 +652,7 @@ void bdb_TCProcessJoiningList(void)
         ZDSecMgrAddrClear(tempJoiningDescNode->bdbJoiningNodeEui64);
         
         //search for the entry in the TCLK table
-        keyNvIndex = APSME_SearchTCLinkKeyEntry(tempJoiningDescNode->bdbJoiningNodeEui64,&found, NULL);
+        keyNvIndex = ZDSecMgrSearchTCLinkKeyEntry(tempJoiningDescNode->bdbJoiningNodeEui64,&found, NULL);
         
         //If found, erase it.
         if(found == TRUE)
@@ -660,6 +668,7 @@ void bdb_TCProcessJoiningList(void)
           
           //Update the entry
           osal_nv_write(keyNvIndex,0,sizeof(APSME_TCLKDevEntry_t), &TCLKDevEntry );
+          ZDSecMgrTCLKIndexSet( keyNvIndex, &TCLKDevEntry );
         }
         
         if(pfnTCLinkKeyExchangeProcessCB)
@@ -918,6 +927,7 @@ void bdb_StartCommissioning(uint8 mode)
               osal_memset(&APSME_TCLKDevEntry,0,sizeof(APSME_TCLKDevEntry_t));
               APSME_TCLKDevEntry.keyAttributes = ZG_DEFAULT_KEY;
               osal_nv_write(ZCD_NV_TCLK_TABLE_START, 0, sizeof(APSME_TCLKDevEntry_t), &APSME_TCLKDevEntry);
+              ZDSecMgrTCLKIndexSet( ZCD_NV_TCLK_TABLE_START, &APSME_TCLKDevEntry );
               TCLinkKeyFrmCntr[0].txFrmCntr = 0;
               TCLinkKeyFrmCntr[0].rxFrmCntr = 0;
               
@@ -2827,6 +2837,7 @@ void bdb_ProcessNodeDescRsp(zdoIncomingMsg_t *pMsg)
           //Save the KeyAttribute for joining device that it has joined non-R21 nwk
           TCLKDevEntry.keyAttributes = ZG_NON_R21_NWK_JOINED;
           osal_nv_write(ZCD_NV_TCLK_TABLE_START,osal_offsetof(APSME_TCLKDevEntry_t,keyAttributes),sizeof(uint8),&TCLKDevEntry.keyAttributes);
+          ZDSecMgrTCLKIndexSet( ZCD_NV_TCLK_TABLE_START, NULL );
           
           bdb_setNodeJoinLinkKeyType(BDB_DEFAULT_GLOBAL_TRUST_CENTER_LINK_KEY);
           bdb_reportCommissioningState(BDB_COMMISSIONING_STATE_TC_LINK_KEY_EXCHANGE, TRUE);
@@ -661,6 +661,12 @@ uint8 bdb_zclFindingBindingEpType( endPointDesc_t *epDesc )
   type1ClusterCnt = sizeof( bdb_ZclType1Clusters )/sizeof( uint16 );
   type2ClusterCnt = sizeof( bdb_ZclType2Clusters )/sizeof( uint16 );
   
+  // The ZDO endpoint has no simple descriptor
+  if ( epDesc->simpleDesc == NULL )
+  {
+    return epType;
+  }
+
 
   // Are there matching type 1 on server side?
   status = ZDO_AnyClusterMatches( epDesc->simpleDesc->AppNumInClusters, 
@@ -64,7 +64,10 @@
  * CONSTANTS
  */
 #define BDBREPORTING_HASBINDING_FLAG_MASK      0x01
-#define BDBREPORTING_NONEXTINCREMENT_FLAG_MASK 0x02
+#define BDBREPORTING_CHANGEPENDING_FLAG_MASK   0x02
+
+// Largest fixed size attribute value serialized from a local copy
+#define BDBREPORTING_MAX_ATTR_SIZE 8
 
    
 #if BDBREPORTING_MAX_ANALOG_ATTR_SIZE == 8   
@@ -134,7 +137,9 @@ typedef struct
   uint16  cluster;          // to send or receive reports of the attribute
   uint16  consolidatedMinReportInt;             // attribute ID
   uint16  consolidatedMaxReportInt;           // attribute data type
-  uint16  timeSinceLastReport;
+  uint32  lastReportTime;      // system clock (ms) of the last report
+  uint32  nextReportTime;      // system clock (ms) the entry is due, if scheduled
+  uint8   heapPos;             // position in the report deadline heap
   bdbAttrLinkedListAttr_t attrLinkedList;
 } bdbReportAttrClusterEndpoint_t;   
 
@@ -199,11 +204,11 @@ uint8 gAttrDataValue[BDBREPORTING_MAX_ANALOG_ATTR_SIZE];
 bdbReportAttrClusterEndpoint_t bdb_reportingClusterEndpointArray[BDB_MAX_CLUSTERENDPOINTS_REPORTING];
 //Current size of the cluster-endpoint table  
 uint8 bdb_reportingClusterEndpointArrayCount;
-//This variable has the timeout value of the currrent timer use to report peridically
-uint16 bdb_reportingNextEventTimeout;
-//This variable hasthe index of the cluster-endpoint entry that trigger the current
-//timer use to report periodically 
-uint8 bdb_reportingNextClusterEndpointIndex;
+//Min-heap of cluster-endpoint entry indexes ordered by nextReportTime, the
+//reporting timer is always armed for the entry at the top
+static uint8 bdb_reportingHeap[BDB_MAX_CLUSTERENDPOINTS_REPORTING];
+//Number of scheduled entries in the heap
+static uint8 bdb_reportingHeapCount;
 //This is the table that holds in the memory the attribute reporting configurations (dynamic table)
 bdbReportAttrCfgData_t* bdb_reportingAttrCfgRecordsArray;
 //Current size of the attribute reporting configurations table
@@ -232,21 +237,28 @@ static bdbLinkedListAttrItem_t* bdb_linkedListAttrSearch( bdbAttrLinkedListAttr_
 static bdbReportAttrLive_t* bdb_linkedListAttrRemove( bdbAttrLinkedListAttr_t *list );
 static uint8 bdb_linkedListAttrFreeAll( bdbAttrLinkedListAttr_t *list );
 static void bdb_linkedListAttrClearList( bdbAttrLinkedListAttr_t *list );
-static bdbLinkedListAttrItem_t* bdb_linkedListAttrGetAtIndex( bdbAttrLinkedListAttr_t *list, uint8 index );
 //End: Single Linked List methods
 
 //Begin: Cluster-endpoint array live methods
 static void bdb_clusterEndpointArrayInit( void );
-static uint8 bdb_clusterEndpointArrayAdd( uint8 endpoint, uint16 cluster, uint16 consolidatedMinReportInt, uint16 consolidatedMaxReportInt, uint16 timeSinceLastReport );
-static uint8 bdb_clusterEndpointArrayGetMin( void );
+static uint8 bdb_clusterEndpointArrayAdd( uint8 endpoint, uint16 cluster, uint16 consolidatedMinReportInt, uint16 consolidatedMaxReportInt );
 static void bdb_clusterEndpointArrayMoveTo( uint8 indexSrc, uint8 indexDest );
-static uint8 bdb_clusterEndpointArrayUpdateAt( uint8 index, uint16 newTimeSinceLastReport, uint8 markHasBinding, uint8 noNextIncrement );
+static uint8 bdb_clusterEndpointArrayUpdateAt( uint8 index, uint8 markHasBinding );
 static void bdb_clusterEndpointArrayFreeAll( void );
 static uint8 bdb_clusterEndpointArraySearch( uint8 endpoint, uint16 cluster );
 static uint8 bdb_clusterEndpointArrayRemoveAt( uint8 index );
-static void bdb_clusterEndpointArrayIncrementAll( uint16 timeSinceLastReportIncrement, uint8 CheckNoIncrementFlag );
 //End: Cluster-endpoint array live methods
 
+//Begin: Report deadline heap methods
+static uint8 bdb_repHeapLess( uint8 a, uint8 b );
+static void bdb_repHeapSwap( uint8 posA, uint8 posB );
+static void bdb_repHeapSiftUp( uint8 pos );
+static void bdb_repHeapSiftDown( uint8 pos );
+static uint8 bdb_repHeapSchedule( uint8 index );
+static void bdb_repHeapUpdate( uint8 index );
+static void bdb_repHeapBuild( void );
+//End: Report deadline heap methods
+
 //Begin: Single linked list default attr cfg records methods
 static void bdb_repAttrDefaultCfgRecordInitValues( bdbReportAttrDefaultCfgData_t* item );
 static void bdb_repAttrDefaultCfgRecordsLinkedListInit( bdbRepAttrDefaultCfgRecordLinkedList_t *list );
@@ -276,13 +288,13 @@ static endPointDesc_t* bdb_FindEpDesc( uint8 endPoint );
 static uint8 bdb_RepFindAttrEntry( uint8 endpoint, uint16 cluster, uint16 attrID, zclAttribute_t* attrRes );
 static uint8 bdb_RepLoadCfgRecords( void );
 static uint8 bdb_isAttrValueChangedSurpassDelta( uint8 datatype, uint8* delta, uint8* curValue, uint8* lastValue );
-static uint16 bdb_RepCalculateEventElapsedTime( uint32 remainingTimeoutTimer, uint16 nextEventTimeout );
 static void bdb_RepRestartNextEventTimer( void );
 
 static void bdb_RepStartReporting( void );
 static void bdb_RepStopEventTimer( void );
 static void bdb_RepSetupReporting( void );
 static void bdb_RepReport( uint8 indexClusterEndpoint );
+static uint16 bdb_RepAttrDataLength( uint8 endpoint, uint16 cluster, zclAttrRec_t *attrRec );
 
 extern zclAttrRecsList *zclFindAttrRecsList( uint8 endpoint ); //Definition is located in zcl.h
 
@@ -301,7 +313,6 @@ extern zclAttrRecsList *zclFindAttrRecsList( uint8 endpoint ); //Definition is l
  */
 void bdb_RepInit( void )
 {
-  bdb_reportingNextEventTimeout = 0;
   bdb_reportingAcceptDefaultConfs = BDBREPORTING_TRUE;
   bdb_repAttrCfgRecordsArrayInit( );
   bdb_repAttrDefaultCfgRecordsLinkedListInit( &attrDefaultCfgRecordLinkedList );
@@ -335,16 +346,20 @@ void bdb_RepConstructReportingData( void )
  * @fn          bdb_RepMarkHasBindingInEndpointClusterArray
  *
  * @brief       Marks the binding flag as ON at the entry containig the 
- *              cluster-endpoint pair.
+ *              cluster-endpoint pair and restarts its report interval.
  *
  * @param       endpoint - endpoint id of the entry to locate
  * @param       cluster - cluster id of the entry to locate
+ * @param       unMark - BDBREPORTING_TRUE to clear the binding flag instead
+ * @param       setNoNextIncrementFlag - not used, the interval always
+ *              restarts from the time of the call
  *
  * @return      none
  */
 void bdb_RepMarkHasBindingInEndpointClusterArray( uint8 endpoint, uint16 cluster, uint8 unMark, uint8 setNoNextIncrementFlag )
 {
   uint8 foundIndex;
+  (void)setNoNextIncrementFlag;
   if( bdb_reportingClusterEndpointArrayCount > 0 )
   {
     foundIndex = bdb_clusterEndpointArraySearch( endpoint, cluster );
@@ -352,12 +367,13 @@ void bdb_RepMarkHasBindingInEndpointClusterArray( uint8 endpoint, uint16 cluster
     {
       if( unMark == BDBREPORTING_TRUE )
       {
-        bdb_clusterEndpointArrayUpdateAt( foundIndex, 0, BDBREPORTING_FALSE, setNoNextIncrementFlag );
+        bdb_clusterEndpointArrayUpdateAt( foundIndex, BDBREPORTING_FALSE );
       }
       else
       {
-        bdb_clusterEndpointArrayUpdateAt( foundIndex, 0, BDBREPORTING_TRUE, setNoNextIncrementFlag );
+        bdb_clusterEndpointArrayUpdateAt( foundIndex, BDBREPORTING_TRUE );
       }
+      bdb_repHeapUpdate( foundIndex );
     }
   }
 }
@@ -365,110 +381,58 @@ void bdb_RepMarkHasBindingInEndpointClusterArray( uint8 endpoint, uint16 cluster
  /*********************************************************************
  * @fn          bdb_RepStartReporting
  *
- * @brief       Restarts the periodic reporting timer, if the timer was already
- *              running it stops it and to before starting timer sets some state 
- *              variables.
+ * @brief       Rebuilds the report deadline heap from the cluster-endpoint
+ *              entries and arms the reporting timer for the earliest one.
  *
  * @return      none
  */
 static void bdb_RepStartReporting( void )
 {
-  //Stop if reporting timer is active
-  if( !osal_get_timeoutEx( bdb_TaskID, BDB_REPORT_TIMEOUT ) )
-  {
-    //timerElapsedTime is zero
-    osal_stop_timerEx( bdb_TaskID, BDB_REPORT_TIMEOUT );
-    bdb_reportingNextEventTimeout = 0;
-    bdb_reportingNextClusterEndpointIndex = BDBREPORTING_INVALIDINDEX;
-    //Start Timer
-    bdb_RepRestartNextEventTimer( );
-  }
+  bdb_repHeapBuild( );
+  bdb_RepRestartNextEventTimer( );
 }
 
  /*********************************************************************
  * @fn          bdb_RepStartOrContinueReporting
  *
- * @brief       Restarts the periodic reporting timer, if the timer was already
- *              running it calculates the remaining time of timer before stopping it,
- *              then sustracts this elapsed time from the next event endpoint-cluster 
- *              table.
+ * @brief       Starts the reporting timer, or re-arms it if it was already
+ *              running. Report deadlines are kept as absolute system clock
+ *              values, so no elapsed time has to be carried over.
  *
  * @return      none
  */
 void bdb_RepStartOrContinueReporting( void )
 {
-  //Stop if reporting timer is active
-  uint32 remainingTimeOfEvent = osal_get_timeoutEx( bdb_TaskID, BDB_REPORT_TIMEOUT );
-  if( remainingTimeOfEvent == 0 )
-  {
-    //Timer was not running
-    bdb_RepStartReporting( );
-  }
-  else
-  {
-    uint16 elapsedTime = bdb_RepCalculateEventElapsedTime( remainingTimeOfEvent, bdb_reportingNextEventTimeout );
-    bdb_RepStopEventTimer( );
-    
-    bdb_clusterEndpointArrayIncrementAll( elapsedTime, BDBREPORTING_TRUE );
-    bdb_RepStartReporting( );
-  }
-  
-}
-
- /*********************************************************************
- * @fn          bdb_RepCalculateEventElapsedTime
- *
- * @brief       Calculate the elapsed time of the currently running timer, 
- *              the remaining time is roundup.
- *
- * @param       remainingTimeoutTimer - timeout value from the osal_get_timeoutEx method, 
- *              its in milliseconds units
- * @param       nextEventTimeout - the timeout given to the timer when it started
- *
- * @return      the elapsed time in seconds
- */
-static uint16 bdb_RepCalculateEventElapsedTime( uint32 remainingTimeoutTimer, uint16 nextEventTimeout )
-{
-  uint32 passTimeOfEvent = 0;
-  passTimeOfEvent = nextEventTimeout*1000 >= remainingTimeoutTimer? nextEventTimeout*1000 - remainingTimeoutTimer: 0;
-  uint16 elapsedTime = passTimeOfEvent / 1000;
-  elapsedTime = elapsedTime + ((passTimeOfEvent % 1000) >0 ? 1:0); //roundup
-  return elapsedTime;  
+  bdb_RepStartReporting( );
 }
 
  /*********************************************************************
  * @fn          bdb_RepProcessEvent
  *
  * @brief       Method that process the timer expired event in the reporting 
- *              code, it calculate the next cluster-endpoint entry based 
- *              on the minimum with consolidatedMaxReportInt - timeSinceLastReport,
- *              updates timeSinceLastReport of all entries. If the minimum is zero,
- *              report the cluster-endpoint attrs.
+ *              code. Reports every cluster-endpoint entry whose deadline
+ *              (max interval, or min interval for a pending change) has
+ *              passed, then re-arms the timer for the next deadline.
  *
  * @return      none
  */
 void bdb_RepProcessEvent( void )
 {
-  bdb_clusterEndpointArrayIncrementAll( bdb_reportingNextEventTimeout, BDBREPORTING_FALSE );
-  uint8 minIndex =  bdb_clusterEndpointArrayGetMin( );
-  if( minIndex == BDBREPORTING_INVALIDINDEX )
+  uint32 now = osal_GetSystemClock( );
+  uint8 index;
+
+  while( bdb_reportingHeapCount > 0 )
   {
-    return;
+    index = bdb_reportingHeap[0];
+    if( (int32)( bdb_reportingClusterEndpointArray[index].nextReportTime - now ) > 0 )
+    {
+      break;
+    }
+    bdb_RepReport( index );
+    bdb_clusterEndpointArrayUpdateAt( index, BDBREPORTING_IGNORE );
+    bdb_repHeapUpdate( index );
   }
-   uint16 minVal = bdb_reportingClusterEndpointArray[minIndex].consolidatedMaxReportInt - bdb_reportingClusterEndpointArray[minIndex].timeSinceLastReport;
-   if( minVal>0 )
-   { 
-     bdb_reportingNextEventTimeout = minVal;
-   }
-   else
-   {
-     //Something was triggered, report clusterEndpoint with minIndex 
-     bdb_reportingNextClusterEndpointIndex = minIndex;
-     bdb_RepReport( BDBREPORTING_INVALIDINDEX );
-     bdb_clusterEndpointArrayUpdateAt( minIndex, 0, BDBREPORTING_IGNORE, BDBREPORTING_IGNORE );
-     bdb_reportingNextEventTimeout = 0;  
-   }
-   bdb_RepRestartNextEventTimer( );
+  bdb_RepRestartNextEventTimer( );
 }
 
 /*********************************************************************
@@ -762,7 +726,6 @@ uint8 bdb_ProcessInReadReportCfgCmd( zclIncomingMsg_t *pInMsg )
 
 void bdb_RepUpdateMarkBindings( void )
 {
-  uint8 numMarkedEntries = 0;
   uint8 i;
   for(i=0; i<bdb_reportingClusterEndpointArrayCount; i++)
   {
@@ -773,7 +736,6 @@ void bdb_RepUpdateMarkBindings( void )
       {
         bdb_RepMarkHasBindingInEndpointClusterArray( bdb_reportingClusterEndpointArray[i].endpoint, bdb_reportingClusterEndpointArray[i].cluster, BDBREPORTING_FALSE, BDBREPORTING_IGNORE );
       }
-      numMarkedEntries++;
     }
     else
     {
@@ -784,24 +746,8 @@ void bdb_RepUpdateMarkBindings( void )
     }
   }
   
-  //Checking is bdb_reporting timer is active
-  if( osal_get_timeoutEx( bdb_TaskID, BDB_REPORT_TIMEOUT) > 0 )
-  {
-    //If timer is active
-    if( numMarkedEntries == 0 ) //No entries
-    {
-      //Stop Timer
-      osal_stop_timerEx( bdb_TaskID, BDB_REPORT_TIMEOUT );
-    }
-  }
-  else
-  {
-    if( numMarkedEntries > 0 )
-    {
-      //Start timer
-      bdb_RepStartReporting( );      
-    }
-  }
+  //Arm the timer for the earliest deadline, or stop it if nothing is bound
+  bdb_RepRestartNextEventTimer( );
 }
 
 /*********************************************************************
@@ -956,37 +902,6 @@ static void bdb_linkedListAttrClearList( bdbAttrLinkedListAttr_t *list )
   list->numItems = 0;
 }
 
-/*********************************************************************
- * @fn      bdb_linkedListAttrGetAtIndex
- *
- * @brief   Returns the ith element of the list starting from the head
- *
- * @param   list - Pointer to linked list
- *
- * @return  A pointer to the ith node element
- */
-static bdbLinkedListAttrItem_t* bdb_linkedListAttrGetAtIndex( bdbAttrLinkedListAttr_t *list, uint8 index )
-{
-  if( index > list->numItems-1 )
-  {
-    return NULL;
-  }
-  bdbLinkedListAttrItem_t* cur = list->head;
-  uint8 i;
-  for( i=0; i<=index; i++ )
-  {
-    if( cur == NULL )
-    {
-      return NULL;
-    }
-    if( i < index )
-    {
-      cur = cur->next;
-    }
-  }
-  return cur;
-}
-
 /*
 * End: Single linked list for attributes in a cluster-endpoint entry methods
 */
@@ -1006,6 +921,7 @@ static bdbLinkedListAttrItem_t* bdb_linkedListAttrGetAtIndex( bdbAttrLinkedListA
 static void bdb_clusterEndpointArrayInit( void )
 {
   bdb_reportingClusterEndpointArrayCount = 0;
+  bdb_reportingHeapCount = 0;
 }
 
 /*********************************************************************
@@ -1020,7 +936,7 @@ static void bdb_clusterEndpointArrayInit( void )
  *
  * @return  A pointer to the ith node element
  */
-static uint8 bdb_clusterEndpointArrayAdd( uint8 endpoint, uint16 cluster, uint16 consolidatedMinReportInt, uint16 consolidatedMaxReportInt, uint16 timeSinceLastReport )
+static uint8 bdb_clusterEndpointArrayAdd( uint8 endpoint, uint16 cluster, uint16 consolidatedMinReportInt, uint16 consolidatedMaxReportInt )
 {
   if( bdb_reportingClusterEndpointArrayCount>=BDB_MAX_CLUSTERENDPOINTS_REPORTING )
   {
@@ -1031,7 +947,8 @@ static uint8 bdb_clusterEndpointArrayAdd( uint8 endpoint, uint16 cluster, uint16
 
   bdb_reportingClusterEndpointArray[bdb_reportingClusterEndpointArrayCount].consolidatedMinReportInt = consolidatedMinReportInt;
   bdb_reportingClusterEndpointArray[bdb_reportingClusterEndpointArrayCount].consolidatedMaxReportInt = consolidatedMaxReportInt;
-  bdb_reportingClusterEndpointArray[bdb_reportingClusterEndpointArrayCount].timeSinceLastReport = timeSinceLastReport;
+  bdb_reportingClusterEndpointArray[bdb_reportingClusterEndpointArrayCount].lastReportTime = osal_GetSystemClock( );
+  bdb_reportingClusterEndpointArray[bdb_reportingClusterEndpointArrayCount].heapPos = BDBREPORTING_INVALIDINDEX;
   bdb_linkedListAttrInit( &bdb_reportingClusterEndpointArray[bdb_reportingClusterEndpointArrayCount].attrLinkedList );
   FLAGS_TURNOFFALLFLAGS( bdb_reportingClusterEndpointArray[bdb_reportingClusterEndpointArrayCount].flags );
   
@@ -1039,38 +956,6 @@ static uint8 bdb_clusterEndpointArrayAdd( uint8 endpoint, uint16 cluster, uint16
   return BDBREPORTING_SUCCESS;
 }
 
-static uint8 bdb_clusterEndpointArrayGetMin( void )
-{
-  uint8 indexMin = 0xFF;
-  uint16 ValueMin = 0xFFFF;
-  uint16 possibleMin;
-  uint8 i;
-  for( i=0; i<bdb_reportingClusterEndpointArrayCount; i++ )
-  {
-    if( FLAGS_CHECKFLAG( bdb_reportingClusterEndpointArray[i].flags, BDBREPORTING_HASBINDING_FLAG_MASK ) == BDBREPORTING_TRUE )
-    { //Only do with valid entries (HasBinding==true)
-      if( bdb_reportingClusterEndpointArray[i].consolidatedMaxReportInt != BDBREPORTING_NOPERIODIC &&  
-         bdb_reportingClusterEndpointArray[i].consolidatedMaxReportInt != BDBREPORTING_REPORTOFF )
-      {
-        //If maxInterval is BDBREPORTING_NOPERIODIC=0x0000 or BDBREPORTING_REPORTOFF=0xFFFF, ignore to calculate min
-        if( ValueMin == 0 )
-        {
-          //stop if we find a minValue of zero because there no other Min less than that
-          break;
-        }
-        possibleMin = bdb_reportingClusterEndpointArray[i].consolidatedMaxReportInt - bdb_reportingClusterEndpointArray[i].timeSinceLastReport;
-        if( possibleMin<ValueMin )
-        {
-          indexMin = i;
-          ValueMin = possibleMin;
-        }
-      }
-    }
-  }
-  return indexMin;
-
-}
-
 static uint8 bdb_clusterEndpointArrayRemoveAt( uint8 index )
 {
   if( index>=bdb_reportingClusterEndpointArrayCount )
@@ -1091,19 +976,23 @@ static void bdb_clusterEndpointArrayMoveTo( uint8 indexSrc, uint8 indexDest )
   bdb_reportingClusterEndpointArray[indexSrc].endpoint = bdb_reportingClusterEndpointArray[indexDest].endpoint;
   bdb_reportingClusterEndpointArray[indexSrc].consolidatedMaxReportInt = bdb_reportingClusterEndpointArray[indexDest].consolidatedMaxReportInt;
   bdb_reportingClusterEndpointArray[indexSrc].consolidatedMinReportInt = bdb_reportingClusterEndpointArray[indexDest].consolidatedMinReportInt;
-  bdb_reportingClusterEndpointArray[indexSrc].timeSinceLastReport = bdb_reportingClusterEndpointArray[indexDest].timeSinceLastReport;
+  bdb_reportingClusterEndpointArray[indexSrc].lastReportTime = bdb_reportingClusterEndpointArray[indexDest].lastReportTime;
+  bdb_reportingClusterEndpointArray[indexSrc].nextReportTime = bdb_reportingClusterEndpointArray[indexDest].nextReportTime;
+  bdb_reportingClusterEndpointArray[indexSrc].heapPos = bdb_reportingClusterEndpointArray[indexDest].heapPos;
   bdb_reportingClusterEndpointArray[indexSrc].attrLinkedList = bdb_reportingClusterEndpointArray[indexDest].attrLinkedList;
   bdb_reportingClusterEndpointArray[indexSrc].flags = bdb_reportingClusterEndpointArray[indexDest].flags;
   bdb_linkedListAttrClearList( &bdb_reportingClusterEndpointArray[indexDest].attrLinkedList );
 }
 
-static uint8 bdb_clusterEndpointArrayUpdateAt( uint8 index, uint16 newTimeSinceLastReport, uint8 markHasBinding, uint8 markNoNextIncrement )
+static uint8 bdb_clusterEndpointArrayUpdateAt( uint8 index, uint8 markHasBinding )
 {
   if( index >= bdb_reportingClusterEndpointArrayCount )
   {
     return BDBREPORTING_ERROR;
   }
-  bdb_reportingClusterEndpointArray[index].timeSinceLastReport = newTimeSinceLastReport;
+  //Restart the report interval, any pending change is covered by this report
+  bdb_reportingClusterEndpointArray[index].lastReportTime = osal_GetSystemClock( );
+  FLAGS_TURNOFFFLAG( bdb_reportingClusterEndpointArray[index].flags, BDBREPORTING_CHANGEPENDING_FLAG_MASK );
   if( markHasBinding != BDBREPORTING_IGNORE )
   {
     if( markHasBinding == BDBREPORTING_TRUE )
@@ -1115,17 +1004,6 @@ static uint8 bdb_clusterEndpointArrayUpdateAt( uint8 index, uint16 newTimeSinceL
       FLAGS_TURNOFFFLAG( bdb_reportingClusterEndpointArray[index].flags, BDBREPORTING_HASBINDING_FLAG_MASK );
     }
   }
-  if( markNoNextIncrement != BDBREPORTING_IGNORE )
-  {
-    if( markNoNextIncrement == BDBREPORTING_TRUE )
-    {
-      FLAGS_TURNONFLAG( bdb_reportingClusterEndpointArray[index].flags, BDBREPORTING_NONEXTINCREMENT_FLAG_MASK );
-    }
-    else
-    {
-      FLAGS_TURNOFFFLAG( bdb_reportingClusterEndpointArray[index].flags, BDBREPORTING_NONEXTINCREMENT_FLAG_MASK );
-    }
-  }
   return BDBREPORTING_SUCCESS;
 }
 
@@ -1137,6 +1015,7 @@ static void bdb_clusterEndpointArrayFreeAll( )
   {
     bdb_clusterEndpointArrayRemoveAt( 0 );
   }
+  bdb_reportingHeapCount = 0;
 }
 
 static uint8 bdb_clusterEndpointArraySearch( uint8 endpoint, uint16 cluster )
@@ -1154,45 +1033,188 @@ static uint8 bdb_clusterEndpointArraySearch( uint8 endpoint, uint16 cluster )
   return foundIndex;
 }
 
-static void bdb_clusterEndpointArrayIncrementAll( uint16 timeSinceLastReportIncrement, uint8 CheckNoIncrementFlag )
+/*
+* End: Cluster-endpoint array live data methods
+*/
+
+
+/*
+* Begin: Report deadline heap methods
+*/
+
+/*********************************************************************
+ * @fn      bdb_repHeapLess
+ *
+ * @brief   Compares the deadlines of two cluster-endpoint entries,
+ *          system clock wrap around safe
+ *
+ * @param   a - index of the first entry
+ * @param   b - index of the second entry
+ *
+ * @return  BDBREPORTING_TRUE if entry a is due before entry b
+ */
+static uint8 bdb_repHeapLess( uint8 a, uint8 b )
 {
-  uint8 i;
-  uint8 doIncrement;
-  for( i=0; i<bdb_reportingClusterEndpointArrayCount; i++ )
+  return ( (int32)( bdb_reportingClusterEndpointArray[a].nextReportTime -
+                    bdb_reportingClusterEndpointArray[b].nextReportTime ) < 0 ) ? BDBREPORTING_TRUE : BDBREPORTING_FALSE;
+}
+
+static void bdb_repHeapSwap( uint8 posA, uint8 posB )
+{
+  uint8 tmp = bdb_reportingHeap[posA];
+  bdb_reportingHeap[posA] = bdb_reportingHeap[posB];
+  bdb_reportingHeap[posB] = tmp;
+  bdb_reportingClusterEndpointArray[bdb_reportingHeap[posA]].heapPos = posA;
+  bdb_reportingClusterEndpointArray[bdb_reportingHeap[posB]].heapPos = posB;
+}
+
+static void bdb_repHeapSiftUp( uint8 pos )
+{
+  while( pos > 0 )
+  {
+    uint8 parent = (pos - 1) / 2;
+    if( bdb_repHeapLess( bdb_reportingHeap[pos], bdb_reportingHeap[parent] ) == BDBREPORTING_FALSE )
+    {
+      break;
+    }
+    bdb_repHeapSwap( pos, parent );
+    pos = parent;
+  }
+}
+
+static void bdb_repHeapSiftDown( uint8 pos )
+{
+  for( ;; )
   {
-    doIncrement = BDBREPORTING_FALSE;
-    if( FLAGS_CHECKFLAG( bdb_reportingClusterEndpointArray[i].flags, BDBREPORTING_HASBINDING_FLAG_MASK ) == BDBREPORTING_TRUE )
-    { 
-      //Only do with valid entries (HasBinding==true)
-      if( CheckNoIncrementFlag == BDBREPORTING_FALSE )
+    uint8 child = 2 * pos + 1;
+    if( child >= bdb_reportingHeapCount )
+    {
+      break;
+    }
+    if( ( child + 1 < bdb_reportingHeapCount ) &&
+        ( bdb_repHeapLess( bdb_reportingHeap[child + 1], bdb_reportingHeap[child] ) == BDBREPORTING_TRUE ) )
+    {
+      child++;
+    }
+    if( bdb_repHeapLess( bdb_reportingHeap[child], bdb_reportingHeap[pos] ) == BDBREPORTING_FALSE )
+    {
+      break;
+    }
+    bdb_repHeapSwap( pos, child );
+    pos = child;
+  }
+}
+
+/*********************************************************************
+ * @fn      bdb_repHeapSchedule
+ *
+ * @brief   Calculates the next report deadline of a cluster-endpoint entry.
+ *          A pending value change is due when the min interval expires,
+ *          otherwise the entry is due when the max interval expires.
+ *
+ * @param   index - index of the entry
+ *
+ * @return  BDBREPORTING_TRUE if the entry has a deadline
+ */
+static uint8 bdb_repHeapSchedule( uint8 index )
+{
+  bdbReportAttrClusterEndpoint_t* item = &bdb_reportingClusterEndpointArray[index];
+  uint8 periodic;
+
+  if( ( FLAGS_CHECKFLAG( item->flags, BDBREPORTING_HASBINDING_FLAG_MASK ) == BDBREPORTING_FALSE ) ||
+      ( item->consolidatedMaxReportInt == BDBREPORTING_REPORTOFF ) )
+  {
+    return BDBREPORTING_FALSE;
+  }
+
+  periodic = ( item->consolidatedMaxReportInt != BDBREPORTING_NOPERIODIC ) ? BDBREPORTING_TRUE : BDBREPORTING_FALSE;
+  if( periodic == BDBREPORTING_TRUE )
+  {
+    item->nextReportTime = item->lastReportTime + ( 1000L * item->consolidatedMaxReportInt );
+  }
+
+  if( FLAGS_CHECKFLAG( item->flags, BDBREPORTING_CHANGEPENDING_FLAG_MASK ) == BDBREPORTING_TRUE )
+  {
+    uint32 minTime = item->lastReportTime + ( 1000L * item->consolidatedMinReportInt );
+    if( ( periodic == BDBREPORTING_FALSE ) || ( (int32)( minTime - item->nextReportTime ) < 0 ) )
+    {
+      item->nextReportTime = minTime;
+    }
+    return BDBREPORTING_TRUE;
+  }
+
+  return periodic;
+}
+
+/*********************************************************************
+ * @fn      bdb_repHeapUpdate
+ *
+ * @brief   Recalculates the deadline of a cluster-endpoint entry and
+ *          moves it to its place in the heap, removing it if the entry
+ *          has no deadline anymore.
+ *
+ * @param   index - index of the entry
+ *
+ * @return  none
+ */
+static void bdb_repHeapUpdate( uint8 index )
+{
+  uint8 pos = bdb_reportingClusterEndpointArray[index].heapPos;
+
+  if( pos != BDBREPORTING_INVALIDINDEX )
+  {
+    //Remove the entry, filling the hole with the last one
+    bdb_reportingClusterEndpointArray[index].heapPos = BDBREPORTING_INVALIDINDEX;
+    bdb_reportingHeapCount--;
+    if( pos < bdb_reportingHeapCount )
+    {
+      bdb_reportingHeap[pos] = bdb_reportingHeap[bdb_reportingHeapCount];
+      bdb_reportingClusterEndpointArray[bdb_reportingHeap[pos]].heapPos = pos;
+      if( ( pos > 0 ) && 
+          ( bdb_repHeapLess( bdb_reportingHeap[pos], bdb_reportingHeap[(pos - 1) / 2] ) == BDBREPORTING_TRUE ) )
       {
-        doIncrement = BDBREPORTING_TRUE;
+        bdb_repHeapSiftUp( pos );
       }
       else
       {
-        if( FLAGS_CHECKFLAG( bdb_reportingClusterEndpointArray[i].flags, BDBREPORTING_NONEXTINCREMENT_FLAG_MASK ) == BDBREPORTING_FALSE )
-        {
-          doIncrement = BDBREPORTING_TRUE;
-        }
-      }
-      if( doIncrement == BDBREPORTING_TRUE )
-      {
-        if( bdb_reportingClusterEndpointArray[i].consolidatedMaxReportInt != BDBREPORTING_NOPERIODIC &&  bdb_reportingClusterEndpointArray[i].consolidatedMaxReportInt != BDBREPORTING_REPORTOFF )
-        {
-          bdb_reportingClusterEndpointArray[i].timeSinceLastReport = (bdb_reportingClusterEndpointArray[i].timeSinceLastReport+timeSinceLastReportIncrement 
-                                                                      > bdb_reportingClusterEndpointArray[i].consolidatedMaxReportInt)? 
-                                                                      bdb_reportingClusterEndpointArray[i].consolidatedMaxReportInt: 
-                                                                      bdb_reportingClusterEndpointArray[i].timeSinceLastReport+timeSinceLastReportIncrement;
-        }
+        bdb_repHeapSiftDown( pos );
       }
-      FLAGS_TURNOFFFLAG( bdb_reportingClusterEndpointArray[i].flags, BDBREPORTING_NONEXTINCREMENT_FLAG_MASK ); //Always turn off, one shot functionality
-      
     }
   }
+
+  if( bdb_repHeapSchedule( index ) == BDBREPORTING_TRUE )
+  {
+    pos = bdb_reportingHeapCount++;
+    bdb_reportingHeap[pos] = index;
+    bdb_reportingClusterEndpointArray[index].heapPos = pos;
+    bdb_repHeapSiftUp( pos );
+  }
+}
+
+/*********************************************************************
+ * @fn      bdb_repHeapBuild
+ *
+ * @brief   Rebuilds the heap from all the cluster-endpoint entries
+ *
+ * @return  none
+ */
+static void bdb_repHeapBuild( void )
+{
+  uint8 i;
+
+  bdb_reportingHeapCount = 0;
+  for( i=0; i<bdb_reportingClusterEndpointArrayCount; i++ )
+  {
+    bdb_reportingClusterEndpointArray[i].heapPos = BDBREPORTING_INVALIDINDEX;
+  }
+  for( i=0; i<bdb_reportingClusterEndpointArrayCount; i++ )
+  {
+    bdb_repHeapUpdate( i );
+  }
 }
 
 /*
-* End: Cluster-endpoint array live data methods
+* End: Report deadline heap methods
 */
 
 
@@ -1432,7 +1454,7 @@ static uint8 bdb_repAttrBuildClusterEndPointArrayBasedOnConfRecordsArray( void )
       status = bdb_repAttrCfgRecordsArrayConsolidateValues( curEndpoint, curCluster, &consolidatedMinReportInt, &consolidatedMaxReportInt );
       if( status == BDBREPORTING_SUCCESS )
       {
-        status = bdb_clusterEndpointArrayAdd( curEndpoint, curCluster, consolidatedMinReportInt, consolidatedMaxReportInt, 0 );
+        status = bdb_clusterEndpointArrayAdd( curEndpoint, curCluster, consolidatedMinReportInt, consolidatedMaxReportInt );
         if( status == BDBREPORTING_SUCCESS )
         {
           zclAttribute_t zclAttribute;
@@ -1662,70 +1684,109 @@ static uint8 bdb_RepLoadCfgRecords( void )
 static void bdb_RepReport( uint8 specificCLusterEndpointIndex )
 {
   afAddrType_t dstAddr;
-  zclReportCmd_t *pReportCmd;
-  uint8 i;
+  uint8 *pBuf;
+  uint8 *pCur;
+  uint16 dataLen;
   
-  bdbReportAttrClusterEndpoint_t* clusterEndpointItem = NULL;
-  if( specificCLusterEndpointIndex == BDBREPORTING_INVALIDINDEX )
-  {
-    if( bdb_reportingNextClusterEndpointIndex < bdb_reportingClusterEndpointArrayCount )
-    {
-      clusterEndpointItem = &(bdb_reportingClusterEndpointArray[bdb_reportingNextClusterEndpointIndex]);
-    }
-  }
-  else
-  {
-    clusterEndpointItem = &(bdb_reportingClusterEndpointArray[specificCLusterEndpointIndex]);
-  }
+  bdbReportAttrClusterEndpoint_t* clusterEndpointItem = &(bdb_reportingClusterEndpointArray[specificCLusterEndpointIndex]);
 
   // actually send the report
   if( clusterEndpointItem->consolidatedMaxReportInt != ZCL_REPORTING_OFF && clusterEndpointItem->attrLinkedList.numItems )
   {
+    bdbLinkedListAttrItem_t* attrListItem;
+    zclAttrRec_t attrRec;
+    uint8 attrData[BDBREPORTING_MAX_ATTR_SIZE];
+
     dstAddr.addrMode = (afAddrMode_t)AddrNotPresent;
     dstAddr.addr.shortAddr = 0;
     dstAddr.endPoint = clusterEndpointItem->endpoint;
     dstAddr.panId = _NIB.nwkPanId;
     
-    pReportCmd = osal_mem_alloc( sizeof( zclReportCmd_t ) + (clusterEndpointItem->attrLinkedList.numItems * sizeof( zclReport_t )) );
-    if ( pReportCmd != NULL )
+    // Size the report payload, attributes no longer in the database are skipped
+    dataLen = 0;
+    for( attrListItem = clusterEndpointItem->attrLinkedList.head; attrListItem != NULL; attrListItem = attrListItem->next )
     {
-      pReportCmd->numAttr = clusterEndpointItem->attrLinkedList.numItems;
-      for ( i = 0; i < clusterEndpointItem->attrLinkedList.numItems; ++ i )
+      if( zclFindAttrRec( clusterEndpointItem->endpoint, clusterEndpointItem->cluster, attrListItem->data->attrID, &attrRec ) )
       {
-        pReportCmd->attrList[i].attrID   = 0xFFFF;
-        pReportCmd->attrList[i].dataType = 0xFF;
-        pReportCmd->attrList[i].attrData = NULL;
-        
-        bdbLinkedListAttrItem_t* attrListItem = bdb_linkedListAttrGetAtIndex( &clusterEndpointItem->attrLinkedList, i );      
-        if(attrListItem!=NULL)
+        dataLen += 2 + 1; // Attribute ID + data type
+        dataLen += bdb_RepAttrDataLength( clusterEndpointItem->endpoint, clusterEndpointItem->cluster, &attrRec );
+      }
+    }
+
+    if( dataLen == 0 )
+    {
+      return;
+    }
+
+    // Serialize the attribute values straight into the report payload
+    pBuf = osal_mem_alloc( dataLen );
+    if ( pBuf != NULL )
+    {
+      pCur = pBuf;
+      for( attrListItem = clusterEndpointItem->attrLinkedList.head; attrListItem != NULL; attrListItem = attrListItem->next )
+      {
+        if( zclFindAttrRec( clusterEndpointItem->endpoint, clusterEndpointItem->cluster, attrListItem->data->attrID, &attrRec ) )
         {
-          pReportCmd->attrList[i].attrID = attrListItem->data->attrID;   
-          zclAttribute_t attrRec;
-          uint8 attrRes = bdb_RepFindAttrEntry( clusterEndpointItem->endpoint, clusterEndpointItem->cluster, attrListItem->data->attrID, &attrRec );
-          if( attrRes == BDBREPORTING_TRUE )
+          uint16 attrLen = zclGetDataTypeLength( attrRec.attr.dataType );
+
+          *pCur++ = LO_UINT16( attrRec.attr.attrId );
+          *pCur++ = HI_UINT16( attrRec.attr.attrId );
+          *pCur++ = attrRec.attr.dataType;
+
+          if( ( attrLen > 0 ) && ( attrLen <= BDBREPORTING_MAX_ATTR_SIZE ) )
           {
-            pReportCmd->attrList[i].dataType = attrRec.dataType;          
-            pReportCmd->attrList[i].attrData = attrRec.dataPtr;          
+            // Fixed size value, read it in native format and serialize it
+            zcl_memset( attrData, 0, BDBREPORTING_MAX_ATTR_SIZE );
+            zcl_ReadAttrData( clusterEndpointItem->endpoint, clusterEndpointItem->cluster, attrRec.attr.attrId, attrData, &attrLen );
+            pCur = zclSerializeData( attrRec.attr.dataType, attrData, pCur );
+
             //Update last value reported
-            if( zclAnalogDataType( attrRec.dataType ) )
+            if( zclAnalogDataType( attrRec.attr.dataType ) )
             { 
               //Only if the datatype is analog
-              osal_memset( attrListItem->data->lastValueReported,0x00, BDBREPORTING_MAX_ANALOG_ATTR_SIZE );
-              osal_memcpy( attrListItem->data->lastValueReported, attrRec.dataPtr, zclGetDataTypeLength( attrRec.dataType ) );
+              osal_memcpy( attrListItem->data->lastValueReported, attrData, BDBREPORTING_MAX_ANALOG_ATTR_SIZE );
             }
           }
+          else
+          {
+            // Strings and other variable length values are sent as stored
+            attrLen = bdb_RepAttrDataLength( clusterEndpointItem->endpoint, clusterEndpointItem->cluster, &attrRec );
+            zcl_ReadAttrData( clusterEndpointItem->endpoint, clusterEndpointItem->cluster, attrRec.attr.attrId, pCur, NULL );
+            pCur += attrLen;
+          }
         }
       }
 
-      zcl_SendReportCmd( clusterEndpointItem->endpoint, &dstAddr,
-                         clusterEndpointItem->cluster, pReportCmd,
-                         ZCL_FRAME_SERVER_CLIENT_DIR, BDB_REPORTING_DISABLE_DEFAULT_RSP, bdb_getZCLFrameCounter( ) );
+      zcl_SendCommand( clusterEndpointItem->endpoint, &dstAddr, clusterEndpointItem->cluster,
+                       ZCL_CMD_REPORT, FALSE, ZCL_FRAME_SERVER_CLIENT_DIR,
+                       BDB_REPORTING_DISABLE_DEFAULT_RSP, 0, bdb_getZCLFrameCounter( ),
+                       (uint16)(pCur - pBuf), pBuf );
 
-      osal_mem_free( pReportCmd );
+      osal_mem_free( pBuf );
     }
   }
 }
 
+/*********************************************************************
+ * @fn      bdb_RepAttrDataLength
+ *
+ * @brief   Get the over the air length of an attribute's current value
+ *
+ * @param   endpoint - endpoint of the attribute
+ * @param   cluster - cluster of the attribute
+ * @param   attrRec - attribute record found in the database
+ *
+ * @return  Length in bytes of the value
+ */
+static uint16 bdb_RepAttrDataLength( uint8 endpoint, uint16 cluster, zclAttrRec_t *attrRec )
+{
+  if( attrRec->attr.dataPtr != NULL )
+  {
+    return zclGetAttrDataLength( attrRec->attr.dataType, (uint8*)attrRec->attr.dataPtr );
+  }
+  return zcl_GetAttrDataLength( endpoint, cluster, attrRec->attr.attrId );
+}
+
 static uint8 bdb_isAttrValueChangedSurpassDelta( uint8 datatype, uint8* delta, uint8* curValue, uint8* lastValue )
 {
   uint8 res = BDBREPORTING_FALSE;
@@ -1918,10 +1979,15 @@ static uint8 bdb_isAttrValueChangedSurpassDelta( uint8 datatype, uint8* delta, u
 
 static void bdb_RepRestartNextEventTimer( void )
 {
-  uint32 timeMs;
-  // convert from seconds to milliseconds
-  timeMs = 1000L * (bdb_reportingNextEventTimeout); 
-  osal_start_timerEx( bdb_TaskID, BDB_REPORT_TIMEOUT, timeMs );
+  int32 timeMs;
+  if( bdb_reportingHeapCount == 0 )
+  {
+    //Nothing to report, let the device sleep
+    osal_stop_timerEx( bdb_TaskID, BDB_REPORT_TIMEOUT );
+    return;
+  }
+  timeMs = (int32)( bdb_reportingClusterEndpointArray[bdb_reportingHeap[0]].nextReportTime - osal_GetSystemClock( ) );
+  osal_start_timerEx( bdb_TaskID, BDB_REPORT_TIMEOUT, ( timeMs > 0 ) ? (uint32)timeMs : 0 );
 }
 
 static void bdb_RepSetupReporting( void )
@@ -2011,36 +2077,20 @@ static endPointDesc_t* bdb_FindEpDesc( uint8 endPoint )
 
 static uint8 bdb_RepFindAttrEntry( uint8 endpoint, uint16 cluster, uint16 attrID, zclAttribute_t* attrRes )
 {
-  epList_t *epCur = epList;
-  uint8 i;
+  zclAttrRec_t attrRec;
+  uint16 dataLen;
 
   zcl_memset(gAttrDataValue, 0, BDBREPORTING_MAX_ANALOG_ATTR_SIZE);
-  for ( epCur = epList; epCur != NULL; epCur = epCur->nextDesc )
+  if( zclFindAttrRec( endpoint, cluster, attrID, &attrRec ) )
   {
-    if( epCur->epDesc->endPoint == endpoint )
-    {
-      zclAttrRecsList* attrItem = zclFindAttrRecsList( epCur->epDesc->endPoint );
-      
-      if( (attrItem != NULL) && ( (attrItem->numAttributes > 0) && (attrItem->attrs != NULL) ) )
-      {
-        for ( i = 0; i < attrItem->numAttributes; i++ )
-        {
-          if ( ( attrItem->attrs[i].clusterID == cluster ) && ( attrItem->attrs[i].attr.attrId ==  attrID ) )
-          {
-            uint16 dataLen;
+    attrRes->attrId = attrRec.attr.attrId;
+    attrRes->dataType = attrRec.attr.dataType;
+    attrRes->accessControl = attrRec.attr.accessControl;
 
-            attrRes->attrId = attrItem->attrs[i].attr.attrId;
-            attrRes->dataType = attrItem->attrs[i].attr.dataType;
-            attrRes->accessControl = attrItem->attrs[i].attr.accessControl;
-
-            dataLen = zclGetDataTypeLength(attrRes->dataType);
-            zcl_ReadAttrData( endpoint, cluster, attrRes->attrId, gAttrDataValue, &dataLen );
-            attrRes->dataPtr = gAttrDataValue;
-            return BDBREPORTING_TRUE;
-          }
-        }
-      }
-    }
+    dataLen = zclGetDataTypeLength(attrRes->dataType);
+    zcl_ReadAttrData( endpoint, cluster, attrRes->attrId, gAttrDataValue, &dataLen );
+    attrRes->dataPtr = gAttrDataValue;
+    return BDBREPORTING_TRUE;
   }
   return BDBREPORTING_FALSE;
  }
@@ -2198,24 +2248,12 @@ ZStatus_t bdb_RepChangedAttrValue( uint8 endpoint, uint16 cluster, uint16 attrID
     return ZInvalidParameter; //Attr not found in attributes app data
   }
   
-  //Get time of timer if active
-  uint32 remainingTimeOfEvent = osal_get_timeoutEx( bdb_TaskID, BDB_REPORT_TIMEOUT );
-  uint16 elapsedTime = 0;
-  uint8 isTimeRemaining = BDBREPORTING_FALSE;
-  if( remainingTimeOfEvent > 0 )
+  if( FLAGS_CHECKFLAG( bdb_reportingClusterEndpointArray[indexClusterEndpoint].flags, BDBREPORTING_CHANGEPENDING_FLAG_MASK ) == BDBREPORTING_TRUE )
   {
-    elapsedTime = bdb_RepCalculateEventElapsedTime( remainingTimeOfEvent, bdb_reportingNextEventTimeout );
-    isTimeRemaining =  BDBREPORTING_TRUE;
+    //A report is already scheduled for the end of the min interval
+    return ZSuccess;
   }
   
-  if( bdb_reportingClusterEndpointArray[indexClusterEndpoint].consolidatedMinReportInt != BDBREPORTING_NOLIMIT &&
-     (bdb_reportingClusterEndpointArray[indexClusterEndpoint].timeSinceLastReport + elapsedTime) <= bdb_reportingClusterEndpointArray[indexClusterEndpoint].consolidatedMinReportInt)
-  {
-      //Attr value has changed before minInterval, ommit reporting
-      return ZSuccess;
-  }
- 
-  
   if( zclAnalogDataType(attrRec.dataType) )
   {
     //Checking if   | lastvaluereported - currentvalue | >=  | changevalue |
@@ -2230,16 +2268,20 @@ ZStatus_t bdb_RepChangedAttrValue( uint8 endpoint, uint16 cluster, uint16 attrID
     //Attr is discrete, just report without checking the changeValue
   }
   
-  //Stop reporting  
-  bdb_RepStopEventTimer( );
-  bdb_RepReport( indexClusterEndpoint );
-  if( isTimeRemaining == BDBREPORTING_TRUE )
+  if( bdb_reportingClusterEndpointArray[indexClusterEndpoint].consolidatedMinReportInt != BDBREPORTING_NOLIMIT &&
+     ( osal_GetSystemClock( ) - bdb_reportingClusterEndpointArray[indexClusterEndpoint].lastReportTime ) <
+       ( 1000L * bdb_reportingClusterEndpointArray[indexClusterEndpoint].consolidatedMinReportInt ) )
   {
-    bdb_clusterEndpointArrayIncrementAll( elapsedTime, BDBREPORTING_FALSE );
+    //Attr value has changed before minInterval, report when it expires
+    FLAGS_TURNONFLAG( bdb_reportingClusterEndpointArray[indexClusterEndpoint].flags, BDBREPORTING_CHANGEPENDING_FLAG_MASK );
   }
-  bdb_clusterEndpointArrayUpdateAt( indexClusterEndpoint, 0, BDBREPORTING_IGNORE, BDBREPORTING_IGNORE ); //return time since last report to zero
-  //Restart reporting
-  bdb_RepStartReporting( );
+  else
+  {
+    bdb_RepReport( indexClusterEndpoint );
+    bdb_clusterEndpointArrayUpdateAt( indexClusterEndpoint, BDBREPORTING_IGNORE ); //restart the report interval
+  }
+  bdb_repHeapUpdate( indexClusterEndpoint );
+  bdb_RepRestartNextEventTimer( );
   
   return ZSuccess;
 }
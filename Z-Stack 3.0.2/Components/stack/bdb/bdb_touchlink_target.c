@@ -59,7 +59,7 @@
 #include "bdb.h"
 #include "bdb_interface.h"
 #include "bdb_tlCommissioning.h"
-#include "bdb_touchLink.h"
+#include "bdb_touchlink.h"
 
 #include "bdb_touchlink_target.h"
 
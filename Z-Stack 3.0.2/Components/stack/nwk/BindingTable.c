@@ -56,6 +56,15 @@
 /*********************************************************************
  * MACROS
  */
+#if defined ( BINDING_HASH_INDEX )
+  // Bucket of a source endpoint and cluster ID pair
+  #define BIND_HASH( ep, cId )   ( ((ep) ^ LO_UINT16( cId ) ^ HI_UINT16( cId )) & (BIND_HASH_BUCKETS - 1) )
+
+  // The index is rebuilt on the next lookup after any change to the table
+  #define BIND_HASH_INVALIDATE() ( bindHashValid = FALSE )
+#else
+  #define BIND_HASH_INVALIDATE()
+#endif
 
 /*********************************************************************
  * CONSTANTS
@@ -64,6 +73,21 @@
 #define NV_BIND_REC_SIZE (gBIND_REC_SIZE)
 #define NV_BIND_ITEM_SIZE  (gBIND_REC_SIZE * gNWK_MAX_BINDING_ENTRIES)
 
+#if defined ( BINDING_HASH_INDEX )
+  // Number of (srcEP, clusterID) hash buckets, must be a power of 2
+  #if !defined ( BIND_HASH_BUCKETS )
+    #define BIND_HASH_BUCKETS  16
+  #endif
+
+  #if ( BIND_HASH_BUCKETS & (BIND_HASH_BUCKETS - 1) ) || ( BIND_HASH_BUCKETS > 256 )
+    #error "BIND_HASH_BUCKETS must be a power of 2, up to 256"
+  #endif
+
+  // Sized like BindingTable[] in nwk_globals.c
+  #define BIND_HASH_NODES    ( NWK_MAX_BINDING_ENTRIES * MAX_BINDING_CLUSTER_IDS )
+  #define BIND_HASH_NONE     0xFFFF
+#endif
+
 /*********************************************************************
  * TYPEDEFS
  */
@@ -93,6 +117,9 @@ BindingEntry_t *bindFindEmpty( void );
 uint16 bindingAddrMgsHelperFind( zAddrType_t *addr );
 uint8 bindingAddrMgsHelperConvert( uint16 idx, zAddrType_t *addr );
 void bindAddrMgrLocalLoad( void );
+#if defined ( BINDING_HASH_INDEX )
+static void bindHashBuild( void );
+#endif
 
 #if !defined ( BINDINGTABLE_NV_SINGLES )
   #if !defined ( DONT_UPGRADE_BIND )
@@ -107,6 +134,15 @@ void bindAddrMgrLocalLoad( void );
  */
 static uint8 bindAddrMgrLocalLoaded = FALSE;
 
+#if defined ( BINDING_HASH_INDEX )
+// Secondary index of the binding table by (srcEP, clusterID). Node n stands
+// for cluster slot (n % MAX_BINDING_CLUSTER_IDS) of binding table entry
+// (n / MAX_BINDING_CLUSTER_IDS), each chain is kept in table order.
+static uint16 bindHashHead[BIND_HASH_BUCKETS];
+static uint16 bindHashNext[BIND_HASH_NODES];
+static uint8 bindHashValid = FALSE;
+#endif
+
 /*********************************************************************
  * Function Pointers
  */
@@ -153,6 +189,7 @@ void BindAddrMgrCB( uint8 update, AddrMgrEntry_t *entryNew,
 void InitBindingTable( void )
 {
   osal_memset( BindingTable, 0xFF, gBIND_REC_SIZE * gNWK_MAX_BINDING_ENTRIES );
+  BIND_HASH_INVALIDATE();
 
   pbindAddEntry = bindAddEntry;
   pbindNumOfEntries = bindNumOfEntries;
@@ -409,6 +446,8 @@ BindingEntry_t *bindAddEntry( byte srcEpInt,
       }
     }
   }
+  BIND_HASH_INVALIDATE();
+
 #ifdef BDB_REPORTING
   if(bindAdded == TRUE)
   {
@@ -430,6 +469,7 @@ BindingEntry_t *bindAddEntry( byte srcEpInt,
 byte bindRemoveEntry( BindingEntry_t *pBind )
 {
   osal_memset( pBind, 0xFF, gBIND_REC_SIZE );
+  BIND_HASH_INVALIDATE();
 #ifdef BDB_REPORTING
   bdb_RepUpdateMarkBindings();
 #endif
@@ -511,6 +551,7 @@ byte bindRemoveClusterIdFromList( BindingEntry_t *entry, uint16 clusterId )
         }
       }
       
+      BIND_HASH_INVALIDATE();
     }
   }
 
@@ -546,6 +587,7 @@ byte bindAddClusterIdToList( BindingEntry_t *entry, uint16 clusterId )
     // Add the new one
     entry->clusterIdList[entry->numClusterIds] = clusterId;
     entry->numClusterIds++;
+    BIND_HASH_INVALIDATE();
     return ( TRUE );
   }
   return ( FALSE );
@@ -753,6 +795,25 @@ byte bindNumBoundTo( zAddrType_t *devAddr, byte devEpInt, byte srcMode )
  */
 uint16 bindNumReflections( uint8 ep, uint16 clusterID )
 {
+#if defined ( BINDING_HASH_INDEX )
+  uint16 n;
+  BindingEntry_t *pBind;
+  uint16 cnt = 0;
+
+  bindHashBuild();
+
+  for ( n = bindHashHead[BIND_HASH( ep, clusterID )]; n != BIND_HASH_NONE; n = bindHashNext[n] )
+  {
+    pBind = &BindingTable[n / MAX_BINDING_CLUSTER_IDS];
+
+    if ( (pBind->srcEP == ep) && (pBind->clusterIdList[n % MAX_BINDING_CLUSTER_IDS] == clusterID) )
+    {
+      cnt++;
+    }
+  }
+
+  return ( cnt );
+#else
   bindTableIndex_t x;
   BindingEntry_t *pBind;
   uint16 cnt = 0;
@@ -770,6 +831,7 @@ uint16 bindNumReflections( uint8 ep, uint16 clusterID )
   }
 
   return ( cnt );
+#endif
 }
 
 /*********************************************************************
@@ -788,27 +850,102 @@ BindingEntry_t *bindFind( uint8 ep, uint16 clusterID, uint8 skipping )
 {
   BindingEntry_t *pBind;
   byte skipped = 0;
+#if defined ( BINDING_HASH_INDEX )
+  uint16 n;
+
+  bindHashBuild();
+
+  for ( n = bindHashHead[BIND_HASH( ep, clusterID )]; n != BIND_HASH_NONE; n = bindHashNext[n] )
+  {
+    pBind = &BindingTable[n / MAX_BINDING_CLUSTER_IDS];
+
+    // Return the match after skipping the number asked for
+    if ( ( pBind->srcEP == ep) && ( pBind->clusterIdList[n % MAX_BINDING_CLUSTER_IDS] == clusterID ) &&
+         ( skipped++ == skipping ) )
+    {
+      return ( pBind );
+    }
+  }
+#else
   bindTableIndex_t x;
 
   for ( x = 0; x < gNWK_MAX_BINDING_ENTRIES; x++ )
   {
     pBind = &BindingTable[x];
 
-    if ( ( pBind->srcEP == ep) && bindIsClusterIDinList( pBind, clusterID ))
+    // Return the match after skipping the number asked for
+    if ( ( pBind->srcEP == ep) && bindIsClusterIDinList( pBind, clusterID ) &&
+         ( skipped++ == skipping ) )
+    {
+      return ( pBind );
+    }
+  }
+#endif
+
+  return ( (BindingEntry_t *)NULL );
+}
+
+#if defined ( BINDING_HASH_INDEX )
+/*********************************************************************
+ * @fn          bindHashBuild
+ *
+ * @brief       Rebuild the (srcEP, clusterID) index of the binding table
+ *              if the table changed since it was last built. Entries are
+ *              linked from the end of the table so that each chain is in
+ *              table order, which keeps bindFind()'s skipping order.
+ *
+ * @param       none
+ *
+ * @return      none
+ */
+static void bindHashBuild( void )
+{
+  BindingEntry_t *pBind;
+  bindTableIndex_t x;
+  uint8 i, j, bucket;
+  uint16 n;
+
+  if ( bindHashValid )
+  {
+    return;
+  }
+
+  osal_memset( bindHashHead, 0xFF, sizeof( bindHashHead ) );
+
+  x = gNWK_MAX_BINDING_ENTRIES;
+  while ( x-- > 0 )
+  {
+    pBind = &BindingTable[x];
+
+    if ( pBind->srcEP == NV_BIND_EMPTY )
+    {
+      continue;
+    }
+
+    for ( i = pBind->numClusterIds; i-- > 0; )
     {
-      if ( skipped < skipping )
+      // Index a repeated cluster ID only once, at its first slot
+      for ( j = 0; j < i; j++ )
       {
-        skipped++;
+        if ( pBind->clusterIdList[j] == pBind->clusterIdList[i] )
+        {
+          break;
+        }
       }
-      else
+
+      if ( j == i )
       {
-        return ( pBind );
+        n = (uint16)x * MAX_BINDING_CLUSTER_IDS + i;
+        bucket = BIND_HASH( pBind->srcEP, pBind->clusterIdList[i] );
+        bindHashNext[n] = bindHashHead[bucket];
+        bindHashHead[bucket] = n;
       }
     }
   }
 
-  return ( (BindingEntry_t *)NULL );
+  bindHashValid = TRUE;
 }
+#endif // BINDING_HASH_INDEX
 
 /*********************************************************************
  * @fn      bindAddressClear
@@ -1350,6 +1487,7 @@ uint16 BindRestoreFromNV( void )
   nvBindingHdr_t hdr;
 
   hdr.numRecs = 0;
+  BIND_HASH_INVALIDATE();
 
 #if !defined ( DONT_UPGRADE_BIND )
   if ( BindUpgradeTableInNV() == ZSuccess )
@@ -1381,7 +1519,9 @@ uint16 BindRestoreFromNV( void )
 /*********************************************************************
  * @fn          BindWriteNV
  *
- * @brief       Save the Binding Table in NV
+ * @brief       Save the Binding Table in NV. The records are written
+ *              with a single NV write so that any number of changed
+ *              records costs at most one item copy, then the header.
  *
  * @param       none
  *
@@ -1389,8 +1529,6 @@ uint16 BindRestoreFromNV( void )
  */
 void BindWriteNV( void )
 {
-  BindingEntry_t *pBind;
-  BindingEntry_t bind;
   nvBindingHdr_t hdr;
   bindTableIndex_t x;
 
@@ -1398,21 +1536,16 @@ void BindWriteNV( void )
 
   for ( x = 0; x < gNWK_MAX_BINDING_ENTRIES; x++ )
   {
-    pBind = &BindingTable[x];
-
-    osal_memcpy( &bind, pBind, gBIND_REC_SIZE );
-
-    // Save the record to NV
-    osal_nv_write( ZCD_NV_BINDING_TABLE,
-                   (uint16)((sizeof(nvBindingHdr_t)) + (x * NV_BIND_REC_SIZE)),
-                   NV_BIND_REC_SIZE, &bind );
-
-    if ( pBind->srcEP != NV_BIND_EMPTY )
+    if ( BindingTable[x].srcEP != NV_BIND_EMPTY )
     {
       hdr.numRecs++;
     }
   }
 
+  // Save the records to NV
+  osal_nv_write( ZCD_NV_BINDING_TABLE, (uint16)(sizeof(nvBindingHdr_t)),
+                 NV_BIND_ITEM_SIZE, BindingTable );
+
   // Save off the header
   osal_nv_write( ZCD_NV_BINDING_TABLE, 0, sizeof(nvBindingHdr_t), &hdr );
 }
@@ -1478,6 +1611,8 @@ uint16 BindRestoreFromNV( void )
   bindTableIndex_t x;
   uint16 validRecsCount = 0;
 
+  BIND_HASH_INVALIDATE();
+
   // Read in the device list
   for ( x = 0; x < gNWK_MAX_BINDING_ENTRIES; x++ )
   {
@@ -0,0 +1,921 @@
+/**************************************************************************************************
+  Filename:       aps_posix.c
+  Revised:        $Date$
+  Revision:       $Revision$
+
+  Description:    APS layer stand-in for the host (POSIX) process, with
+                  loopback delivery of frames addressed to this device.
+
+
+  Copyright 2026 The Z-Stack host port authors.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+
+    Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+    Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+    Neither the name of the copyright holder nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************************************************/
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include "ZComDef.h"
+#include "OSAL.h"
+#include "OSAL_Nv.h"
+#include "AF.h"
+#include "APS.h"
+#include "APSMEDE.h"
+#include "aps_frag.h"
+#include "aps_groups.h"
+#include "AddrMgr.h"
+#include "BindingTable.h"
+#include "nwk.h"
+#include "nwk_util.h"
+#include "nwk_globals.h"
+#include "NLMEDE.h"
+#include "ZDSecMgr.h"
+#include "ZGlobals.h"
+
+/*********************************************************************
+ * CONSTANTS
+ */
+// APS task event: deliver the queued frames
+#define APS_POSIX_DELIVER_EVT      0x0001
+
+// Frame overhead taken from the MAC frame: MAC, NWK and APS headers
+#define APS_POSIX_HDR_LEN          (11 + 8 + 8)
+
+#if !defined ( APS_MAX_GROUPS )
+  #define APS_MAX_GROUPS           16
+#endif
+
+/*********************************************************************
+ * TYPEDEFS
+ */
+// A data request waiting to be delivered or confirmed
+typedef struct apsPosixFrame
+{
+  struct apsPosixFrame *next;
+  APSDE_DataReq_t       req;
+  uint8                 local;   // TRUE if addressed to this device
+} apsPosixFrame_t;
+
+/*********************************************************************
+ * GLOBAL VARIABLES
+ */
+uint8 APS_Counter = 0;
+
+uint16 AIB_MaxBindingTime = 0;
+uint8  AIB_apsUseExtendedPANID[Z_EXTADDR_LEN] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+static uint8 apsPosixTCAddr[Z_EXTADDR_LEN];
+uint8 *AIB_apsTrustCenterAddress = apsPosixTCAddr;
+
+APSF_SendFragmented_t *apsfSendFragmented = NULL;
+
+apsGroupItem_t *apsGroupTable = NULL;
+
+byte APS_TaskID;
+
+/*********************************************************************
+ * LOCAL VARIABLES
+ */
+static apsPosixFrame_t *apsPosixQueue = NULL;
+
+/*********************************************************************
+ * LOCAL FUNCTIONS
+ */
+static uint8 apsPosixIsLocal( zAddrType_t *dstAddr );
+static void apsPosixEnqueue( APSDE_DataReq_t *req, zAddrType_t *dstAddr, uint8 dstEP );
+static void apsPosixDeliver( apsPosixFrame_t *pFrame );
+
+/*********************************************************************
+ * @fn      APS_Init
+ *
+ * @brief   Initialize the APS task. The host build has no radio, so only
+ *          frames addressed to this device are delivered, through a
+ *          loopback in the APS task.
+ *
+ * @param   task_id - OSAL task ID of the APS task
+ *
+ * @return  none
+ */
+void APS_Init( byte task_id )
+{
+  APS_TaskID = task_id;
+
+  osal_memset( apsPosixTCAddr, 0, Z_EXTADDR_LEN );
+}
+
+/*********************************************************************
+ * @fn      APS_event_loop
+ *
+ * @brief   APS task event loop.
+ *
+ * @param   task_id - OSAL task ID of the APS task
+ * @param   events - pending events
+ *
+ * @return  events not processed
+ */
+UINT16 APS_event_loop( byte task_id, UINT16 events )
+{
+  uint8 *msgPtr;
+
+  if ( events & SYS_EVENT_MSG )
+  {
+    while ( (msgPtr = osal_msg_receive( task_id )) != NULL )
+    {
+      osal_msg_deallocate( msgPtr );
+    }
+
+    return ( events ^ SYS_EVENT_MSG );
+  }
+
+  if ( events & APS_POSIX_DELIVER_EVT )
+  {
+    apsPosixFrame_t *pFrame;
+
+    // Detach the queue first, a delivered frame may queue a response
+    pFrame = apsPosixQueue;
+    apsPosixQueue = NULL;
+
+    while ( pFrame != NULL )
+    {
+      apsPosixFrame_t *pNext = pFrame->next;
+
+      apsPosixDeliver( pFrame );
+      osal_mem_free( pFrame );
+
+      pFrame = pNext;
+    }
+
+    return ( events ^ APS_POSIX_DELIVER_EVT );
+  }
+
+  return 0;
+}
+
+/*********************************************************************
+ * @fn      apsPosixIsLocal
+ *
+ * @brief   Check whether a destination address reaches this device.
+ *
+ * @param   dstAddr - destination address
+ *
+ * @return  TRUE if the frame is to be delivered locally
+ */
+static uint8 apsPosixIsLocal( zAddrType_t *dstAddr )
+{
+  switch ( dstAddr->addrMode )
+  {
+    case Addr16Bit:
+      return ( dstAddr->addr.shortAddr == NLME_GetShortAddr() );
+
+    case Addr64Bit:
+      return ( osal_ExtAddrEqual( dstAddr->addr.extAddr, NLME_GetExtAddr() ) );
+
+    case AddrBroadcast:
+      return ( NLME_IsAddressBroadcast( dstAddr->addr.shortAddr ) == ADDR_BCAST_FOR_ME );
+
+    case AddrGroup:
+      return ( aps_FindGroupForEndpoint( dstAddr->addr.shortAddr, APS_GROUPS_FIND_FIRST )
+               != APS_GROUPS_EP_NOT_FOUND );
+
+    default:
+      return ( FALSE );
+  }
+}
+
+/*********************************************************************
+ * @fn      apsPosixEnqueue
+ *
+ * @brief   Queue a copy of a data request for the APS task.
+ *
+ * @param   req - data request
+ * @param   dstAddr - resolved destination address
+ * @param   dstEP - resolved destination endpoint
+ *
+ * @return  none
+ */
+static void apsPosixEnqueue( APSDE_DataReq_t *req, zAddrType_t *dstAddr, uint8 dstEP )
+{
+  apsPosixFrame_t *pFrame;
+  apsPosixFrame_t **ppTail;
+
+  pFrame = osal_mem_alloc( sizeof( apsPosixFrame_t ) + req->asduLen );
+  if ( pFrame == NULL )
+  {
+    return;
+  }
+
+  pFrame->next = NULL;
+  pFrame->req = *req;
+  pFrame->req.dstAddr = *dstAddr;
+  pFrame->req.dstEP = dstEP;
+  pFrame->req.asdu = (uint8 *)(pFrame + 1);
+  osal_memcpy( pFrame->req.asdu, req->asdu, req->asduLen );
+  pFrame->local = apsPosixIsLocal( dstAddr );
+
+  for ( ppTail = &apsPosixQueue; *ppTail != NULL; ppTail = &(*ppTail)->next )
+  {
+  }
+  *ppTail = pFrame;
+
+  osal_set_event( APS_TaskID, APS_POSIX_DELIVER_EVT );
+}
+
+/*********************************************************************
+ * @fn      apsPosixDeliver
+ *
+ * @brief   Deliver a queued frame to the local endpoints and confirm it
+ *          to the sender. Self addressed unicasts are confirmed by AF.
+ *
+ * @param   pFrame - queued frame
+ *
+ * @return  none
+ */
+static void apsPosixDeliver( apsPosixFrame_t *pFrame )
+{
+  APSDE_DataReq_t *req = &pFrame->req;
+
+  if ( pFrame->local )
+  {
+    aps_FrameFormat_t aff;
+    zAddrType_t srcAddr;
+    NLDE_Signal_t sig;
+
+    osal_memset( &aff, 0, sizeof( aps_FrameFormat_t ) );
+
+    aff.FrmCtrl = APS_DATA_FRAME;
+    if ( req->dstAddr.addrMode == AddrGroup )
+    {
+      aff.FrmCtrl |= APS_FC_DM_GROUP;
+      aff.GroupID = req->dstAddr.addr.shortAddr;
+    }
+    else if ( req->dstAddr.addrMode == AddrBroadcast )
+    {
+      aff.FrmCtrl |= APS_FC_DM_BROADCAST;
+      aff.wasBroadcast = TRUE;
+    }
+
+    aff.DstEndPoint = req->dstEP;
+    aff.SrcEndPoint = req->srcEP;
+    aff.ClusterID = req->clusterID;
+    aff.ProfileID = req->profileID;
+    aff.macDestAddr = NLME_GetShortAddr();
+    aff.macSrcAddr = NLME_GetShortAddr();
+    aff.asdu = req->asdu;
+    aff.asduLength = (uint8)req->asduLen;
+    aff.ApsCounter = APS_Counter++;
+    aff.transID = req->transID;
+
+    srcAddr.addrMode = Addr16Bit;
+    srcAddr.addr.shortAddr = NLME_GetShortAddr();
+
+    sig.LinkQuality = 0xFF;
+    sig.correlation = 0;
+    sig.rssi = 0;
+
+    afIncomingData( &aff, &srcAddr, _NIB.nwkPanId, &sig, _NIB.SequenceNum++,
+                    FALSE, osal_GetSystemClock(), req->radiusCounter );
+  }
+
+  if ( (req->dstAddr.addrMode == Addr16Bit) &&
+       (req->dstAddr.addr.shortAddr == NLME_GetShortAddr()) )
+  {
+    return;
+  }
+
+  // Broadcasts and groups are complete once handed down, a unicast to
+  // another device has no route
+  if ( !pFrame->local &&
+       ((req->dstAddr.addrMode == Addr16Bit) || (req->dstAddr.addrMode == Addr64Bit)) )
+  {
+    afDataConfirm( req->srcEP, req->transID, ZNwkNoRoute );
+  }
+  else
+  {
+    afDataConfirm( req->srcEP, req->transID, ZSuccess );
+  }
+}
+
+/*********************************************************************
+ * @fn      APSDE_DataReq
+ *
+ * @brief   Send a data frame. Frames without a destination address go
+ *          to every matching binding.
+ *
+ * @param   req - data request
+ *
+ * @return  ZSuccess, ZApsNoBoundDevice or ZMemError
+ */
+ZStatus_t APSDE_DataReq( APSDE_DataReq_t* req )
+{
+  if ( req->dstAddr.addrMode == AddrNotPresent )
+  {
+    BindingEntry_t *pBind;
+    zAddrType_t dstAddr;
+    uint8 skip = 0;
+
+    while ( (pBind = bindFind( req->srcEP, req->clusterID, skip++ )) != NULL )
+    {
+      if ( pBind->dstGroupMode == DSTGROUPMODE_GROUP )
+      {
+        dstAddr.addrMode = AddrGroup;
+        dstAddr.addr.shortAddr = pBind->dstIdx;
+      }
+      else if ( bindingAddrMgsHelperConvert( pBind->dstIdx, &dstAddr ) == FALSE )
+      {
+        continue;
+      }
+
+      apsPosixEnqueue( req, &dstAddr, pBind->dstEP );
+    }
+
+    return ( (skip > 1) ? ZSuccess : ZApsNoBoundDevice );
+  }
+
+  if ( req->asduLen > MAC_MAX_FRAME_SIZE )
+  {
+    return ( ZMemError );
+  }
+
+  apsPosixEnqueue( req, &req->dstAddr, req->dstEP );
+
+  return ( ZSuccess );
+}
+
+/*********************************************************************
+ * @fn      APSDE_DataReqMTU
+ *
+ * @brief   Get the APS payload room of a frame.
+ *
+ * @param   fields - security and addressing of the frame
+ *
+ * @return  payload length
+ */
+uint8 APSDE_DataReqMTU( APSDE_DataReqMTU_t* fields )
+{
+  (void)fields;
+
+  return ( MAC_MAX_FRAME_SIZE - APS_POSIX_HDR_LEN );
+}
+
+/*********************************************************************
+ * @fn      APS_SetEndDeviceBindTimeout
+ *
+ * @brief   Set the end device bind timeout.
+ *
+ * @return  none
+ */
+void APS_SetEndDeviceBindTimeout( uint16 timeout, pfnBindingTimeoutCB pfnCB )
+{
+  (void)pfnCB;
+
+  AIB_MaxBindingTime = timeout;
+}
+
+/*********************************************************************
+ * @fn      APS_ReflectorInit
+ *
+ * @brief   Link in the reflector. Bindings are resolved by APSDE_DataReq().
+ *
+ * @return  none
+ */
+void APS_ReflectorInit( void )
+{
+}
+
+/*********************************************************************
+ * @fn      APSF_Init / APSF_ProcessEvent
+ *
+ * @brief   Fragmentation task. Frames over the MTU are refused, as
+ *          apsfSendFragmented is not set.
+ */
+void APSF_Init( uint8 task_id )
+{
+  (void)task_id;
+}
+
+UINT16 APSF_ProcessEvent( uint8 task_id, UINT16 events )
+{
+  uint8 *msgPtr;
+
+  if ( events & SYS_EVENT_MSG )
+  {
+    while ( (msgPtr = osal_msg_receive( task_id )) != NULL )
+    {
+      osal_msg_deallocate( msgPtr );
+    }
+  }
+
+  return 0;
+}
+
+/*********************************************************************
+ * @fn      APSME_BindRequest
+ *
+ * @brief   Add a binding table entry.
+ *
+ * @return  ZSuccess or ZApsTableFull
+ */
+ZStatus_t APSME_BindRequest( byte SrcEndpInt, uint16 ClusterId,
+                             zAddrType_t *DstAddr, byte DstEndpInt )
+{
+  if ( bindAddEntry( SrcEndpInt, DstAddr, DstEndpInt, 1, &ClusterId ) == NULL )
+  {
+    return ( ZApsTableFull );
+  }
+
+  return ( ZSuccess );
+}
+
+/*********************************************************************
+ * @fn      APSME_UnBindRequest
+ *
+ * @brief   Remove a cluster from a binding table entry, and the entry
+ *          when it has no cluster left.
+ *
+ * @return  ZSuccess or ZApsInvalidBinding
+ */
+ZStatus_t APSME_UnBindRequest( byte SrcEndpInt, uint16 ClusterId,
+                               zAddrType_t *DstAddr, byte DstEndpInt )
+{
+  BindingEntry_t *pBind = bindFindExisting( SrcEndpInt, DstAddr, DstEndpInt );
+
+  if ( (pBind == NULL) || !bindIsClusterIDinList( pBind, ClusterId ) )
+  {
+    return ( ZApsInvalidBinding );
+  }
+
+  if ( bindRemoveClusterIdFromList( pBind, ClusterId ) == FALSE )
+  {
+    bindRemoveEntry( pBind );
+  }
+
+  return ( ZSuccess );
+}
+
+/*********************************************************************
+ * @fn      APSME_GetRequest
+ *
+ * @brief   Read an AIB attribute.
+ *
+ * @return  ZSuccess or ZApsUnsupportedAttrib
+ */
+ZStatus_t APSME_GetRequest( ZApsAttributes_t AIBAttribute, uint16 Index, byte *AttributeValue )
+{
+  switch ( AIBAttribute )
+  {
+    case apsMaxBindingTime:
+      *((uint16 *)AttributeValue) = AIB_MaxBindingTime;
+      break;
+
+    case apsNumBindingTableEntries:
+      *((uint16 *)AttributeValue) = bindNumOfEntries();
+      break;
+
+    case apsBindingTable:
+    {
+      apsBindingItem_t *pItem = (apsBindingItem_t *)AttributeValue;
+      BindingEntry_t *pBind;
+      uint16 n = 0;
+
+      // Index counts one item per bound cluster
+      while ( (pBind = GetBindingTableEntry( n++ )) != NULL )
+      {
+        if ( Index < pBind->numClusterIds )
+        {
+          break;
+        }
+        Index -= pBind->numClusterIds;
+      }
+
+      if ( pBind == NULL )
+      {
+        return ( ZApsIllegalRequest );
+      }
+
+      osal_cpyExtAddr( pItem->srcAddr, NLME_GetExtAddr() );
+      pItem->srcEP = pBind->srcEP;
+      pItem->clusterID = pBind->clusterIdList[Index];
+      pItem->dstEP = pBind->dstEP;
+
+      if ( pBind->dstGroupMode == DSTGROUPMODE_GROUP )
+      {
+        pItem->dstAddr.addrMode = AddrGroup;
+        pItem->dstAddr.addr.shortAddr = pBind->dstIdx;
+      }
+      else
+      {
+        bindingAddrMgsHelperConvert( pBind->dstIdx, &pItem->dstAddr );
+      }
+      break;
+    }
+
+    case apsUseExtendedPANID:
+      osal_cpyExtAddr( AttributeValue, AIB_apsUseExtendedPANID );
+      break;
+
+    case apsTrustCenterAddress:
+      osal_cpyExtAddr( AttributeValue, AIB_apsTrustCenterAddress );
+      break;
+
+    default:
+      return ( ZApsUnsupportedAttrib );
+  }
+
+  return ( ZSuccess );
+}
+
+/*********************************************************************
+ * @fn      APSME_SetRequest
+ *
+ * @brief   Write an AIB attribute.
+ *
+ * @return  ZSuccess or ZApsUnsupportedAttrib
+ */
+ZStatus_t APSME_SetRequest( ZApsAttributes_t AIBAttribute, uint16 Index, byte *AttributeValue )
+{
+  (void)Index;
+
+  switch ( AIBAttribute )
+  {
+    case apsMaxBindingTime:
+      AIB_MaxBindingTime = *((uint16 *)AttributeValue);
+      break;
+
+    case apsUseExtendedPANID:
+      osal_cpyExtAddr( AIB_apsUseExtendedPANID, AttributeValue );
+      break;
+
+    case apsTrustCenterAddress:
+      osal_cpyExtAddr( AIB_apsTrustCenterAddress, AttributeValue );
+      break;
+
+    default:
+      return ( ZApsUnsupportedAttrib );
+  }
+
+  return ( ZSuccess );
+}
+
+/*********************************************************************
+ * @fn      APSME_LookupExtAddr
+ *
+ * @brief   Get the IEEE address of a network address.
+ *
+ * @return  TRUE if found
+ */
+uint8 APSME_LookupExtAddr( uint16 nwkAddr, uint8* extAddr )
+{
+  return ( AddrMgrExtAddrLookup( nwkAddr, extAddr ) );
+}
+
+/*********************************************************************
+ * @fn      APSME_LookupNwkAddr
+ *
+ * @brief   Get the network address of an IEEE address.
+ *
+ * @return  TRUE if found
+ */
+uint8 APSME_LookupNwkAddr( uint8* extAddr, uint16* nwkAddr )
+{
+  AddrMgrEntry_t entry;
+
+  entry.user = ADDRMGR_USER_DEFAULT;
+  osal_cpyExtAddr( entry.extAddr, extAddr );
+
+  if ( AddrMgrEntryLookupExt( &entry ) )
+  {
+    *nwkAddr = entry.nwkAddr;
+    return ( TRUE );
+  }
+
+  return ( FALSE );
+}
+
+/*********************************************************************
+ * @fn      APSME_HoldDataRequests
+ *
+ * @brief   Hold data requests for a time. Nothing is sent over the air,
+ *          so there is nothing to hold.
+ *
+ * @return  none
+ */
+void APSME_HoldDataRequests( uint16 holdTime )
+{
+  (void)holdTime;
+}
+
+/*********************************************************************
+ * @fn      APSME_IsDistributedSecurity
+ *
+ * @brief   Check for a distributed security network, indicated by a
+ *          trust center address of all ones.
+ *
+ * @return  TRUE if distributed
+ */
+uint8 APSME_IsDistributedSecurity( void )
+{
+  uint8 i;
+
+  for ( i = 0; i < Z_EXTADDR_LEN; i++ )
+  {
+    if ( AIB_apsTrustCenterAddress[i] != 0xFF )
+    {
+      return ( FALSE );
+    }
+  }
+
+  return ( TRUE );
+}
+
+/*********************************************************************
+ * @fn      APSME_SearchTCLinkKeyEntry
+ *
+ * @brief   Search the trust center link key table in NV.
+ *
+ * @param   pExt - extended address
+ * @param   found - set TRUE if found
+ * @param   tcLinkKeyAddrEntry - receives the entry found, may be NULL
+ *
+ * @return  NV ID of the entry found or of the first free entry,
+ *          0xFFFF if the table is full
+ */
+uint16 APSME_SearchTCLinkKeyEntry( uint8 *pExt, uint8* found, APSME_TCLKDevEntry_t* tcLinkKeyAddrEntry )
+{
+  APSME_TCLKDevEntry_t entry;
+  uint16 freeId = 0xFFFF;
+  uint16 i;
+
+  *found = FALSE;
+
+  for ( i = 0; i < gZDSECMGR_TC_DEVICE_MAX; i++ )
+  {
+    if ( (osal_nv_read( ZCD_NV_TCLK_TABLE_START + i, 0,
+                        sizeof( APSME_TCLKDevEntry_t ), &entry ) != SUCCESS) ||
+         !AddrMgrExtAddrValid( entry.extAddr ) )
+    {
+      if ( freeId == 0xFFFF )
+      {
+        freeId = ZCD_NV_TCLK_TABLE_START + i;
+      }
+    }
+    else if ( osal_ExtAddrEqual( entry.extAddr, pExt ) )
+    {
+      if ( tcLinkKeyAddrEntry != NULL )
+      {
+        osal_memcpy( tcLinkKeyAddrEntry, &entry, sizeof( APSME_TCLKDevEntry_t ) );
+      }
+
+      *found = TRUE;
+      return ( ZCD_NV_TCLK_TABLE_START + i );
+    }
+  }
+
+  return ( freeId );
+}
+
+/*********************************************************************
+ * Key transport - no other device can join, so no key is ever sent.
+ */
+
+void APSME_SecurityCM_CD( void )
+{
+}
+
+ZStatus_t APSME_TransportKeyReq( APSME_TransportKeyReq_t* req )
+{
+  (void)req;
+
+  return ( ZNwkUnknownDevice );
+}
+
+ZStatus_t APSME_RemoveDeviceReq( APSME_RemoveDeviceReq_t* req )
+{
+  (void)req;
+
+  return ( ZNwkUnknownDevice );
+}
+
+ZStatus_t APSME_ConfirmKeyReq( APSME_ConfirmKeyReq_t* req )
+{
+  (void)req;
+
+  return ( ZNwkUnknownDevice );
+}
+
+// Install code keys need the MMO hash, which the host does not provide.
+ZStatus_t APSME_AddTCLinkKey( uint8* pTCLinkKey, uint8* pExt )
+{
+  (void)pTCLinkKey;
+  (void)pExt;
+
+  return ( ZFailure );
+}
+
+void APSME_EraseICEntry( uint8 *IcIndex )
+{
+  (void)IcIndex;
+}
+
+/*********************************************************************
+ * APS groups
+ */
+
+/*********************************************************************
+ * @fn      aps_AddGroup
+ *
+ * @brief   Add a group for an endpoint.
+ *
+ * @return  ZSuccess, ZApsDuplicateEntry, ZApsTableFull or ZMemError
+ */
+ZStatus_t aps_AddGroup( uint8 endpoint, aps_Group_t *group )
+{
+  apsGroupItem_t *pItem;
+  apsGroupItem_t **ppTail;
+
+  if ( aps_FindGroup( endpoint, group->ID ) != NULL )
+  {
+    return ( ZApsDuplicateEntry );
+  }
+
+  if ( aps_CountAllGroups() >= APS_MAX_GROUPS )
+  {
+    return ( ZApsTableFull );
+  }
+
+  pItem = osal_mem_alloc( sizeof( apsGroupItem_t ) );
+  if ( pItem == NULL )
+  {
+    return ( ZMemError );
+  }
+
+  pItem->next = NULL;
+  pItem->endpoint = endpoint;
+  osal_memcpy( &pItem->group, group, sizeof( aps_Group_t ) );
+
+  for ( ppTail = &apsGroupTable; *ppTail != NULL; ppTail = &(*ppTail)->next )
+  {
+  }
+  *ppTail = pItem;
+
+  return ( ZSuccess );
+}
+
+aps_Group_t *aps_FindGroup( uint8 endpoint, uint16 groupID )
+{
+  apsGroupItem_t *pItem;
+
+  for ( pItem = apsGroupTable; pItem != NULL; pItem = pItem->next )
+  {
+    if ( (pItem->endpoint == endpoint) && (pItem->group.ID == groupID) )
+    {
+      return ( &pItem->group );
+    }
+  }
+
+  return ( NULL );
+}
+
+/*********************************************************************
+ * @fn      aps_FindGroupForEndpoint
+ *
+ * @brief   Find the next endpoint in a group.
+ *
+ * @param   groupID - group
+ * @param   lastEP - endpoint returned by the previous call, or
+ *                   APS_GROUPS_FIND_FIRST
+ *
+ * @return  endpoint, or APS_GROUPS_EP_NOT_FOUND
+ */
+uint8 aps_FindGroupForEndpoint( uint16 groupID, uint8 lastEP )
+{
+  apsGroupItem_t *pItem;
+  uint8 skip = (lastEP != APS_GROUPS_FIND_FIRST);
+
+  for ( pItem = apsGroupTable; pItem != NULL; pItem = pItem->next )
+  {
+    if ( pItem->group.ID != groupID )
+    {
+      continue;
+    }
+
+    if ( skip )
+    {
+      skip = (pItem->endpoint != lastEP);
+    }
+    else
+    {
+      return ( pItem->endpoint );
+    }
+  }
+
+  return ( APS_GROUPS_EP_NOT_FOUND );
+}
+
+uint8 aps_FindAllGroupsForEndpoint( uint8 endpoint, uint16 *groupList )
+{
+  apsGroupItem_t *pItem;
+  uint8 cnt = 0;
+
+  for ( pItem = apsGroupTable; pItem != NULL; pItem = pItem->next )
+  {
+    if ( pItem->endpoint == endpoint )
+    {
+      groupList[cnt++] = pItem->group.ID;
+    }
+  }
+
+  return ( cnt );
+}
+
+uint8 aps_RemoveGroup( uint8 endpoint, uint16 groupID )
+{
+  apsGroupItem_t **ppItem;
+
+  for ( ppItem = &apsGroupTable; *ppItem != NULL; ppItem = &(*ppItem)->next )
+  {
+    if ( ((*ppItem)->endpoint == endpoint) && ((*ppItem)->group.ID == groupID) )
+    {
+      apsGroupItem_t *pFree = *ppItem;
+
+      *ppItem = pFree->next;
+      osal_mem_free( pFree );
+      return ( TRUE );
+    }
+  }
+
+  return ( FALSE );
+}
+
+void aps_RemoveAllGroup( uint8 endpoint )
+{
+  apsGroupItem_t **ppItem = &apsGroupTable;
+
+  while ( *ppItem != NULL )
+  {
+    if ( (*ppItem)->endpoint == endpoint )
+    {
+      apsGroupItem_t *pFree = *ppItem;
+
+      *ppItem = pFree->next;
+      osal_mem_free( pFree );
+    }
+    else
+    {
+      ppItem = &(*ppItem)->next;
+    }
+  }
+}
+
+uint8 aps_CountGroups( uint8 endpoint )
+{
+  apsGroupItem_t *pItem;
+  uint8 cnt = 0;
+
+  for ( pItem = apsGroupTable; pItem != NULL; pItem = pItem->next )
+  {
+    cnt += (pItem->endpoint == endpoint);
+  }
+
+  return ( cnt );
+}
+
+uint8 aps_CountAllGroups( void )
+{
+  apsGroupItem_t *pItem;
+  uint8 cnt = 0;
+
+  for ( pItem = apsGroupTable; pItem != NULL; pItem = pItem->next )
+  {
+    cnt++;
+  }
+
+  return ( cnt );
+}
+
+/*********************************************************************
+*********************************************************************/
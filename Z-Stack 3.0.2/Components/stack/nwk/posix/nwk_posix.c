@@ -0,0 +1,1257 @@
+/**************************************************************************************************
+  Filename:       nwk_posix.c
+  Revised:        $Date$
+  Revision:       $Revision$
+
+  Description:    NWK layer stand-in for the host (POSIX) process. The
+                  device forms and runs its own single node network.
+
+
+  Copyright 2026 The Z-Stack host port authors.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+
+    Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+    Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+    Neither the name of the copyright holder nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************************************************/
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include "ZComDef.h"
+#include "OSAL.h"
+#include "OSAL_Nv.h"
+#include "AddrMgr.h"
+#include "AssocList.h"
+#include "BindingTable.h"
+#include "nwk.h"
+#include "nwk_util.h"
+#include "NLMEDE.h"
+#include "rtg.h"
+#include "ssp.h"
+#include "ssp_hash.h"
+#include "ZDApp.h"
+#include "ZDSecMgr.h"
+#include "ZGlobals.h"
+#include "nwk_globals.h"
+#include "ZMAC.h"
+
+/*********************************************************************
+ * CONSTANTS
+ */
+// NWK task events, used to return the confirms asynchronously
+#define NWK_POSIX_FORMATION_CNF_EVT      0x0001
+#define NWK_POSIX_START_ROUTER_CNF_EVT   0x0002
+#define NWK_POSIX_DISCOVERY_CNF_EVT      0x0004
+#define NWK_POSIX_PERMIT_JOIN_EVT        0x0008
+
+// Delay before a confirm is returned, in msecs
+#define NWK_POSIX_CNF_DELAY              10
+
+#define NWK_POSIX_ENERGY_THRESHOLD       0x28
+
+/*********************************************************************
+ * GLOBAL VARIABLES
+ */
+nwkIB_t _NIB;
+byte NWK_TaskID;
+
+uint8 saveExtAddr[Z_EXTADDR_LEN];
+
+uint32 nwkFrameCounter = 0;
+uint16 nwkFrameCounterChanges = 0;
+
+void (*pNwkNotMyChildListDelete)( uint16 devAddr ) = NULL;
+
+/*********************************************************************
+ * LOCAL VARIABLES
+ */
+// Address manager entries: the device itself and the addresses users added
+static AddrMgrEntry_t nwkPosixAddrTable[NWK_MAX_ADDRESSES];
+
+static uint8 nwkPosixBcastFilter = NWK_BROADCAST_FILTER_ANY;
+static uint8 nwkPosixEnergyThreshold = NWK_POSIX_ENERGY_THRESHOLD;
+
+/*********************************************************************
+ * LOCAL FUNCTIONS
+ */
+static void nwkPosixStart( void );
+static uint8 nwkPosixAddrUserMatch( AddrMgrEntry_t *item, uint8 user );
+
+/*********************************************************************
+ * @fn      nwk_init
+ *
+ * @brief   Initialize the NWK task. The host build has no radio, so the
+ *          NWK layer only keeps the NIB and brings the device up as the
+ *          only member of its own network.
+ *
+ * @param   task_id - OSAL task ID of the NWK task
+ *
+ * @return  none
+ */
+void nwk_init( byte task_id )
+{
+  NWK_TaskID = task_id;
+
+  osal_memset( nwkPosixAddrTable, 0xFF, sizeof( nwkPosixAddrTable ) );
+
+  NIB_init();
+  ZMacGetReq( ZMacExtAddr, saveExtAddr );
+}
+
+/*********************************************************************
+ * @fn      nwk_event_loop
+ *
+ * @brief   NWK task event loop. Returns the confirms of the requests
+ *          made by ZDO.
+ *
+ * @param   task_id - OSAL task ID of the NWK task
+ * @param   events - pending events
+ *
+ * @return  events not processed
+ */
+UINT16 nwk_event_loop( byte task_id, UINT16 events )
+{
+  uint8 *msgPtr;
+
+  if ( events & SYS_EVENT_MSG )
+  {
+    while ( (msgPtr = osal_msg_receive( task_id )) != NULL )
+    {
+      osal_msg_deallocate( msgPtr );
+    }
+
+    return ( events ^ SYS_EVENT_MSG );
+  }
+
+  if ( events & NWK_POSIX_FORMATION_CNF_EVT )
+  {
+    ZDO_NetworkFormationConfirmCB( ZSuccess );
+    return ( events ^ NWK_POSIX_FORMATION_CNF_EVT );
+  }
+
+  if ( events & NWK_POSIX_START_ROUTER_CNF_EVT )
+  {
+    ZDO_StartRouterConfirmCB( ZSuccess );
+    return ( events ^ NWK_POSIX_START_ROUTER_CNF_EVT );
+  }
+
+  if ( events & NWK_POSIX_DISCOVERY_CNF_EVT )
+  {
+    (void)ZDO_NetworkDiscoveryConfirmCB( ZNwkNoNetworks );
+    return ( events ^ NWK_POSIX_DISCOVERY_CNF_EVT );
+  }
+
+  if ( events & NWK_POSIX_PERMIT_JOIN_EVT )
+  {
+    ZDO_PermitJoinCB( 0 );
+    return ( events ^ NWK_POSIX_PERMIT_JOIN_EVT );
+  }
+
+  return 0;
+}
+
+/*********************************************************************
+ * @fn      nwkPosixStart
+ *
+ * @brief   Load the NIB addressing into the MAC.
+ *
+ * @param   none
+ *
+ * @return  none
+ */
+static void nwkPosixStart( void )
+{
+  uint8 rxOnIdle = TRUE;
+
+  ZMacSetReq( ZMacShortAddress, (byte *)&_NIB.nwkDevAddress );
+  ZMacSetReq( ZMacPanId, (byte *)&_NIB.nwkPanId );
+  ZMacSetReq( ZMacChannel, &_NIB.nwkLogicalChannel );
+  ZMacSetReq( ZMacRxOnIdle, &rxOnIdle );
+
+  _NIB.nwkState = NWK_ROUTER;
+}
+
+/*********************************************************************
+ * @fn      NLME_NetworkFormationRequest
+ *
+ * @brief   Form a network. The lowest channel of ScanChannels is used
+ *          and a random PAN ID is chosen if none is given.
+ *
+ * @return  ZSuccess, or ZNwkInvalidRequest if no channel is given
+ */
+ZStatus_t NLME_NetworkFormationRequest( uint16 PanId, uint8* ExtendedPANID, uint32 ScanChannels,
+                                        byte ScanDuration, byte BeaconOrder,
+                                        byte SuperframeOrder, byte BatteryLifeExtension,
+                                        bool DistributedNetwork, uint16 DistributedNetworkAddress )
+{
+  uint8 channel;
+
+  (void)ScanDuration;
+  (void)BatteryLifeExtension;
+
+  for ( channel = 0; channel < 32; channel++ )
+  {
+    if ( ScanChannels & ((uint32)1 << channel) )
+    {
+      break;
+    }
+  }
+
+  if ( channel == 32 )
+  {
+    return ( ZNwkInvalidRequest );
+  }
+
+  while ( (PanId == 0xFFFF) || (PanId == 0x0000) )
+  {
+    PanId = osal_rand() & 0x3FFF;
+  }
+
+  _NIB.nwkDevAddress = DistributedNetwork ? DistributedNetworkAddress : NWK_PAN_COORD_ADDR;
+  _NIB.nwkCoordAddress = INVALID_NODE_ADDR;
+  _NIB.nwkPanId = PanId;
+  _NIB.nwkLogicalChannel = channel;
+  _NIB.channelList = ScanChannels;
+  _NIB.beaconOrder = BeaconOrder;
+  _NIB.superFrameOrder = SuperframeOrder;
+  _NIB.nodeDepth = 0;
+
+  if ( nwk_ExtPANIDValid( ExtendedPANID ) )
+  {
+    osal_cpyExtAddr( _NIB.extendedPANID, ExtendedPANID );
+  }
+  else
+  {
+    osal_cpyExtAddr( _NIB.extendedPANID, saveExtAddr );
+  }
+
+  nwkPosixStart();
+
+  osal_start_timerEx( NWK_TaskID, NWK_POSIX_FORMATION_CNF_EVT, NWK_POSIX_CNF_DELAY );
+
+  return ( ZSuccess );
+}
+
+/*********************************************************************
+ * @fn      NLME_StartRouterRequest
+ *
+ * @brief   Resume as a router on the network held in the NIB.
+ *
+ * @return  ZSuccess
+ */
+ZStatus_t NLME_StartRouterRequest( byte BeaconOrder, byte SuperframeOrder,
+                                   byte BatteryLifeExtension )
+{
+  (void)BeaconOrder;
+  (void)SuperframeOrder;
+  (void)BatteryLifeExtension;
+
+  nwkPosixStart();
+
+  osal_start_timerEx( NWK_TaskID, NWK_POSIX_START_ROUTER_CNF_EVT, NWK_POSIX_CNF_DELAY );
+
+  return ( ZSuccess );
+}
+
+/*********************************************************************
+ * @fn      NLME_NetworkDiscoveryRequest
+ *
+ * @brief   Scan for networks. There is no radio, so the confirm always
+ *          reports that no network was found.
+ *
+ * @return  ZSuccess
+ */
+ZStatus_t NLME_NetworkDiscoveryRequest( uint32 ScanChannels, uint8 scanDuration )
+{
+  (void)ScanChannels;
+  (void)scanDuration;
+
+  osal_start_timerEx( NWK_TaskID, NWK_POSIX_DISCOVERY_CNF_EVT, NWK_POSIX_CNF_DELAY );
+
+  return ( ZSuccess );
+}
+
+/*********************************************************************
+ * @fn      NLME_NwkDiscReq2
+ *
+ * @brief   Scan for routers without changing the NWK state.
+ *
+ * @return  ZNwkNoNetworks
+ */
+ZStatus_t NLME_NwkDiscReq2( NLME_ScanFields_t* fields )
+{
+  (void)fields;
+
+  return ( ZNwkNoNetworks );
+}
+
+/*********************************************************************
+ * @fn      NLME_NwkDiscTerm
+ *
+ * @brief   Clean up after NLME_NwkDiscReq2().
+ *
+ * @param   none
+ *
+ * @return  none
+ */
+void NLME_NwkDiscTerm( void )
+{
+}
+
+/*********************************************************************
+ * @fn      nwk_getNwkDescList
+ *
+ * @brief   Get the networks found by discovery.
+ *
+ * @param   none
+ *
+ * @return  NULL, as none are ever found
+ */
+networkDesc_t *nwk_getNwkDescList( void )
+{
+  return ( NULL );
+}
+
+/*********************************************************************
+ * @fn      NLME_JoinRequest
+ *
+ * @brief   Join a network found by discovery. Never called, as discovery
+ *          finds no network.
+ *
+ * @return  ZNwkNotPermitted
+ */
+ZStatus_t NLME_JoinRequest( uint8 *extendedPANID, uint16 PanId,
+                            uint8 channel, uint8 CapabilityFlags,
+                            uint16 chosenParent, uint8 parentDepth )
+{
+  (void)extendedPANID;
+  (void)PanId;
+  (void)channel;
+  (void)CapabilityFlags;
+  (void)chosenParent;
+  (void)parentDepth;
+
+  return ( ZNwkNotPermitted );
+}
+
+/*********************************************************************
+ * @fn      NLME_DirectJoinRequest
+ *
+ * @brief   Join another device directly to this one.
+ *
+ * @return  ZNwkNotPermitted
+ */
+ZStatus_t NLME_DirectJoinRequest( byte *DevExtAddress, byte capInfo )
+{
+  (void)DevExtAddress;
+  (void)capInfo;
+
+  return ( ZNwkNotPermitted );
+}
+
+/*********************************************************************
+ * @fn      NLME_PermitJoiningRequest
+ *
+ * @brief   Open or close the network for joining.
+ *
+ * @param   PermitDuration - seconds; 0 closes, 0xFF opens without limit
+ *
+ * @return  ZSuccess
+ */
+ZStatus_t NLME_PermitJoiningRequest( byte PermitDuration )
+{
+  osal_stop_timerEx( NWK_TaskID, NWK_POSIX_PERMIT_JOIN_EVT );
+
+  if ( (PermitDuration != 0) && (PermitDuration != 0xFF) )
+  {
+    osal_start_timerEx( NWK_TaskID, NWK_POSIX_PERMIT_JOIN_EVT, (uint32)PermitDuration * 1000 );
+  }
+
+  ZDO_PermitJoinCB( PermitDuration );
+
+  return ( ZSuccess );
+}
+
+/*********************************************************************
+ * @fn      NLME_SetAssocFlags
+ *
+ * @brief   Update the beacon association flags. There is no beacon.
+ *
+ * @param   none
+ *
+ * @return  none
+ */
+void NLME_SetAssocFlags( void )
+{
+}
+
+/*********************************************************************
+ * @fn      NLME_LeaveReq
+ *
+ * @brief   Leave the network.
+ *
+ * @return  ZNwkInvalidRequest, as there is no network to announce to
+ */
+ZStatus_t NLME_LeaveReq( NLME_LeaveReq_t* req )
+{
+  (void)req;
+
+  return ( ZNwkInvalidRequest );
+}
+
+/*********************************************************************
+ * @fn      NLME_ResetRequest
+ *
+ * @brief   Reset the NWK layer.
+ *
+ * @return  ZSuccess
+ */
+ZStatus_t NLME_ResetRequest( void )
+{
+  NIB_init();
+
+  return ( ZSuccess );
+}
+
+/*********************************************************************
+ * @fn      NLME_EDScanRequest
+ *
+ * @brief   Energy detect scan.
+ *
+ * @return  ZNwkInvalidRequest, as there is no radio
+ */
+ZStatus_t NLME_EDScanRequest( uint32 ScanChannels, uint8 scanDuration )
+{
+  (void)ScanChannels;
+  (void)scanDuration;
+
+  return ( ZNwkInvalidRequest );
+}
+
+/*********************************************************************
+ * @fn      NLME_GetRequest
+ *
+ * @brief   Read a NIB attribute. The neighbor and routing tables are
+ *          empty.
+ *
+ * @return  ZSuccess or ZNwkUnsupportedAttribute
+ */
+ZStatus_t NLME_GetRequest( ZNwkAttributes_t NIBAttribute, uint16 Index, void *Value )
+{
+  (void)Index;
+
+  switch ( NIBAttribute )
+  {
+    case nwkNumNeighborTableEntries:
+    case nwkNumRoutingTableEntries:
+      *((uint8 *)Value) = 0;
+      break;
+
+    case nwkProtocolVersion:
+      *((uint8 *)Value) = _NIB.nwkProtocolVersion;
+      break;
+
+    case nwkCapabilityInfo:
+      *((uint8 *)Value) = _NIB.CapabilityFlags;
+      break;
+
+    case nwkTransactionPersistenceTime:
+      *((uint16 *)Value) = _NIB.TransactionPersistenceTime;
+      break;
+
+    case nwkNwkState:
+      *((uint8 *)Value) = (uint8)_NIB.nwkState;
+      break;
+
+    default:
+      return ( ZNwkUnsupportedAttribute );
+  }
+
+  return ( ZSuccess );
+}
+
+/*********************************************************************
+ * @fn      NLME_GetShortAddr
+ *
+ * @brief   Get this device's network address.
+ *
+ * @return  network address
+ */
+uint16 NLME_GetShortAddr( void )
+{
+  return ( _NIB.nwkDevAddress );
+}
+
+/*********************************************************************
+ * @fn      NLME_GetExtAddr
+ *
+ * @brief   Get this device's IEEE address.
+ *
+ * @return  pointer to the IEEE address
+ */
+byte *NLME_GetExtAddr( void )
+{
+  return ( saveExtAddr );
+}
+
+/*********************************************************************
+ * @fn      NLME_GetCoordShortAddr
+ *
+ * @brief   Get the parent's network address.
+ *
+ * @return  parent network address
+ */
+uint16 NLME_GetCoordShortAddr( void )
+{
+  return ( _NIB.nwkCoordAddress );
+}
+
+/*********************************************************************
+ * @fn      NLME_GetCoordExtAddr
+ *
+ * @brief   Get the parent's IEEE address.
+ *
+ * @param   buf - receives the IEEE address
+ *
+ * @return  none
+ */
+void NLME_GetCoordExtAddr( byte *buf )
+{
+  osal_cpyExtAddr( buf, _NIB.nwkCoordExtAddress );
+}
+
+/*********************************************************************
+ * @fn      NLME_GetProtocolVersion
+ *
+ * @brief   Get the NWK protocol version.
+ *
+ * @param   none
+ *
+ * @return  protocol version
+ */
+byte NLME_GetProtocolVersion( void )
+{
+  return ( _NIB.nwkProtocolVersion );
+}
+
+/*********************************************************************
+ * @fn      NLME_SetPollRate
+ *
+ * @brief   Set the end device poll rate. Nothing to poll on the host.
+ *
+ * @param   newRate - poll rate in msecs
+ *
+ * @return  none
+ */
+void NLME_SetPollRate( uint32 newRate )
+{
+  (void)newRate;
+}
+
+/*********************************************************************
+ * @fn      NLME_SetUpdateID
+ *
+ * @brief   Set the network update ID.
+ *
+ * @param   updateID - new update ID
+ *
+ * @return  none
+ */
+void NLME_SetUpdateID( uint8 updateID )
+{
+  _NIB.nwkUpdateId = updateID;
+}
+
+/*********************************************************************
+ * @fn      NLME_GetEnergyThreshold
+ *
+ * @brief   Get the energy level above which a channel is busy.
+ *
+ * @return  energy threshold
+ */
+uint8 NLME_GetEnergyThreshold( void )
+{
+  return ( nwkPosixEnergyThreshold );
+}
+
+/*********************************************************************
+ * @fn      NLME_SetEnergyThreshold
+ *
+ * @brief   Set the energy level above which a channel is busy.
+ *
+ * @param   value - energy threshold
+ *
+ * @return  none
+ */
+void NLME_SetEnergyThreshold( uint8 value )
+{
+  nwkPosixEnergyThreshold = value;
+}
+
+/*********************************************************************
+ * @fn      NLME_SetBroadcastFilter
+ *
+ * @brief   Set the broadcast addresses this device responds to from its
+ *          capabilities.
+ *
+ * @param   capabilities - MAC capability flags
+ *
+ * @return  none
+ */
+void NLME_SetBroadcastFilter( byte capabilities )
+{
+  nwkPosixBcastFilter = NWK_BROADCAST_FILTER_DEVALL;
+
+  if ( capabilities & CAPINFO_RCVR_ON_IDLE )
+  {
+    nwkPosixBcastFilter |= NWK_BROADCAST_FILTER_DEVRXON;
+  }
+
+  if ( capabilities & CAPINFO_DEVICETYPE_FFD )
+  {
+    nwkPosixBcastFilter |= NWK_BROADCAST_FILTER_DEVZCZR;
+  }
+}
+
+/*********************************************************************
+ * @fn      NLME_IsAddressBroadcast
+ *
+ * @brief   Classify a network address against the broadcast filter.
+ *
+ * @param   shortAddress - network address
+ *
+ * @return  ADDR_NOT_BCAST, ADDR_BCAST_NOT_ME or ADDR_BCAST_FOR_ME
+ */
+addr_filter_t NLME_IsAddressBroadcast( uint16 shortAddress )
+{
+  uint8 filter;
+
+  if ( shortAddress < NWK_BROADCAST_SHORTADDR_RESRVD_F8 )
+  {
+    return ( ADDR_NOT_BCAST );
+  }
+
+  switch ( shortAddress )
+  {
+    case NWK_BROADCAST_SHORTADDR_DEVALL:
+      filter = NWK_BROADCAST_FILTER_DEVALL;
+      break;
+
+    case NWK_BROADCAST_SHORTADDR_DEVRXON:
+      filter = NWK_BROADCAST_FILTER_DEVRXON;
+      break;
+
+    case NWK_BROADCAST_SHORTADDR_DEVZCZR:
+      filter = NWK_BROADCAST_FILTER_DEVZCZR;
+      break;
+
+    default:
+      filter = NWK_BROADCAST_FILTER_RESRVD;
+      break;
+  }
+
+  return ( (nwkPosixBcastFilter & filter) ? ADDR_BCAST_FOR_ME : ADDR_BCAST_NOT_ME );
+}
+
+/*********************************************************************
+ * @fn      NLME_CheckNewAddrSet
+ *
+ * @brief   Check a short/IEEE address pair against the address manager.
+ *
+ * @return  ZSuccess if known and matching, ZFailure on a conflict,
+ *          ZUnsupportedMode if unknown
+ */
+ZStatus_t NLME_CheckNewAddrSet( uint16 shortAddr, uint8 *extAddr )
+{
+  AddrMgrEntry_t entry;
+
+  entry.user = ADDRMGR_USER_DEFAULT;
+  entry.nwkAddr = shortAddr;
+
+  if ( AddrMgrEntryLookupNwk( &entry ) == FALSE )
+  {
+    return ( ZUnsupportedMode );
+  }
+
+  return ( osal_ExtAddrEqual( entry.extAddr, extAddr ) ? ZSuccess : ZFailure );
+}
+
+/*********************************************************************
+ * @fn      NLME_CoordinatorInit
+ *
+ * @brief   Link in the coordinator functions. Nothing to do on the host.
+ *
+ * @param   none
+ *
+ * @return  none
+ */
+void NLME_CoordinatorInit( void )
+{
+}
+
+/*********************************************************************
+ * @fn      NLME_InitNV
+ *
+ * @brief   Initialize the NWK items in NV.
+ *
+ * @param   none
+ *
+ * @return  SUCCESS if the NIB item already existed
+ */
+byte NLME_InitNV( void )
+{
+  return ( osal_nv_item_init( ZCD_NV_NIB, sizeof( nwkIB_t ), &_NIB ) );
+}
+
+/*********************************************************************
+ * @fn      NLME_SetDefaultNV
+ *
+ * @brief   Write the default NIB to NV.
+ *
+ * @param   none
+ *
+ * @return  none
+ */
+void NLME_SetDefaultNV( void )
+{
+  NIB_init();
+  osal_nv_write( ZCD_NV_NIB, 0, sizeof( nwkIB_t ), &_NIB );
+}
+
+/*********************************************************************
+ * @fn      NLME_RestoreFromNV
+ *
+ * @brief   Restore the NIB from NV.
+ *
+ * @param   none
+ *
+ * @return  TRUE if the device was on a network
+ */
+byte NLME_RestoreFromNV( void )
+{
+  if ( osal_nv_read( ZCD_NV_NIB, 0, sizeof( nwkIB_t ), &_NIB ) != SUCCESS )
+  {
+    return ( FALSE );
+  }
+
+  // The NWK state is re-established by the start request
+  _NIB.nwkState = NWK_INIT;
+
+  return ( (_NIB.nwkDevAddress != INVALID_NODE_ADDR) && (_NIB.nwkPanId != INVALID_NODE_ADDR) );
+}
+
+/*********************************************************************
+ * @fn      NLME_UpdateNV
+ *
+ * @brief   Write the network items to NV.
+ *
+ * @param   enables - NWK_NV_NIB_ENABLE, NWK_NV_BINDING_ENABLE, ...
+ *
+ * @return  none
+ */
+void NLME_UpdateNV( byte enables )
+{
+  if ( enables & NWK_NV_NIB_ENABLE )
+  {
+    osal_nv_write( ZCD_NV_NIB, 0, sizeof( nwkIB_t ), &_NIB );
+  }
+
+#if defined ( REFLECTOR )
+  if ( enables & NWK_NV_BINDING_ENABLE )
+  {
+    BindWriteNV();
+  }
+#endif
+}
+
+/*********************************************************************
+ * @fn      NLME_ReadNwkKeyInfo
+ *
+ * @brief   Read network key information from NV.
+ *
+ * @param   index - not used
+ * @param   len - size of keyinfo
+ * @param   keyinfo - receives the item
+ * @param   NvId - NV item to read
+ *
+ * @return  status of the NV read
+ */
+ZStatus_t NLME_ReadNwkKeyInfo( uint16 index, uint16 len, void *keyinfo, uint16 NvId )
+{
+  (void)index;
+
+  return ( osal_nv_read( NvId, 0, len, keyinfo ) );
+}
+
+/*********************************************************************
+ * @fn      nwk_setStateIdle
+ *
+ * @brief   Put the NWK state machine in or out of idle. The host NWK
+ *          layer has no state machine to hold.
+ *
+ * @param   idle - TRUE for idle
+ *
+ * @return  none
+ */
+void nwk_setStateIdle( uint8 idle )
+{
+  (void)idle;
+}
+
+/*********************************************************************
+ * @fn      nwk_ExtPANIDValid
+ *
+ * @brief   Check that an extended PAN ID is neither all zeros nor all
+ *          ones.
+ *
+ * @param   panID - extended PAN ID
+ *
+ * @return  TRUE if valid
+ */
+uint8 nwk_ExtPANIDValid( byte *panID )
+{
+  uint8 zeros = 0;
+  uint8 ones = 0;
+  uint8 i;
+
+  if ( panID == NULL )
+  {
+    return ( FALSE );
+  }
+
+  for ( i = 0; i < Z_EXTADDR_LEN; i++ )
+  {
+    zeros += (panID[i] == 0x00);
+    ones += (panID[i] == 0xFF);
+  }
+
+  return ( (zeros != Z_EXTADDR_LEN) && (ones != Z_EXTADDR_LEN) );
+}
+
+/*********************************************************************
+ * @fn      nwkTransmissionFailures
+ *
+ * @brief   Report the transmission failures since the last reset.
+ *
+ * @param   reset - TRUE to clear the count
+ *
+ * @return  number of failures; always 0
+ */
+uint16 nwkTransmissionFailures( uint8 reset )
+{
+  (void)reset;
+
+  return ( 0 );
+}
+
+/*********************************************************************
+ * @fn      nwkNeighborRemove
+ *
+ * @brief   Remove a neighbor. The neighbor table is always empty.
+ *
+ * @return  none
+ */
+void nwkNeighborRemove( uint16 NeighborAddress, uint16 PanId )
+{
+  (void)NeighborAddress;
+  (void)PanId;
+}
+
+/*********************************************************************
+ * @fn      nwkNeighborRemoveAllStranded
+ *
+ * @brief   Remove neighbors left from another network.
+ *
+ * @return  none
+ */
+void nwkNeighborRemoveAllStranded( void )
+{
+}
+
+/*********************************************************************
+ * @fn      RTG_RemoveRtgEntry
+ *
+ * @brief   Remove a route. The routing table is always empty.
+ *
+ * @return  RTG_FAIL
+ */
+RTG_Status_t RTG_RemoveRtgEntry( uint16 DstAddress, uint8 options )
+{
+  (void)DstAddress;
+  (void)options;
+
+  return ( RTG_FAIL );
+}
+
+/*********************************************************************
+ * @fn      RTG_CheckRtStatus
+ *
+ * @brief   Check the status of a route.
+ *
+ * @return  RTG_SUCCESS for this device, RTG_FAIL otherwise
+ */
+RTG_Status_t RTG_CheckRtStatus( uint16 DstAddress, byte RtStatus, uint8 options )
+{
+  (void)RtStatus;
+  (void)options;
+
+  return ( (DstAddress == _NIB.nwkDevAddress) ? RTG_SUCCESS : RTG_FAIL );
+}
+
+/*********************************************************************
+ * @fn      RTG_AddSrcRtgEntry_Guaranteed
+ *
+ * @brief   Add a source route.
+ *
+ * @return  RTG_FAIL, as there is no source route table
+ */
+RTG_Status_t RTG_AddSrcRtgEntry_Guaranteed( uint16 srcAddr, uint8 relayCnt, uint16* pRelayList )
+{
+  (void)srcAddr;
+  (void)relayCnt;
+  (void)pRelayList;
+
+  return ( RTG_FAIL );
+}
+
+/*********************************************************************
+ * Association list - no device can join, so the list is always empty.
+ */
+
+uint16 AssocCount( byte startRelation, byte endRelation )
+{
+  (void)startRelation;
+  (void)endRelation;
+
+  return ( 0 );
+}
+
+byte AssocIsChild( uint16 shortAddr )
+{
+  (void)shortAddr;
+
+  return ( FALSE );
+}
+
+associated_devices_t *AssocGetWithShort( uint16 shortAddr )
+{
+  (void)shortAddr;
+
+  return ( NULL );
+}
+
+associated_devices_t *AssocGetWithExt( byte *extAddr )
+{
+  (void)extAddr;
+
+  return ( NULL );
+}
+
+associated_devices_t *AssocFindDevice( uint16 number )
+{
+  (void)number;
+
+  return ( NULL );
+}
+
+byte AssocRemove( byte *extAddr )
+{
+  (void)extAddr;
+
+  return ( FALSE );
+}
+
+uint16 *AssocMakeList( byte *pCount )
+{
+  *pCount = 0;
+
+  return ( NULL );
+}
+
+uint8 *AssocMakeListOfRfdChild( uint8 *pCount )
+{
+  *pCount = 0;
+
+  return ( NULL );
+}
+
+/*********************************************************************
+ * Address manager - a flat table without NV backing.
+ */
+
+/*********************************************************************
+ * @fn      nwkPosixAddrUserMatch
+ *
+ * @brief   Check whether an address entry is in use by a user.
+ *
+ * @param   item - address table entry
+ * @param   user - user ID; ADDRMGR_USER_DEFAULT matches any user
+ *
+ * @return  TRUE if matched
+ */
+static uint8 nwkPosixAddrUserMatch( AddrMgrEntry_t *item, uint8 user )
+{
+  if ( item->user == 0xFF )
+  {
+    return ( FALSE );
+  }
+
+  return ( (user == ADDRMGR_USER_DEFAULT) || (item->user & user) );
+}
+
+void AddrMgrExtAddrSet( uint8* dstExtAddr, uint8* srcExtAddr )
+{
+  if ( srcExtAddr != NULL )
+  {
+    osal_cpyExtAddr( dstExtAddr, srcExtAddr );
+  }
+  else
+  {
+    osal_memset( dstExtAddr, 0, Z_EXTADDR_LEN );
+  }
+}
+
+uint8 AddrMgrExtAddrValid( uint8* extAddr )
+{
+  uint8 i;
+
+  if ( extAddr != NULL )
+  {
+    for ( i = 0; i < Z_EXTADDR_LEN; i++ )
+    {
+      if ( extAddr[i] != 0x00 )
+      {
+        return ( TRUE );
+      }
+    }
+  }
+
+  return ( FALSE );
+}
+
+uint8 AddrMgrExtAddrLookup( uint16 nwkAddr, uint8* extAddr )
+{
+  AddrMgrEntry_t entry;
+
+  entry.user = ADDRMGR_USER_DEFAULT;
+  entry.nwkAddr = nwkAddr;
+
+  if ( AddrMgrEntryLookupNwk( &entry ) )
+  {
+    osal_cpyExtAddr( extAddr, entry.extAddr );
+    return ( TRUE );
+  }
+
+  return ( FALSE );
+}
+
+uint8 AddrMgrEntryLookupNwk( AddrMgrEntry_t* entry )
+{
+  uint16 i;
+
+  if ( entry->nwkAddr == _NIB.nwkDevAddress )
+  {
+    osal_cpyExtAddr( entry->extAddr, saveExtAddr );
+    entry->index = INVALID_NODE_ADDR;
+    return ( TRUE );
+  }
+
+  for ( i = 0; i < NWK_MAX_ADDRESSES; i++ )
+  {
+    if ( nwkPosixAddrUserMatch( &nwkPosixAddrTable[i], entry->user ) &&
+         (nwkPosixAddrTable[i].nwkAddr == entry->nwkAddr) )
+    {
+      osal_cpyExtAddr( entry->extAddr, nwkPosixAddrTable[i].extAddr );
+      entry->index = i;
+      return ( TRUE );
+    }
+  }
+
+  return ( FALSE );
+}
+
+uint8 AddrMgrEntryLookupExt( AddrMgrEntry_t* entry )
+{
+  uint16 i;
+
+  if ( osal_ExtAddrEqual( entry->extAddr, saveExtAddr ) )
+  {
+    entry->nwkAddr = _NIB.nwkDevAddress;
+    entry->index = INVALID_NODE_ADDR;
+    return ( TRUE );
+  }
+
+  for ( i = 0; i < NWK_MAX_ADDRESSES; i++ )
+  {
+    if ( nwkPosixAddrUserMatch( &nwkPosixAddrTable[i], entry->user ) &&
+         osal_ExtAddrEqual( nwkPosixAddrTable[i].extAddr, entry->extAddr ) )
+    {
+      entry->nwkAddr = nwkPosixAddrTable[i].nwkAddr;
+      entry->index = i;
+      return ( TRUE );
+    }
+  }
+
+  return ( FALSE );
+}
+
+uint8 AddrMgrEntryGet( AddrMgrEntry_t* entry )
+{
+  if ( (entry->index < NWK_MAX_ADDRESSES) &&
+       nwkPosixAddrUserMatch( &nwkPosixAddrTable[entry->index], entry->user ) )
+  {
+    entry->nwkAddr = nwkPosixAddrTable[entry->index].nwkAddr;
+    osal_cpyExtAddr( entry->extAddr, nwkPosixAddrTable[entry->index].extAddr );
+    return ( TRUE );
+  }
+
+  return ( FALSE );
+}
+
+uint8 AddrMgrEntryUpdate( AddrMgrEntry_t* entry )
+{
+  uint16 i;
+  uint16 freeIdx = INVALID_NODE_ADDR;
+
+  for ( i = 0; i < NWK_MAX_ADDRESSES; i++ )
+  {
+    AddrMgrEntry_t *item = &nwkPosixAddrTable[i];
+
+    if ( item->user == 0xFF )
+    {
+      if ( freeIdx == INVALID_NODE_ADDR )
+      {
+        freeIdx = i;
+      }
+    }
+    else if ( osal_ExtAddrEqual( item->extAddr, entry->extAddr ) ||
+              ( !AddrMgrExtAddrValid( item->extAddr ) && (item->nwkAddr == entry->nwkAddr) ) )
+    {
+      item->user |= entry->user;
+      item->nwkAddr = entry->nwkAddr;
+      osal_cpyExtAddr( item->extAddr, entry->extAddr );
+      entry->index = i;
+      return ( TRUE );
+    }
+  }
+
+  if ( freeIdx == INVALID_NODE_ADDR )
+  {
+    return ( FALSE );
+  }
+
+  nwkPosixAddrTable[freeIdx].user = entry->user;
+  nwkPosixAddrTable[freeIdx].nwkAddr = entry->nwkAddr;
+  osal_cpyExtAddr( nwkPosixAddrTable[freeIdx].extAddr, entry->extAddr );
+  entry->index = freeIdx;
+
+  return ( TRUE );
+}
+
+uint8 AddrMgrEntryRelease( AddrMgrEntry_t* entry )
+{
+  AddrMgrEntry_t *item;
+
+  if ( entry->index >= NWK_MAX_ADDRESSES )
+  {
+    return ( FALSE );
+  }
+
+  item = &nwkPosixAddrTable[entry->index];
+  if ( (item->user == 0xFF) || !(item->user & entry->user) )
+  {
+    return ( FALSE );
+  }
+
+  item->user &= ~entry->user;
+  if ( item->user == ADDRMGR_USER_DEFAULT )
+  {
+    osal_memset( item, 0xFF, sizeof( AddrMgrEntry_t ) );
+  }
+
+  return ( TRUE );
+}
+
+/*********************************************************************
+ * Security services - only the NV held key material is kept.
+ */
+
+void SSP_Init( void )
+{
+}
+
+void SSP_GetTrueRand( uint8 len, uint8 *rand )
+{
+  while ( len-- )
+  {
+    *rand++ = LO_UINT16( osal_rand() );
+  }
+}
+
+void SSP_ReadNwkActiveKey( nwkActiveKeyItems *items )
+{
+  if ( osal_nv_read( ZCD_NV_NWK_ACTIVE_KEY_INFO, 0, sizeof( nwkActiveKeyItems ), items ) != SUCCESS )
+  {
+    osal_memset( items, 0, sizeof( nwkActiveKeyItems ) );
+  }
+}
+
+void SSP_UpdateNwkKey( uint8 *key, uint8 keySeqNum )
+{
+  nwkKeyDesc alternKey;
+
+  alternKey.keySeqNum = keySeqNum;
+  osal_memcpy( alternKey.key, key, SEC_KEY_LEN );
+
+  osal_nv_write( ZCD_NV_NWK_ALTERN_KEY_INFO, 0, sizeof( nwkKeyDesc ), &alternKey );
+}
+
+void SSP_SwitchNwkKey( uint8 seqNum )
+{
+  nwkActiveKeyItems keyItems;
+
+  if ( (osal_nv_read( ZCD_NV_NWK_ALTERN_KEY_INFO, 0, sizeof( nwkKeyDesc ), &keyItems.active ) == SUCCESS) &&
+       (keyItems.active.keySeqNum == seqNum) )
+  {
+    keyItems.frameCounter = 0;
+    nwkFrameCounter = 0;
+    osal_nv_write( ZCD_NV_NWK_ACTIVE_KEY_INFO, 0, sizeof( nwkActiveKeyItems ), &keyItems );
+  }
+}
+
+// The host has no AES engine, so no digest is computed: the output is zeroed.
+void sspMMOHash( uint8 *Prefix, uint8 PrefixLen, uint8 *Data, uint16 DataLen, uint8 *Result )
+{
+  (void)Prefix;
+  (void)PrefixLen;
+  (void)Data;
+  (void)DataLen;
+
+  osal_memset( Result, 0, SEC_KEY_LEN );
+}
+
+/*********************************************************************
+*********************************************************************/
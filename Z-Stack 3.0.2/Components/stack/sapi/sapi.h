@@ -44,7 +44,7 @@
  * INCLUDES
  */
 #include "ZComDef.h"
-#include "af.h"
+#include "AF.h"
 
 /******************************************************************************
  * CONSTANTS
@@ -981,6 +981,7 @@ static void zgUpgradeSecurityNVItems( void )
       //indicate to BDB that our previous nwk was non-R21, so don't expect TC Link Key exchange
       keyAttributes = ZG_NON_R21_NWK_JOINED;
       osal_nv_write(ZCD_NV_TCLK_TABLE_START, osal_offsetof(APSME_TCLKDevEntry_t,keyAttributes), sizeof(uint8), &keyAttributes); 
+      ZDSecMgrTCLKIndexSet( ZCD_NV_TCLK_TABLE_START, NULL );
     }
   }
 }
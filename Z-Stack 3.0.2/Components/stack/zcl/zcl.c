@@ -40,6 +40,9 @@
 /*********************************************************************
  * INCLUDES
  */
+// Call site file id for heap usage attribution (OSALMEM_SITES)
+#define OSALMEM_SITE_FILE  OSALMEM_FILE_ZCL
+
 #include "ZComDef.h"
 #include "AF.h"
 #include "APS.h"
@@ -186,6 +189,7 @@ static zclLibPlugin_t *plugins = (zclLibPlugin_t *)NULL;
 #endif
 
 static zclAttrRecsList *attrList = (zclAttrRecsList *)NULL;
+static zclAttrRecsList *attrListLastFound = (zclAttrRecsList *)NULL;
 static zclClusterOptionList *clusterOptionList = (zclClusterOptionList *)NULL;
 
 static afIncomingMSGPacket_t *rawAFMsg = (afIncomingMSGPacket_t *)NULL;
@@ -211,6 +215,7 @@ static uint8 zcl_getExternalFoundationHandler( afIncomingMSGPacket_t *pInMsg );
 #endif
 
 zclAttrRecsList *zclFindAttrRecsList( uint8 endpoint );
+static void zclBuildAttrIndex( zclAttrRecsList *pRec );
 static zclOptionRec_t *zclFindClusterOption( uint8 endpoint, uint16 clusterID );
 static uint8 zclGetClusterOption( uint8 endpoint, uint16 clusterID );
 static void zclSetSecurityOption( uint8 endpoint, uint16 clusterID, uint8 enable );
@@ -892,6 +897,9 @@ ZStatus_t zcl_registerAttrList( uint8 endpoint, uint8 numAttr, CONST zclAttrRec_
   pNewItem->pfnReadWriteCB = NULL;
   pNewItem->numAttributes = numAttr;
   pNewItem->attrs = newAttrList;
+  pNewItem->attrIndex = NULL;
+
+  zclBuildAttrIndex( pNewItem );
 
   // Find spot in list
   if ( attrList == NULL )
@@ -2606,12 +2614,22 @@ uint8 zclFindCmdRec( uint8 endpoint, uint16 clusterID, uint8 cmdID, zclCommandRe
  */
 zclAttrRecsList *zclFindAttrRecsList( uint8 endpoint )
 {
-  zclAttrRecsList *pLoop = attrList;
+  zclAttrRecsList *pLoop;
+
+  // Consecutive lookups are nearly always for the same endpoint
+  if ( ( attrListLastFound != NULL ) && ( attrListLastFound->endpoint == endpoint ) )
+  {
+    return ( attrListLastFound );
+  }
+
+  pLoop = attrList;
 
   while ( pLoop != NULL )
   {
     if ( pLoop->endpoint == endpoint )
     {
+      attrListLastFound = pLoop;
+
       return ( pLoop );
     }
 
@@ -2621,6 +2639,61 @@ zclAttrRecsList *zclFindAttrRecsList( uint8 endpoint )
   return ( NULL );
 }
 
+/*********************************************************************
+ * @fn      zclBuildAttrIndex
+ *
+ * @brief   Build the sorted (cluster ID, attribute ID) index of an
+ *          attribute record list. If there is not enough memory for
+ *          the index, lookups fall back to a linear search.
+ *
+ * @param   pRec - attribute record list
+ *
+ * @return  none
+ */
+static void zclBuildAttrIndex( zclAttrRecsList *pRec )
+{
+  CONST zclAttrRec_t *pAttrs = pRec->attrs;
+  uint8 *pIndex;
+  uint8 x;
+  uint8 y;
+
+  if ( pRec->attrIndex != NULL )
+  {
+    zcl_mem_free( pRec->attrIndex );
+    pRec->attrIndex = NULL;
+  }
+
+  if ( ( pRec->numAttributes == 0 ) || ( pAttrs == NULL ) )
+  {
+    return;
+  }
+
+  pIndex = zcl_mem_alloc( pRec->numAttributes );
+  if ( pIndex == NULL )
+  {
+    return;
+  }
+
+  // Insertion sort - stable, so duplicate records keep their list order
+  for ( x = 0; x < pRec->numAttributes; x++ )
+  {
+    y = x;
+
+    while ( ( y > 0 ) &&
+            ( ( pAttrs[pIndex[y-1]].clusterID > pAttrs[x].clusterID ) ||
+              ( ( pAttrs[pIndex[y-1]].clusterID == pAttrs[x].clusterID ) &&
+                ( pAttrs[pIndex[y-1]].attr.attrId > pAttrs[x].attr.attrId ) ) ) )
+    {
+      pIndex[y] = pIndex[y-1];
+      y--;
+    }
+
+    pIndex[y] = x;
+  }
+
+  pRec->attrIndex = pIndex;
+}
+
 /*********************************************************************
  * @fn      zclFindAttrRec
  *
@@ -2638,7 +2711,43 @@ uint8 zclFindAttrRec( uint8 endpoint, uint16 clusterID, uint16 attrId, zclAttrRe
   uint8 x;
   zclAttrRecsList *pRec = zclFindAttrRecsList( endpoint );
 
-  if ( pRec != NULL )
+  if ( ( pRec != NULL ) && ( pRec->attrIndex != NULL ) )
+  {
+    CONST zclAttrRec_t *pAttrs = pRec->attrs;
+    uint8 low = 0;
+    uint8 high = pRec->numAttributes;
+    uint8 mid;
+
+    // Binary search for the first record not less than (clusterID, attrId)
+    while ( low < high )
+    {
+      mid = low + ( ( high - low ) >> 1 );
+      x = pRec->attrIndex[mid];
+
+      if ( ( pAttrs[x].clusterID < clusterID ) ||
+           ( ( pAttrs[x].clusterID == clusterID ) && ( pAttrs[x].attr.attrId < attrId ) ) )
+      {
+        low = mid + 1;
+      }
+      else
+      {
+        high = mid;
+      }
+    }
+
+    if ( low < pRec->numAttributes )
+    {
+      x = pRec->attrIndex[low];
+
+      if ( pAttrs[x].clusterID == clusterID && pAttrs[x].attr.attrId == attrId )
+      {
+        *pAttr = pAttrs[x];
+
+        return ( TRUE ); // EMBEDDED RETURN
+      }
+    }
+  }
+  else if ( pRec != NULL )
   {
     for ( x = 0; x < pRec->numAttributes; x++ )
     {
@@ -2678,6 +2787,7 @@ uint8 zclSetAttrRecList( uint8 endpoint, uint8 numAttr, CONST zclAttrRec_t attrL
   {
     pRecsList->numAttributes = numAttr;
     pRecsList->attrs = attrList;
+    zclBuildAttrIndex( pRecsList );
     return ( TRUE );
   }
 
@@ -3373,6 +3483,37 @@ ZStatus_t zcl_ReadAttrData( uint8 endpoint, uint16 clusterId, uint16 attrId,
   }
 }
 
+/*********************************************************************
+ * @fn      zcl_GetAttrDataLength
+ *
+ * @brief   Get the length of the attribute's current value.
+ *          Use application's callback function if assigned to this attribute.
+ *
+ * @param   endpoint - application's endpoint
+ * @param   clusterId - cluster that attribute belongs to
+ * @param   attrId - attribute id
+ *
+ * @return  attribute length, 0 if not found
+ */
+uint16 zcl_GetAttrDataLength( uint8 endpoint, uint16 clusterId, uint16 attrId )
+{
+  zclAttrRec_t attrRec;
+
+  if ( zclFindAttrRec( endpoint, clusterId, attrId, &attrRec ) == FALSE )
+  {
+    return ( 0 );
+  }
+
+  if ( attrRec.attr.dataPtr != NULL )
+  {
+    return zclGetAttrDataLength( attrRec.attr.dataType, (uint8*)(attrRec.attr.dataPtr) );
+  }
+  else
+  {
+    return zclGetAttrDataLengthUsingCB( endpoint, clusterId, attrId );
+  }
+}
+
 /*********************************************************************
  * @fn      zclGetAttrDataLengthUsingCB
  *
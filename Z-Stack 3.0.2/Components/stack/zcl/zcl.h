@@ -809,6 +809,7 @@ typedef struct zclAttrRecsList
   zclAuthorizeCB_t       pfnAuthorizeCB;// Authorize Read or Write operation
   uint8                  numAttributes; // Number of the following records
   CONST zclAttrRec_t     *attrs;        // attribute records
+  uint8                  *attrIndex;    // attrs indexes sorted by cluster ID and attribute ID
 } zclAttrRecsList;
 
 /*********************************************************************
@@ -973,6 +974,11 @@ extern ZStatus_t zcl_SendReadRsp( uint8 srcEP, afAddrType_t *dstAddr,
 extern ZStatus_t zcl_ReadAttrData( uint8 endpoint, uint16 clusterId, uint16 attrId,
                                    uint8 *pAttrData, uint16 *pDataLen );
 
+/*
+ *  Function for getting the length of a local attribute's value
+ */
+extern uint16 zcl_GetAttrDataLength( uint8 endpoint, uint16 clusterId, uint16 attrId );
+
 #endif // ZCL_READ
 
 #ifdef ZCL_WRITE
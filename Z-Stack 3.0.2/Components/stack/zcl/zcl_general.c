@@ -41,6 +41,9 @@
 /*********************************************************************
  * INCLUDES
  */
+// Call site file id for heap usage attribution (OSALMEM_SITES)
+#define OSALMEM_SITE_FILE  OSALMEM_FILE_ZCL_GENERAL
+
 #include "ZComDef.h"
 #include "zcl.h"
 #include "zcl_general.h"
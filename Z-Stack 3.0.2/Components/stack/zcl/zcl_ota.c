@@ -42,6 +42,7 @@
  */
 #include "ZComDef.h"
 #include "OSAL.h"
+#include "OSAL_Clock.h"
 #include "zcl.h"
 #include "zcl_general.h"
 #include "zcl_ota.h"
@@ -66,6 +67,25 @@
 /******************************************************************************
  * MACROS
  */
+#if (defined OTA_CLIENT) && (OTA_CLIENT == TRUE)
+// Block size, delay between block requests and response timeout of the client
+#if (OTA_CLIENT_ADAPTIVE == TRUE)
+#define OTA_CLIENT_BLOCK_SIZE       zclOTA_AdaptBlockSize
+#define OTA_CLIENT_REQ_DELAY        ( zclOTA_MinBlockReqDelay + zclOTA_AdaptDelay )
+#define OTA_CLIENT_RSP_WAIT         zclOTA_AdaptRspWait
+#else
+#define OTA_CLIENT_BLOCK_SIZE       OTA_MAX_MTU
+#define OTA_CLIENT_REQ_DELAY        zclOTA_MinBlockReqDelay
+#define OTA_CLIENT_RSP_WAIT         OTA_MAX_BLOCK_RSP_WAIT_TIME
+#endif
+#endif // (defined OTA_CLIENT) && (OTA_CLIENT == TRUE)
+
+#if (defined OTA_SERVER) && (OTA_SERVER == TRUE)
+// Largest block the server sends, no more than the OTA console can return
+// in one MT File Read response
+#define OTA_SERVER_BLOCK_SIZE       MIN( OTA_MAX_BLOCK_SIZE, ( MT_UART_RX_BUFF_MAX - \
+                                         MT_OTA_FILE_READ_RSP_LEN - SPI_0DATA_MSG_LEN ) )
+#endif // (defined OTA_SERVER) && (OTA_SERVER == TRUE)
 
 /******************************************************************************
  * CONSTANTS
@@ -77,6 +97,65 @@
 #define ZCL_OTA_STK_VER_OFFSET      18 // Stack version location in OTA upgrade image
 
 #define OTA_NEW_IMAGE_QUERY_RATE    30000 // ms - 5 minutes
+
+// Image Page Request state of a server session
+#define OTA_PAGE_IDLE               0
+#define OTA_PAGE_DUE                1  // Next block waits for its time slot
+#define OTA_PAGE_READ               2  // Next block is being read
+
+#define OTA_ADAPT_NO_RTT            0xFFFF  // No round trip time measured yet
+
+/******************************************************************************
+ * TYPEDEFS
+ */
+#if (defined OTA_SERVER) && (OTA_SERVER == TRUE)
+// Client downloading an image from the server
+typedef struct
+{
+  afAddrType_t addr;            // Client
+  zclOTA_FileID_t fileId;       // Image offered to the client
+  uint32 imageSize;
+  uint32 offset;                // Offset of the client's last request
+  uint32 lastActivity;          // Time of the client's last request, in seconds
+  uint16 blockReqDelay;         // Delay given to the client, in ms
+  uint8 progress;               // Percent done last reported to the console
+  uint8 inUse;
+
+  // Image Page Request being served
+  uint32 pageOffset;            // Offset of the next block of the page
+  uint32 pageEnd;               // Offset just past the end of the page
+  uint32 pageDue;               // System clock when the next block is due, in ms
+  uint16 responseSpacing;       // Time between block responses, in ms
+  uint8 maxDataSize;
+  uint8 pageState;
+} zclOTA_Session_t;
+
+#if (OTA_BLOCK_CACHE == TRUE)
+// Client waiting for a cached block that is still being read
+typedef struct
+{
+  afAddrType_t addr;
+  uint8 skip;                   // Offset of the client's block in the entry
+  uint8 len;                    // Client's maximum data size
+  uint8 hit;                    // Client did not cause the read
+} zclOTA_CacheWaiter_t;
+
+// Image block held by the server block cache
+typedef struct
+{
+  zclOTA_FileID_t fileId;
+  uint32 offset;
+  uint32 stamp;                 // Time the console read was issued, in seconds
+  uint16 age;                   // Cache clock when last used
+  uint8 len;                    // Bytes held
+  uint8 pending;                // Console read outstanding
+  uint8 waiters;
+  zclOTA_CacheWaiter_t waiter[OTA_BLOCK_CACHE_WAITERS];
+  uint8 data[OTA_SERVER_BLOCK_SIZE];
+} zclOTA_CacheEntry_t;
+#endif // (OTA_BLOCK_CACHE == TRUE)
+#endif // (defined OTA_SERVER) && (OTA_SERVER == TRUE)
+
 /******************************************************************************
  * GLOBAL VARIABLES
  */
@@ -142,6 +221,9 @@ zclOTA_QueryImageRspParams_t queryResponse;             // Global variable for s
 // Image block command field control value
 uint8 zclOTA_ImageBlockFC = OTA_BLOCK_FC_REQ_DELAY_PRESENT; // set bitmask field control value(s) for device
 
+// Download the image with Image Page Requests instead of Image Block Requests
+uint8 zclOTA_ImagePageReq = OTA_CLIENT_PAGE_REQ;
+
 /******************************************************************************
  * LOCAL VARIABLES
  */
@@ -179,6 +261,22 @@ static uint32 zclOTA_ElementPos;
 static uint8 zclOTA_BlockRetry;
 static uint8 zclOTA_UpgradeEndRetry;
 
+// Image Page Request state
+static uint32 zclOTA_PageEnd;              // Offset just past the requested page
+static uint8 zclOTA_PageResync;            // Page re-requested after a lost block
+
+#if (OTA_CLIENT_ADAPTIVE == TRUE)
+// Adaptive block request state
+static uint8 zclOTA_AdaptBlockSize;        // maxDataSize of the next request
+static uint8 zclOTA_AdaptGoodRsps;         // Prompt responses since the last increase
+static uint8 zclOTA_AdaptTiming;           // Round trip of the last request is being timed
+static uint16 zclOTA_AdaptDelay;           // Added to the block request delay, in ms
+static uint16 zclOTA_AdaptRtt;             // Smoothed round trip time, in ms
+static uint16 zclOTA_AdaptRttVar;          // Round trip time variation, in ms
+static uint16 zclOTA_AdaptRspWait;         // Response timeout, in ms
+static uint32 zclOTA_AdaptReqTime;         // System clock when the request was sent
+#endif
+
 static uint8 zclOTA_ClientPdState;
 
 // OTA Header Magic Number Bytes
@@ -191,6 +289,17 @@ static uint8 zclOta_OtaZDPTransSeq;
 
 #endif // (defined OTA_CLIENT) && (OTA_CLIENT == TRUE)
 
+#if (defined OTA_SERVER) && (OTA_SERVER == TRUE)
+static zclOTA_Session_t zclOTA_Sessions[OTA_SERVER_MAX_SESSIONS];
+static uint8 zclOTA_PageNext;              // Session served first by the page scheduler
+
+#if (OTA_BLOCK_CACHE == TRUE)
+static zclOTA_CacheEntry_t zclOTA_Cache[OTA_BLOCK_CACHE_ENTRIES];
+static uint16 zclOTA_CacheClock;
+zclOTA_CacheStats_t zclOTA_CacheStats;
+#endif // (OTA_BLOCK_CACHE == TRUE)
+#endif // (defined OTA_SERVER) && (OTA_SERVER == TRUE)
+
 // Used by the client to correlate the Upgrade End Request and received
 // Default Response.
 static uint8 zclOta_OtaUpgradeEndReqTransSeq;
@@ -204,14 +313,21 @@ static void zclOTA_ProcessInDefaultRspCmd( zclIncomingMsg_t *pInMsg );
 #if (defined OTA_CLIENT) && (OTA_CLIENT == TRUE)
 static void zclOTA_StartTimer ( uint16 eventId, uint32 minutes );
 static ZStatus_t sendImageBlockReq ( afAddrType_t *dstAddr );
+static ZStatus_t sendImagePageReq ( afAddrType_t *dstAddr );
 static void zclOTA_ProcessZDOMsgs ( zdoIncomingMsg_t *pMsg );
 static void zclOTA_ImageBlockWaitExpired ( void );
 static void zclOTA_UpgradeComplete ( uint8 status );
 static uint8 zclOTA_CmpFileId ( zclOTA_FileID_t *f1, zclOTA_FileID_t *f2 );
 static uint8 zclOTA_ProcessImageData ( uint8 *pData, uint8 len );
+#if (OTA_CLIENT_ADAPTIVE == TRUE)
+static void zclOTA_AdaptInit ( void );
+static void zclOTA_AdaptRsp ( void );
+static void zclOTA_AdaptTimeout ( void );
+#endif
 
 static ZStatus_t zclOTA_SendQueryNextImageReq ( afAddrType_t *dstAddr, zclOTA_QueryNextImageReqParams_t *pParams );
 static ZStatus_t zclOTA_SendImageBlockReq ( afAddrType_t *dstAddr, zclOTA_ImageBlockReqParams_t *pParams );
+static ZStatus_t zclOTA_SendImagePageReq ( afAddrType_t *dstAddr, zclOTA_ImagePageReqParams_t *pParams );
 static ZStatus_t zclOTA_SendUpgradeEndReq ( afAddrType_t *dstAddr, zclOTA_UpgradeEndReqParams_t *pParams );
 
 static ZStatus_t zclOTA_ClientHdlIncoming ( zclIncoming_t *pInMsg );
@@ -236,6 +352,27 @@ static void zclOTA_ServerHandleFileSysCb ( OTA_MtMsg_t* pMSGpkt );
 static ZStatus_t zclOTA_ServerHdlIncoming ( zclIncoming_t *pInMsg );
 
 static void zclOTA_InitBlockReqDelay ( void );
+static void zclOTA_PageReadNext ( zclOTA_Session_t *pSession );
+static void zclOTA_PageSchedule ( void );
+static void zclOTA_PageArm ( void );
+static void zclOTA_SendBlock ( afAddrType_t *pAddr, zclOTA_ImageBlockRspParams_t *pRsp );
+static void zclOTA_SendWaitRsp ( afAddrType_t *pAddr, uint32 currentTime, uint32 requestTime, uint16 blockReqDelay );
+
+static zclOTA_Session_t *zclOTA_SessionFind ( afAddrType_t *pAddr );
+static zclOTA_Session_t *zclOTA_SessionOpen ( afAddrType_t *pAddr, zclOTA_FileID_t *pFileId, uint32 imageSize );
+static zclOTA_Session_t *zclOTA_SessionCheck ( afAddrType_t *pAddr, zclOTA_FileID_t *pFileId, uint8 *pStatus );
+static void zclOTA_SessionProgress ( zclOTA_Session_t *pSession, uint32 offset, uint32 len );
+static uint16 zclOTA_SessionDelay ( void );
+static uint8 zclOTA_ReadBlock ( afAddrType_t *pAddr, zclOTA_FileID_t *pFileId, uint8 len, uint32 offset );
+
+#if (OTA_BLOCK_CACHE == TRUE)
+static uint32 zclOTA_ImageSize ( zclOTA_FileID_t *pFileId );
+static zclOTA_CacheEntry_t *zclOTA_CacheFind ( zclOTA_FileID_t *pFileId, uint32 offset );
+static zclOTA_CacheEntry_t *zclOTA_CacheFill ( zclOTA_FileID_t *pFileId, uint32 offset );
+static void zclOTA_CacheReadAhead ( zclOTA_FileID_t *pFileId, uint32 offset );
+static void zclOTA_CacheServe ( zclOTA_CacheEntry_t *pEntry, afAddrType_t *pAddr, uint8 len, uint32 offset, uint8 hit );
+static void zclOTA_CacheReadRsp ( uint8 idx, zclOTA_ImageBlockRspParams_t *pRsp );
+#endif // (OTA_BLOCK_CACHE == TRUE)
 #endif // (defined OTA_SERVER) && (OTA_SERVER == TRUE)
 
 /******************************************************************************
@@ -727,6 +864,9 @@ uint16 zclOTA_event_loop ( uint8 task_id, uint16 events )
     }
     else
     {
+#if (OTA_CLIENT_ADAPTIVE == TRUE)
+      zclOTA_AdaptTimeout();
+#endif
       // Send another block request
       sendImageBlockReq(&zclOTA_serverAddr);
     }
@@ -798,6 +938,16 @@ uint16 zclOTA_event_loop ( uint8 task_id, uint16 events )
   }
 #endif // (defined OTA_CLIENT) && (OTA_CLIENT == TRUE)
 
+#if (defined OTA_SERVER) && (OTA_SERVER == TRUE)
+  if ( events & ZCL_OTA_IMAGE_PAGE_RSP_EVT )
+  {
+    // Read the page blocks that are due
+    zclOTA_PageSchedule();
+
+    return ( events ^ ZCL_OTA_IMAGE_PAGE_RSP_EVT );
+  }
+#endif // (defined OTA_SERVER) && (OTA_SERVER == TRUE)
+
   // Discard unknown events
   return 0;
 }
@@ -939,6 +1089,23 @@ static void zclOTA_ProcessInDefaultRspCmd( zclIncomingMsg_t *pInMsg )
       }
       break;
       
+#if (defined OTA_CLIENT) && (OTA_CLIENT == TRUE)
+    case ( ZCL_STATUS_UNSUP_CLUSTER_COMMAND ) :
+      if ( ( defRspCmd->commandID == COMMAND_IMAGE_PAGE_REQ ) && zclOTA_ImagePageReq )
+      {
+        // The server does not do Image Page Requests, carry on block by block
+        zclOTA_ImagePageReq = FALSE;
+
+        if ( zclOTA_ImageUpgradeStatus == OTA_STATUS_IN_PROGRESS )
+        {
+          zclOTA_BlockRetry = 0;
+          osal_stop_timerEx ( zclOTA_TaskID, ZCL_OTA_BLOCK_RSP_TO_EVT );
+          sendImageBlockReq ( &pInMsg->srcAddr );
+        }
+      }
+      break;
+#endif // (defined OTA_CLIENT) && (OTA_CLIENT == TRUE)
+
     // Handling for other Defautl Response status codes and OTA states can 
     // be added here.
     default :
@@ -1249,6 +1416,50 @@ ZStatus_t zclOTA_SendImageBlockReq ( afAddrType_t *dstAddr,
   return status;
 }
 
+/******************************************************************************
+ * @fn      zclOTA_SendImagePageReq
+ *
+ * @brief   Send an OTA Image Page Request mesage.
+ *
+ * @param   dstAddr - where you want the message to go
+ * @param   pParams - message parameters
+ *
+ * @return  ZStatus_t
+ */
+ZStatus_t zclOTA_SendImagePageReq ( afAddrType_t *dstAddr,
+                                    zclOTA_ImagePageReqParams_t *pParams )
+{
+  ZStatus_t status;
+  uint8 buf[PAYLOAD_MAX_LEN_IMAGE_PAGE_REQ];
+  uint8 *pBuf = buf;
+
+  *pBuf++ = pParams->fieldControl;
+  *pBuf++ = LO_UINT16 ( pParams->fileId.manufacturer );
+  *pBuf++ = HI_UINT16 ( pParams->fileId.manufacturer );
+  *pBuf++ = LO_UINT16 ( pParams->fileId.type );
+  *pBuf++ = HI_UINT16 ( pParams->fileId.type );
+  pBuf = osal_buffer_uint32 ( pBuf, pParams->fileId.version );
+  pBuf = osal_buffer_uint32 ( pBuf, pParams->fileOffset );
+  *pBuf++ = pParams->maxDataSize;
+  *pBuf++ = LO_UINT16 ( pParams->pageSize );
+  *pBuf++ = HI_UINT16 ( pParams->pageSize );
+  *pBuf++ = LO_UINT16 ( pParams->responseSpacing );
+  *pBuf++ = HI_UINT16 ( pParams->responseSpacing );
+
+  if ( ( pParams->fieldControl & OTA_PAGE_FC_NODES_IEEE_PRESENT ) != 0 )
+  {
+    osal_cpyExtAddr ( pBuf, pParams->nodeAddr );
+    pBuf += Z_EXTADDR_LEN;
+  }
+
+  status = zcl_SendCommand ( ZCL_OTA_ENDPOINT, dstAddr, ZCL_CLUSTER_ID_OTA,
+                             COMMAND_IMAGE_PAGE_REQ, TRUE,
+                             ZCL_FRAME_CLIENT_SERVER_DIR, FALSE, 0,
+                             zclOTA_SeqNo++, ( uint16 ) ( pBuf - buf ), buf );
+
+  return status;
+}
+
 /******************************************************************************
  * @fn      zclOTA_SendUpgradeEndReq
  *
@@ -1315,29 +1526,226 @@ static ZStatus_t sendImageBlockReq ( afAddrType_t *dstAddr )
 {
   zclOTA_ImageBlockReqParams_t req;
 
+#if (OTA_CLIENT_ADAPTIVE == TRUE)
+  // Only first attempts are timed, a response to a retry may be a late
+  // response to the request before it
+  zclOTA_AdaptTiming = ( zclOTA_BlockRetry == 0 );
+  zclOTA_AdaptReqTime = osal_GetSystemClock();
+#endif
+
+  if ( zclOTA_ImagePageReq )
+  {
+    return sendImagePageReq ( dstAddr );
+  }
+
   req.fieldControl = zclOTA_ImageBlockFC; // Image block command field control value
   req.fileId.manufacturer = zclOTA_ManufacturerId;
   req.fileId.type = zclOTA_ImageType;
   req.fileId.version = zclOTA_DownloadedFileVersion;
   req.fileOffset = zclOTA_FileOffset;
 
-  if ( zclOTA_DownloadedImageSize - zclOTA_FileOffset < OTA_MAX_MTU )
+  if ( zclOTA_DownloadedImageSize - zclOTA_FileOffset < OTA_CLIENT_BLOCK_SIZE )
   {
     req.maxDataSize = zclOTA_DownloadedImageSize - zclOTA_FileOffset;
   }
   else
   {
-    req.maxDataSize = OTA_MAX_MTU;
+    req.maxDataSize = OTA_CLIENT_BLOCK_SIZE;
   }
 
   req.blockReqDelay = zclOTA_MinBlockReqDelay;
 
   // Start a timer waiting for a response
-  osal_start_timerEx ( zclOTA_TaskID, ZCL_OTA_BLOCK_RSP_TO_EVT, OTA_MAX_BLOCK_RSP_WAIT_TIME );
+  osal_start_timerEx ( zclOTA_TaskID, ZCL_OTA_BLOCK_RSP_TO_EVT, OTA_CLIENT_RSP_WAIT );
 
   return zclOTA_SendImageBlockReq ( dstAddr, &req );
 }
 
+/******************************************************************************
+ * @fn      sendImagePageReq
+ *
+ * @brief   Send an Image Page Request for the page starting at the current
+ *          file offset.  The server then sends the blocks of the page
+ *          without further requests.
+ *
+ * @param   dstAddr - where you want the message to go
+ *
+ * @return  ZStatus_t
+ */
+static ZStatus_t sendImagePageReq ( afAddrType_t *dstAddr )
+{
+  zclOTA_ImagePageReqParams_t req;
+  uint32 remaining = zclOTA_DownloadedImageSize - zclOTA_FileOffset;
+
+  req.fieldControl = OTA_PAGE_FC_GENERIC;
+  req.fileId.manufacturer = zclOTA_ManufacturerId;
+  req.fileId.type = zclOTA_ImageType;
+  req.fileId.version = zclOTA_DownloadedFileVersion;
+  req.fileOffset = zclOTA_FileOffset;
+  req.maxDataSize = ( remaining < OTA_CLIENT_BLOCK_SIZE ) ? ( uint8 ) remaining : OTA_CLIENT_BLOCK_SIZE;
+  req.pageSize = ( remaining < OTA_PAGE_SIZE ) ? ( uint16 ) remaining : OTA_PAGE_SIZE;
+
+  // Space the responses by the server's rate limit if that is longer
+  req.responseSpacing = OTA_PAGE_RSP_SPACING;
+  if ( OTA_CLIENT_REQ_DELAY > req.responseSpacing )
+  {
+    req.responseSpacing = OTA_CLIENT_REQ_DELAY;
+  }
+
+  zclOTA_PageEnd = zclOTA_FileOffset + req.pageSize;
+
+  // Start a timer waiting for the first block of the page
+  osal_start_timerEx ( zclOTA_TaskID, ZCL_OTA_BLOCK_RSP_TO_EVT, OTA_CLIENT_RSP_WAIT );
+
+  return zclOTA_SendImagePageReq ( dstAddr, &req );
+}
+
+#if (OTA_CLIENT_ADAPTIVE == TRUE)
+/******************************************************************************
+ * @fn      zclOTA_AdaptInit
+ *
+ * @brief   Start a download with the default block size, no added delay and
+ *          the fixed response timeout until a round trip has been measured.
+ *
+ * @param   none
+ *
+ * @return  none
+ */
+static void zclOTA_AdaptInit ( void )
+{
+  zclOTA_AdaptBlockSize = ( OTA_MAX_MTU < OTA_ADAPT_MAX_BLOCK ) ? OTA_MAX_MTU : OTA_ADAPT_MAX_BLOCK;
+  zclOTA_AdaptGoodRsps = 0;
+  zclOTA_AdaptTiming = FALSE;
+  zclOTA_AdaptDelay = 0;
+  zclOTA_AdaptRtt = OTA_ADAPT_NO_RTT;
+  zclOTA_AdaptRttVar = 0;
+  zclOTA_AdaptRspWait = OTA_MAX_BLOCK_RSP_WAIT_TIME;
+}
+
+/******************************************************************************
+ * @fn      zclOTA_AdaptRsp
+ *
+ * @brief   Account for the expected block arriving.  A timed round trip
+ *          updates the response timeout.  A round trip over twice the
+ *          average adds to the request delay; otherwise every
+ *          OTA_ADAPT_GOOD_RSPS of them grow the block size and take from the
+ *          request delay.
+ *
+ * @param   none
+ *
+ * @return  none
+ */
+static void zclOTA_AdaptRsp ( void )
+{
+  uint32 rtt;
+  uint32 wait;
+  uint16 err;
+  uint8 slow = FALSE;
+
+  if ( !zclOTA_AdaptTiming )
+  {
+    return;
+  }
+
+  zclOTA_AdaptTiming = FALSE;
+
+  rtt = osal_GetSystemClock() - zclOTA_AdaptReqTime;
+  if ( rtt > OTA_MAX_BLOCK_RSP_WAIT_TIME )
+  {
+    rtt = OTA_MAX_BLOCK_RSP_WAIT_TIME;
+  }
+
+  if ( zclOTA_AdaptRtt == OTA_ADAPT_NO_RTT )
+  {
+    zclOTA_AdaptRtt = ( uint16 ) rtt;
+    zclOTA_AdaptRttVar = ( uint16 ) rtt / 2;
+  }
+  else
+  {
+    slow = ( rtt > 2 * ( uint32 ) zclOTA_AdaptRtt );
+
+    err = ( rtt > zclOTA_AdaptRtt ) ? ( uint16 ) rtt - zclOTA_AdaptRtt
+                                    : zclOTA_AdaptRtt - ( uint16 ) rtt;
+
+    // Gains of 1/4 and 1/8 as for the TCP retransmission timer
+    zclOTA_AdaptRttVar = zclOTA_AdaptRttVar - zclOTA_AdaptRttVar / 4 + err / 4;
+    zclOTA_AdaptRtt = zclOTA_AdaptRtt - zclOTA_AdaptRtt / 8 + ( uint16 ) rtt / 8;
+  }
+
+  wait = zclOTA_AdaptRtt + 4 * ( uint32 ) zclOTA_AdaptRttVar;
+  if ( wait < OTA_ADAPT_MIN_RSP_WAIT )
+  {
+    wait = OTA_ADAPT_MIN_RSP_WAIT;
+  }
+  else if ( wait > OTA_MAX_BLOCK_RSP_WAIT_TIME )
+  {
+    wait = OTA_MAX_BLOCK_RSP_WAIT_TIME;
+  }
+  zclOTA_AdaptRspWait = ( uint16 ) wait;
+
+  if ( slow )
+  {
+    // The link is getting busier, give it more time between requests
+    zclOTA_AdaptGoodRsps = 0;
+    if ( zclOTA_AdaptDelay + OTA_ADAPT_DELAY_STEP <= OTA_ADAPT_MAX_DELAY )
+    {
+      zclOTA_AdaptDelay += OTA_ADAPT_DELAY_STEP;
+    }
+  }
+  else if ( ++zclOTA_AdaptGoodRsps >= OTA_ADAPT_GOOD_RSPS )
+  {
+    zclOTA_AdaptGoodRsps = 0;
+
+    if ( zclOTA_AdaptBlockSize + OTA_ADAPT_BLOCK_STEP <= OTA_ADAPT_MAX_BLOCK )
+    {
+      zclOTA_AdaptBlockSize += OTA_ADAPT_BLOCK_STEP;
+    }
+    else
+    {
+      zclOTA_AdaptBlockSize = OTA_ADAPT_MAX_BLOCK;
+    }
+
+    zclOTA_AdaptDelay = ( zclOTA_AdaptDelay > OTA_ADAPT_DELAY_STEP ) ?
+                        zclOTA_AdaptDelay - OTA_ADAPT_DELAY_STEP : 0;
+  }
+}
+
+/******************************************************************************
+ * @fn      zclOTA_AdaptTimeout
+ *
+ * @brief   Back off after a block response timed out: halve the block size,
+ *          double the request delay and the response timeout.
+ *
+ * @param   none
+ *
+ * @return  none
+ */
+static void zclOTA_AdaptTimeout ( void )
+{
+  uint32 delay;
+
+  zclOTA_AdaptGoodRsps = 0;
+
+  zclOTA_AdaptBlockSize /= 2;
+  if ( zclOTA_AdaptBlockSize < OTA_ADAPT_MIN_BLOCK )
+  {
+    zclOTA_AdaptBlockSize = OTA_ADAPT_MIN_BLOCK;
+  }
+
+  delay = 2 * ( uint32 ) zclOTA_AdaptDelay + OTA_ADAPT_DELAY_STEP;
+  zclOTA_AdaptDelay = ( delay > OTA_ADAPT_MAX_DELAY ) ? OTA_ADAPT_MAX_DELAY : ( uint16 ) delay;
+
+  if ( zclOTA_AdaptRspWait < OTA_MAX_BLOCK_RSP_WAIT_TIME / 2 )
+  {
+    zclOTA_AdaptRspWait *= 2;
+  }
+  else
+  {
+    zclOTA_AdaptRspWait = OTA_MAX_BLOCK_RSP_WAIT_TIME;
+  }
+}
+#endif // (OTA_CLIENT_ADAPTIVE == TRUE)
+
 /******************************************************************************
  * @fn      zclOTA_ProcessImageData
  *
@@ -1720,6 +2128,10 @@ static ZStatus_t zclOTA_ProcessQueryNextImageRsp ( zclIncoming_t *pInMsg )
       // Store the file ID
       osal_memcpy ( &zclOTA_CurrentDlFileId, &param.fileId, sizeof ( zclOTA_FileID_t ) );
 
+#if (OTA_CLIENT_ADAPTIVE == TRUE)
+      zclOTA_AdaptInit();
+#endif
+
       // send image block request
       osal_start_timerEx ( zclOTA_TaskID, ZCL_OTA_IMAGE_BLOCK_REQ_DELAY_EVT, zclOTA_MinBlockReqDelay );
       status = ZCL_STATUS_CMD_HAS_RSP;
@@ -1808,9 +2220,27 @@ static ZStatus_t zclOTA_ProcessImageBlockRsp ( zclIncoming_t *pInMsg )
       // Drop duplicate packets (retries)
       if ( param.rsp.success.fileOffset != zclOTA_FileOffset )
       {
+        // A later block of the page means the expected one was lost; ask for
+        // the page again from the missing offset instead of waiting for the
+        // response timeout.  Blocks still in flight from the old page are
+        // dropped until the missing one arrives.
+        if ( zclOTA_ImagePageReq && !zclOTA_PageResync &&
+             ( param.rsp.success.fileOffset > zclOTA_FileOffset ) &&
+             ( param.rsp.success.fileOffset < zclOTA_PageEnd ) )
+        {
+          zclOTA_PageResync = TRUE;
+          sendImageBlockReq ( & ( pInMsg->msg->srcAddr ) );
+        }
+
         return ZSuccess;
       }
 
+      zclOTA_PageResync = FALSE;
+
+#if (OTA_CLIENT_ADAPTIVE == TRUE)
+      zclOTA_AdaptRsp();
+#endif
+
       status = zclOTA_ProcessImageData ( param.rsp.success.pData, param.rsp.success.dataSize );
 
       // Stop the timer and clear the retry count
@@ -1826,10 +2256,15 @@ static ZStatus_t zclOTA_ProcessImageBlockRsp ( zclIncoming_t *pInMsg )
           req.status = ZSuccess;
           zclOTA_SendUpgradeEndReq ( & ( pInMsg->msg->srcAddr ), &req );
         }
+        else if ( zclOTA_ImagePageReq && ( zclOTA_FileOffset < zclOTA_PageEnd ) )
+        {
+          // The rest of the page is on its way; wait for the next block
+          osal_start_timerEx ( zclOTA_TaskID, ZCL_OTA_BLOCK_RSP_TO_EVT, OTA_MAX_BLOCK_RSP_WAIT_TIME );
+        }
         else
         {
           // send image block request using rate limiting
-          osal_start_timerEx ( zclOTA_TaskID, ZCL_OTA_IMAGE_BLOCK_REQ_DELAY_EVT, zclOTA_MinBlockReqDelay );
+          osal_start_timerEx ( zclOTA_TaskID, ZCL_OTA_IMAGE_BLOCK_REQ_DELAY_EVT, OTA_CLIENT_REQ_DELAY );
         }
       }
     }
@@ -1869,7 +2304,7 @@ static ZStatus_t zclOTA_ProcessImageBlockRsp ( zclIncoming_t *pInMsg )
         // if wait timer delta is 0, then update device with blockReqDelay value and use rate limiting
         zclOTA_MinBlockReqDelay = param.rsp.wait.blockReqDelay;
 
-        osal_start_timerEx ( zclOTA_TaskID, ZCL_OTA_IMAGE_BLOCK_REQ_DELAY_EVT, zclOTA_MinBlockReqDelay );
+        osal_start_timerEx ( zclOTA_TaskID, ZCL_OTA_IMAGE_BLOCK_REQ_DELAY_EVT, OTA_CLIENT_REQ_DELAY );
       }
     }
     else
@@ -2050,6 +2485,10 @@ static ZStatus_t zclOTA_ProcessQuerySpecificFileRsp ( zclIncoming_t *pInMsg )
       // set state to 'in progress'
       zclOTA_ImageUpgradeStatus = OTA_STATUS_IN_PROGRESS;
 
+#if (OTA_CLIENT_ADAPTIVE == TRUE)
+      zclOTA_AdaptInit();
+#endif
+
       // send image block request
       sendImageBlockReq ( & ( pInMsg->msg->srcAddr ) );
     }
@@ -2286,6 +2725,12 @@ void zclOTA_ProcessNextImgRsp ( uint8* pMsg, zclOTA_FileID_t *pFileId,
 
   queryResponse = queryRsp; // save global variable for query image response. Used later in image block request check
 
+  // Give the client an entry in the session table for the download
+  if ( status == ZSuccess )
+  {
+    zclOTA_SessionOpen ( pAddr, pFileId, queryRsp.imageSize );
+  }
+
   // Send a response to the client
   if ( options & MT_OTA_QUERY_SPECIFIC_OPTION )
   {
@@ -2329,74 +2774,834 @@ void zclOTA_ProcessFileReadRsp ( uint8* pMsg, zclOTA_FileID_t *pFileId,
   else
   {
     blockRsp.status = ZOtaAbort;
+    osal_memcpy ( &blockRsp.rsp.success.fileId, pFileId, sizeof ( zclOTA_FileID_t ) );
   }
 
+#if (OTA_BLOCK_CACHE == TRUE)
+  // Reads issued for the cache are answered to the clients waiting on them
+  if ( ( pAddr->addrMode == afAddr16Bit ) && ( pAddr->addr.shortAddr == INVALID_NODE_ADDR ) )
+  {
+    zclOTA_CacheReadRsp ( pAddr->endPoint, &blockRsp );
+    return;
+  }
+#endif // (OTA_BLOCK_CACHE == TRUE)
+
   // Send the block response to the peer
-  zclOTA_SendImageBlockRsp ( pAddr, &blockRsp );
+  zclOTA_SendBlock ( pAddr, &blockRsp );
 }
 
 /******************************************************************************
- * @fn      OTA_HandleFileSysCb
+ * @fn      zclOTA_SendBlock
  *
- * @brief   Handles File Server Callbacks.
+ * @brief   Send an Image Block Response and keep the page being served to
+ *          the client going.
  *
- * @param   pMSGpkt - The data from the server.
+ * @param   pAddr - The client
+ *          pRsp - The block response
  *
  * @return  none
  */
-void zclOTA_ServerHandleFileSysCb ( OTA_MtMsg_t* pMSGpkt )
+static void zclOTA_SendBlock ( afAddrType_t *pAddr, zclOTA_ImageBlockRspParams_t *pRsp )
 {
-  zclOTA_FileID_t pFileId;
-  afAddrType_t pAddr;
-  uint8 *pMsg;
+  zclOTA_Session_t *pSession;
 
-  if ( pMSGpkt != NULL )
-  {
-    // Get the File ID and AF Address
-    pMsg = pMSGpkt->data;
-    pMsg = OTA_StreamToFileId ( &pFileId, pMsg );
-    pMsg = OTA_StreamToAfAddr ( &pAddr, pMsg );
+  zclOTA_SendImageBlockRsp ( pAddr, pRsp );
 
-    switch ( pMSGpkt->cmd )
-    {
-      case MT_OTA_NEXT_IMG_RSP:
-        zclOTA_ProcessNextImgRsp ( pMsg, &pFileId, &pAddr );
-        break;
+  pSession = zclOTA_SessionFind ( pAddr );
 
-      case MT_OTA_FILE_READ_RSP:
-        zclOTA_ProcessFileReadRsp ( pMsg, &pFileId, &pAddr );
-        break;
+  if ( ( pSession != NULL ) && ( pSession->pageState == OTA_PAGE_READ ) )
+  {
+    if ( pRsp->status != ZSuccess )
+    {
+      pSession->pageState = OTA_PAGE_IDLE;
+    }
+    else if ( pRsp->rsp.success.fileOffset == pSession->pageOffset )
+    {
+      pSession->pageOffset += pRsp->rsp.success.dataSize;
+      pSession->lastActivity = osal_getClock();
 
-      default:
-        break;
+      if ( ( pRsp->rsp.success.dataSize != 0 ) &&
+           ( pSession->pageOffset < pSession->pageEnd ) )
+      {
+        // Send the next block when its time slot comes
+        pSession->pageState = OTA_PAGE_DUE;
+        pSession->pageDue = osal_GetSystemClock() + pSession->responseSpacing;
+        zclOTA_PageArm();
+      }
+      else
+      {
+        pSession->pageState = OTA_PAGE_IDLE;
+      }
     }
   }
 }
 
 /******************************************************************************
- * @fn      zclOTA_Srv_QueryNextImageReq
+ * @fn      zclOTA_SendWaitRsp
  *
- * @brief   Handle a Query Next Image Request.
+ * @brief   Send an Image Block Response with status wait for data.
  *
- * @param   pSrcAddr - The source of the message
- *          pParam - message parameters
+ * @param   pAddr - The client
+ *          currentTime - Server time, in seconds
+ *          requestTime - Time the client is to ask again, in seconds
+ *          blockReqDelay - Block request delay for the client, in ms
  *
- * @return  ZStatus_t
+ * @return  none
+ */
+static void zclOTA_SendWaitRsp ( afAddrType_t *pAddr, uint32 currentTime,
+                                 uint32 requestTime, uint16 blockReqDelay )
+{
+  zclOTA_ImageBlockRspParams_t blockRsp;
+
+  blockRsp.status = ZOtaWaitForData;
+  blockRsp.rsp.wait.currentTime = currentTime;
+  blockRsp.rsp.wait.requestTime = requestTime;
+  blockRsp.rsp.wait.blockReqDelay = blockReqDelay;
+
+  zclOTA_SendImageBlockRsp ( pAddr, &blockRsp );
+}
+
+/******************************************************************************
+ * @fn      zclOTA_ReadBlock
  *
- * @note    On a query next image, we must request a file listing
- *          from the File Server.  Then open a file if
+ * @brief   Get an image block for a client.  The block is sent from the
+ *          block cache when it holds it, otherwise it is read from the
+ *          console and sent when the console answers.
+ *
+ * @param   pAddr - The client
+ *          pFileId - The image
+ *          len - Maximum number of bytes to send
+ *          offset - Offset of the block in the image
+ *
+ * @return  ZSuccess if the block was sent or will be sent
  */
-ZStatus_t zclOTA_Srv_QueryNextImageReq ( afAddrType_t *pSrcAddr, zclOTA_QueryNextImageReqParams_t *pParam )
+static uint8 zclOTA_ReadBlock ( afAddrType_t *pAddr, zclOTA_FileID_t *pFileId,
+                                uint8 len, uint32 offset )
 {
-  uint8 options = 0;
-  uint8 status;
+#if (OTA_BLOCK_CACHE == TRUE)
+  zclOTA_CacheEntry_t *pEntry = zclOTA_CacheFind ( pFileId, offset );
+  uint8 hit = TRUE;
 
-  if ( zclOTA_Permit )
+  if ( pEntry == NULL )
   {
-    if ( pParam->fieldControl )
-    {
-      options |= MT_OTA_HW_VER_PRESENT_OPTION;
-    }
+    zclOTA_CacheStats.misses++;
+    pEntry = zclOTA_CacheFill ( pFileId, offset );
+    hit = FALSE;
+  }
+
+  if ( pEntry != NULL )
+  {
+    if ( !pEntry->pending )
+    {
+      zclOTA_CacheStats.hits++;
+      zclOTA_CacheServe ( pEntry, pAddr, len, offset, TRUE );
+      zclOTA_CacheReadAhead ( pFileId, pEntry->offset + pEntry->len );
+
+      return ZSuccess;
+    }
+
+    if ( pEntry->waiters < OTA_BLOCK_CACHE_WAITERS )
+    {
+      // Answer the client when the outstanding read completes
+      pEntry->waiter[pEntry->waiters].addr = *pAddr;
+      pEntry->waiter[pEntry->waiters].skip = ( uint8 ) ( offset - pEntry->offset );
+      pEntry->waiter[pEntry->waiters].len = len;
+      pEntry->waiter[pEntry->waiters].hit = hit;
+      pEntry->waiters++;
+
+      if ( hit )
+      {
+        zclOTA_CacheStats.hits++;
+      }
+      zclOTA_CacheReadAhead ( pFileId, pEntry->offset + OTA_SERVER_BLOCK_SIZE );
+
+      return ZSuccess;
+    }
+  }
+#endif // (OTA_BLOCK_CACHE == TRUE)
+
+  // Read the data from the OTA Console
+  return MT_OtaFileReadReq ( pAddr, pFileId, len, offset );
+}
+
+#if (OTA_BLOCK_CACHE == TRUE)
+/******************************************************************************
+ * @fn      zclOTA_CacheFind
+ *
+ * @brief   Find the cache entry holding, or reading, an image offset.
+ *
+ * @param   pFileId - The image
+ *          offset - Offset in the image
+ *
+ * @return  The entry or NULL
+ */
+static zclOTA_CacheEntry_t *zclOTA_CacheFind ( zclOTA_FileID_t *pFileId, uint32 offset )
+{
+  uint32 now = osal_getClock();
+  uint8 i;
+
+  for ( i = 0; i < OTA_BLOCK_CACHE_ENTRIES; i++ )
+  {
+    zclOTA_CacheEntry_t *pEntry = &zclOTA_Cache[i];
+
+    if ( ( offset < pEntry->offset ) ||
+         !osal_memcmp ( &pEntry->fileId, pFileId, sizeof ( zclOTA_FileID_t ) ) )
+    {
+      continue;
+    }
+
+    if ( pEntry->pending )
+    {
+      // A read the console never answered does not hold the block
+      if ( ( ( now - pEntry->stamp ) < OTA_BLOCK_CACHE_READ_TIMEOUT ) &&
+           ( offset < pEntry->offset + OTA_SERVER_BLOCK_SIZE ) )
+      {
+        return pEntry;
+      }
+    }
+    else if ( offset < pEntry->offset + pEntry->len )
+    {
+      return pEntry;
+    }
+  }
+
+  return NULL;
+}
+
+/******************************************************************************
+ * @fn      zclOTA_CacheFill
+ *
+ * @brief   Take the least recently used cache entry and read a full block
+ *          into it from the console.
+ *
+ * @param   pFileId - The image
+ *          offset - Offset of the block in the image
+ *
+ * @return  The entry or NULL if no entry is free or the read failed
+ */
+static zclOTA_CacheEntry_t *zclOTA_CacheFill ( zclOTA_FileID_t *pFileId, uint32 offset )
+{
+  zclOTA_CacheEntry_t *pEntry = NULL;
+  uint32 now = osal_getClock();
+  uint16 oldest = 0;
+  uint8 i;
+
+  for ( i = 0; i < OTA_BLOCK_CACHE_ENTRIES; i++ )
+  {
+    zclOTA_CacheEntry_t *pCur = &zclOTA_Cache[i];
+    uint16 idle = zclOTA_CacheClock - pCur->age;
+
+    // Entries with a read outstanding are kept until it times out
+    if ( pCur->pending && ( ( now - pCur->stamp ) < OTA_BLOCK_CACHE_READ_TIMEOUT ) )
+    {
+      continue;
+    }
+
+    if ( ( pCur->len == 0 ) && !pCur->pending )
+    {
+      pEntry = pCur;
+      break;
+    }
+
+    if ( ( pEntry == NULL ) || ( idle > oldest ) )
+    {
+      pEntry = pCur;
+      oldest = idle;
+    }
+  }
+
+  if ( pEntry != NULL )
+  {
+    osal_memcpy ( &pEntry->fileId, pFileId, sizeof ( zclOTA_FileID_t ) );
+    pEntry->offset = offset;
+    pEntry->stamp = now;
+    pEntry->age = ++zclOTA_CacheClock;
+    pEntry->len = 0;
+    pEntry->pending = TRUE;
+    pEntry->waiters = 0;
+
+    // The console answers to an address no client has, whose endpoint
+    // is the cache entry
+    {
+      afAddrType_t fillAddr;
+
+      fillAddr.addrMode = afAddr16Bit;
+      fillAddr.addr.shortAddr = INVALID_NODE_ADDR;
+      fillAddr.endPoint = ( uint8 ) ( pEntry - zclOTA_Cache );
+      fillAddr.panId = 0;
+
+      if ( MT_OtaFileReadReq ( &fillAddr, pFileId, OTA_SERVER_BLOCK_SIZE, offset ) != ZSuccess )
+      {
+        pEntry->pending = FALSE;
+        return NULL;
+      }
+    }
+
+    zclOTA_CacheStats.reads++;
+  }
+
+  return pEntry;
+}
+
+/******************************************************************************
+ * @fn      zclOTA_CacheReadAhead
+ *
+ * @brief   Read the blocks following a requested block into the cache, so
+ *          they are there when the clients ask for them.
+ *
+ * @param   pFileId - The image
+ *          offset - Offset of the first block to read ahead
+ *
+ * @return  none
+ */
+static void zclOTA_CacheReadAhead ( zclOTA_FileID_t *pFileId, uint32 offset )
+{
+  uint8 i;
+
+  uint32 imageSize = zclOTA_ImageSize ( pFileId );
+
+  for ( i = 0; i < OTA_BLOCK_CACHE_READ_AHEAD; i++ )
+  {
+    if ( offset >= imageSize )
+    {
+      break;
+    }
+
+    if ( ( zclOTA_CacheFind ( pFileId, offset ) == NULL ) &&
+         ( zclOTA_CacheFill ( pFileId, offset ) == NULL ) )
+    {
+      break;
+    }
+
+    offset += OTA_SERVER_BLOCK_SIZE;
+  }
+}
+
+/******************************************************************************
+ * @fn      zclOTA_CacheServe
+ *
+ * @brief   Send a client a block from a cache entry.
+ *
+ * @param   pEntry - The cache entry
+ *          pAddr - The client
+ *          len - Maximum number of bytes to send
+ *          offset - Offset of the block in the image
+ *          hit - TRUE if the client did not cause the console read
+ *
+ * @return  none
+ */
+static void zclOTA_CacheServe ( zclOTA_CacheEntry_t *pEntry, afAddrType_t *pAddr,
+                                uint8 len, uint32 offset, uint8 hit )
+{
+  zclOTA_ImageBlockRspParams_t blockRsp;
+  uint32 skip = offset - pEntry->offset;
+
+  if ( skip >= pEntry->len )
+  {
+    // Past the end of the image; the client's retry gets it an abort
+    return;
+  }
+
+  if ( len > pEntry->len - skip )
+  {
+    len = pEntry->len - ( uint8 ) skip;
+  }
+
+  blockRsp.status = ZSuccess;
+  osal_memcpy ( &blockRsp.rsp.success.fileId, &pEntry->fileId, sizeof ( zclOTA_FileID_t ) );
+  blockRsp.rsp.success.fileOffset = offset;
+  blockRsp.rsp.success.dataSize = len;
+  blockRsp.rsp.success.pData = pEntry->data + skip;
+
+  pEntry->age = ++zclOTA_CacheClock;
+
+  if ( hit )
+  {
+    zclOTA_CacheStats.bytesSaved += len;
+  }
+
+  zclOTA_SendBlock ( pAddr, &blockRsp );
+}
+
+/******************************************************************************
+ * @fn      zclOTA_CacheReadRsp
+ *
+ * @brief   Store a block read for the cache and send it to the clients
+ *          waiting for it.  A failed read aborts only the clients waiting
+ *          on that entry, as without the cache.
+ *
+ * @param   idx - The cache entry the read was issued for
+ *          pRsp - The block read from the console
+ *
+ * @return  none
+ */
+static void zclOTA_CacheReadRsp ( uint8 idx, zclOTA_ImageBlockRspParams_t *pRsp )
+{
+  zclOTA_CacheEntry_t *pEntry;
+  uint8 j;
+
+  if ( idx >= OTA_BLOCK_CACHE_ENTRIES )
+  {
+    return;
+  }
+  pEntry = &zclOTA_Cache[idx];
+
+  if ( !pEntry->pending ||
+       !osal_memcmp ( &pEntry->fileId, &pRsp->rsp.success.fileId, sizeof ( zclOTA_FileID_t ) ) )
+  {
+    return;
+  }
+
+  if ( pRsp->status != ZSuccess )
+  {
+    pEntry->pending = FALSE;
+    pEntry->len = 0;
+
+    for ( j = 0; j < pEntry->waiters; j++ )
+    {
+      zclOTA_SendBlock ( &pEntry->waiter[j].addr, pRsp );
+    }
+    pEntry->waiters = 0;
+  }
+  else if ( pEntry->offset == pRsp->rsp.success.fileOffset )
+  {
+    pEntry->len = pRsp->rsp.success.dataSize;
+    if ( pEntry->len > OTA_SERVER_BLOCK_SIZE )
+    {
+      pEntry->len = OTA_SERVER_BLOCK_SIZE;
+    }
+    osal_memcpy ( pEntry->data, pRsp->rsp.success.pData, pEntry->len );
+    pEntry->pending = FALSE;
+
+    for ( j = 0; j < pEntry->waiters; j++ )
+    {
+      zclOTA_CacheServe ( pEntry, &pEntry->waiter[j].addr, pEntry->waiter[j].len,
+                          pEntry->offset + pEntry->waiter[j].skip, pEntry->waiter[j].hit );
+    }
+    pEntry->waiters = 0;
+  }
+}
+#endif // (OTA_BLOCK_CACHE == TRUE)
+
+/******************************************************************************
+ * @fn      zclOTA_PageReadNext
+ *
+ * @brief   Get the next block of the page being served to a client.
+ *
+ * @param   pSession - The client's session
+ *
+ * @return  none
+ */
+static void zclOTA_PageReadNext ( zclOTA_Session_t *pSession )
+{
+  uint32 left = pSession->pageEnd - pSession->pageOffset;
+  uint8 len = pSession->maxDataSize;
+
+  if ( left < len )
+  {
+    len = ( uint8 ) left;
+  }
+
+  pSession->pageState = OTA_PAGE_READ;
+
+  if ( zclOTA_ReadBlock ( &pSession->addr, &pSession->fileId,
+                          len, pSession->pageOffset ) != ZSuccess )
+  {
+    // Stop the page and have the client ask again after its block delay
+    pSession->pageState = OTA_PAGE_IDLE;
+
+    zclOTA_SendWaitRsp ( &pSession->addr, 0, OTA_SEND_BLOCK_WAIT, pSession->blockReqDelay );
+  }
+}
+
+/******************************************************************************
+ * @fn      zclOTA_PageSchedule
+ *
+ * @brief   Get the next block of every page whose time slot has come.  The
+ *          sessions take turns at being served first.
+ *
+ * @param   none
+ *
+ * @return  none
+ */
+static void zclOTA_PageSchedule ( void )
+{
+  uint32 now = osal_GetSystemClock();
+  uint8 i;
+
+  for ( i = 0; i < OTA_SERVER_MAX_SESSIONS; i++ )
+  {
+    zclOTA_Session_t *pSession = &zclOTA_Sessions[( zclOTA_PageNext + i ) % OTA_SERVER_MAX_SESSIONS];
+
+    if ( pSession->inUse && ( pSession->pageState == OTA_PAGE_DUE ) &&
+         ( ( int32 ) ( pSession->pageDue - now ) <= 0 ) )
+    {
+      zclOTA_PageReadNext ( pSession );
+    }
+  }
+
+  zclOTA_PageNext = ( zclOTA_PageNext + 1 ) % OTA_SERVER_MAX_SESSIONS;
+
+  zclOTA_PageArm();
+}
+
+/******************************************************************************
+ * @fn      zclOTA_PageArm
+ *
+ * @brief   Start the page timer for the earliest page block due.
+ *
+ * @param   none
+ *
+ * @return  none
+ */
+static void zclOTA_PageArm ( void )
+{
+  uint32 now = osal_GetSystemClock();
+  uint32 wait = 0xFFFFFFFF;
+  uint8 i;
+
+  for ( i = 0; i < OTA_SERVER_MAX_SESSIONS; i++ )
+  {
+    zclOTA_Session_t *pSession = &zclOTA_Sessions[i];
+
+    if ( pSession->inUse && ( pSession->pageState == OTA_PAGE_DUE ) )
+    {
+      int32 due = ( int32 ) ( pSession->pageDue - now );
+
+      if ( due <= 0 )
+      {
+        wait = 0;
+        break;
+      }
+
+      if ( ( uint32 ) due < wait )
+      {
+        wait = ( uint32 ) due;
+      }
+    }
+  }
+
+  if ( wait != 0xFFFFFFFF )
+  {
+    osal_start_timerEx ( zclOTA_TaskID, ZCL_OTA_IMAGE_PAGE_RSP_EVT, wait );
+  }
+}
+
+/******************************************************************************
+ * @fn      zclOTA_SessionFind
+ *
+ * @brief   Find the session of a client.
+ *
+ * @param   pAddr - The client
+ *
+ * @return  The session or NULL
+ */
+static zclOTA_Session_t *zclOTA_SessionFind ( afAddrType_t *pAddr )
+{
+  uint8 i;
+
+  for ( i = 0; i < OTA_SERVER_MAX_SESSIONS; i++ )
+  {
+    zclOTA_Session_t *pSession = &zclOTA_Sessions[i];
+
+    if ( pSession->inUse &&
+         ( pSession->addr.addr.shortAddr == pAddr->addr.shortAddr ) &&
+         ( pSession->addr.endPoint == pAddr->endPoint ) )
+    {
+      return pSession;
+    }
+  }
+
+  return NULL;
+}
+
+/******************************************************************************
+ * @fn      zclOTA_SessionOpen
+ *
+ * @brief   Start a session for a client about to download an image.  The
+ *          client's existing session is reused; otherwise a free entry, or
+ *          the entry of the client idle longest past OTA_SESSION_TIMEOUT.
+ *
+ * @param   pAddr - The client
+ *          pFileId - The image
+ *          imageSize - Size of the image
+ *
+ * @return  The session or NULL if the table is full
+ */
+static zclOTA_Session_t *zclOTA_SessionOpen ( afAddrType_t *pAddr, zclOTA_FileID_t *pFileId,
+                                              uint32 imageSize )
+{
+  zclOTA_Session_t *pSession = zclOTA_SessionFind ( pAddr );
+  uint32 now = osal_getClock();
+  uint8 i;
+
+  for ( i = 0; ( pSession == NULL ) && ( i < OTA_SERVER_MAX_SESSIONS ); i++ )
+  {
+    if ( !zclOTA_Sessions[i].inUse )
+    {
+      pSession = &zclOTA_Sessions[i];
+    }
+  }
+
+  if ( pSession == NULL )
+  {
+    uint32 idleMax = OTA_SESSION_TIMEOUT;
+
+    for ( i = 0; i < OTA_SERVER_MAX_SESSIONS; i++ )
+    {
+      zclOTA_Session_t *pCur = &zclOTA_Sessions[i];
+
+      if ( ( now - pCur->lastActivity ) >= idleMax )
+      {
+        pSession = pCur;
+        idleMax = now - pCur->lastActivity;
+      }
+    }
+  }
+
+  if ( pSession != NULL )
+  {
+    pSession->addr = *pAddr;
+    osal_memcpy ( &pSession->fileId, pFileId, sizeof ( zclOTA_FileID_t ) );
+    pSession->imageSize = imageSize;
+    pSession->offset = 0;
+    pSession->lastActivity = now;
+    pSession->blockReqDelay = zclOTA_MinBlockReqDelay;
+    pSession->progress = 0;
+    pSession->pageState = OTA_PAGE_IDLE;
+    pSession->inUse = TRUE;
+  }
+
+  return pSession;
+}
+
+/******************************************************************************
+ * @fn      zclOTA_SessionCheck
+ *
+ * @brief   Get the session for a block or page request.  A client without a
+ *          session that asks for the image last announced is given one.
+ *
+ * @param   pAddr - The client
+ *          pFileId - The image asked for
+ *          pStatus - Set to the command status when no session is returned
+ *
+ * @return  The session or NULL
+ */
+static zclOTA_Session_t *zclOTA_SessionCheck ( afAddrType_t *pAddr, zclOTA_FileID_t *pFileId,
+                                               uint8 *pStatus )
+{
+  zclOTA_Session_t *pSession = zclOTA_SessionFind ( pAddr );
+
+  if ( pSession == NULL )
+  {
+    if ( ( queryResponse.status != ZSuccess ) ||
+         !osal_memcmp ( &queryResponse.fileId, pFileId, sizeof ( zclOTA_FileID_t ) ) )
+    {
+      *pStatus = ZCL_STATUS_NO_IMAGE_AVAILABLE;
+      return NULL;
+    }
+
+    pSession = zclOTA_SessionOpen ( pAddr, pFileId, queryResponse.imageSize );
+
+    if ( pSession == NULL )
+    {
+      uint32 now = osal_getClock();
+
+      // Every entry is busy; have the client come back later
+      zclOTA_SendWaitRsp ( pAddr, now, now + OTA_SESSION_BUSY_WAIT, zclOTA_MinBlockReqDelay );
+
+      *pStatus = ZCL_STATUS_CMD_HAS_RSP;
+      return NULL;
+    }
+  }
+  else if ( !osal_memcmp ( &pSession->fileId, pFileId, sizeof ( zclOTA_FileID_t ) ) )
+  {
+    *pStatus = ZCL_STATUS_NO_IMAGE_AVAILABLE;
+    return NULL;
+  }
+
+  return pSession;
+}
+
+/******************************************************************************
+ * @fn      zclOTA_SessionProgress
+ *
+ * @brief   Record a client's request and report its progress to the console
+ *          every OTA_SERVER_PROGRESS_STEP percent.  The progress counts the
+ *          data asked for, so the request for the last block reports 100.
+ *
+ * @param   pSession - The client's session
+ *          offset - Offset the client asked for
+ *          len - Amount of data the client asked for
+ *
+ * @return  none
+ */
+static void zclOTA_SessionProgress ( zclOTA_Session_t *pSession, uint32 offset, uint32 len )
+{
+  uint8 percent;
+
+  pSession->offset = offset;
+  pSession->lastActivity = osal_getClock();
+
+  if ( ( pSession->imageSize == 0 ) || ( offset > pSession->imageSize ) )
+  {
+    return;
+  }
+
+  if ( len > pSession->imageSize - offset )
+  {
+    len = pSession->imageSize - offset;
+  }
+  offset += len;
+
+  if ( pSession->imageSize > 0x00FFFFFF )
+  {
+    percent = ( uint8 ) MIN( offset / ( pSession->imageSize / 100 ), 100 );
+  }
+  else
+  {
+    percent = ( uint8 ) ( ( offset * 100 ) / pSession->imageSize );
+  }
+
+  if ( percent >= pSession->progress + OTA_SERVER_PROGRESS_STEP )
+  {
+    pSession->progress = percent - ( percent % OTA_SERVER_PROGRESS_STEP );
+
+    MT_OtaSendStatus ( pSession->addr.addr.shortAddr, MT_OTA_DL_PROGRESS,
+                       ZSuccess, pSession->progress );
+  }
+}
+
+/******************************************************************************
+ * @fn      zclOTA_SessionDelay
+ *
+ * @brief   Block request delay that shares the network equally between the
+ *          clients currently downloading.
+ *
+ * @param   none
+ *
+ * @return  Delay, in ms
+ */
+static uint16 zclOTA_SessionDelay ( void )
+{
+  uint32 now = osal_getClock();
+  uint32 delay;
+  uint8 active = 0;
+  uint8 i;
+
+  for ( i = 0; i < OTA_SERVER_MAX_SESSIONS; i++ )
+  {
+    if ( zclOTA_Sessions[i].inUse &&
+         ( ( now - zclOTA_Sessions[i].lastActivity ) < OTA_SESSION_TIMEOUT ) )
+    {
+      active++;
+    }
+  }
+
+  delay = ( uint32 ) active * OTA_SERVER_BLOCK_INTERVAL;
+
+  if ( delay < zclOTA_MinBlockReqDelay )
+  {
+    delay = zclOTA_MinBlockReqDelay;
+  }
+
+  return ( delay > 0xFFFF ) ? 0xFFFF : ( uint16 ) delay;
+}
+
+#if (OTA_BLOCK_CACHE == TRUE)
+/******************************************************************************
+ * @fn      zclOTA_ImageSize
+ *
+ * @brief   Size of an image being downloaded from the server.
+ *
+ * @param   pFileId - The image
+ *
+ * @return  Size of the image, 0 if no client is downloading it
+ */
+static uint32 zclOTA_ImageSize ( zclOTA_FileID_t *pFileId )
+{
+  uint8 i;
+
+  for ( i = 0; i < OTA_SERVER_MAX_SESSIONS; i++ )
+  {
+    if ( zclOTA_Sessions[i].inUse &&
+         osal_memcmp ( &zclOTA_Sessions[i].fileId, pFileId, sizeof ( zclOTA_FileID_t ) ) )
+    {
+      return zclOTA_Sessions[i].imageSize;
+    }
+  }
+
+  return 0;
+}
+#endif // (OTA_BLOCK_CACHE == TRUE)
+
+/******************************************************************************
+ * @fn      OTA_HandleFileSysCb
+ *
+ * @brief   Handles File Server Callbacks.
+ *
+ * @param   pMSGpkt - The data from the server.
+ *
+ * @return  none
+ */
+void zclOTA_ServerHandleFileSysCb ( OTA_MtMsg_t* pMSGpkt )
+{
+  zclOTA_FileID_t pFileId;
+  afAddrType_t pAddr;
+  uint8 *pMsg;
+
+  if ( pMSGpkt != NULL )
+  {
+    // Get the File ID and AF Address
+    pMsg = pMSGpkt->data;
+    pMsg = OTA_StreamToFileId ( &pFileId, pMsg );
+    pMsg = OTA_StreamToAfAddr ( &pAddr, pMsg );
+
+    switch ( pMSGpkt->cmd )
+    {
+      case MT_OTA_NEXT_IMG_RSP:
+        zclOTA_ProcessNextImgRsp ( pMsg, &pFileId, &pAddr );
+        break;
+
+      case MT_OTA_FILE_READ_RSP:
+        zclOTA_ProcessFileReadRsp ( pMsg, &pFileId, &pAddr );
+        break;
+
+      default:
+        break;
+    }
+  }
+}
+
+/******************************************************************************
+ * @fn      zclOTA_Srv_QueryNextImageReq
+ *
+ * @brief   Handle a Query Next Image Request.
+ *
+ * @param   pSrcAddr - The source of the message
+ *          pParam - message parameters
+ *
+ * @return  ZStatus_t
+ *
+ * @note    On a query next image, we must request a file listing
+ *          from the File Server.  Then open a file if
+ */
+ZStatus_t zclOTA_Srv_QueryNextImageReq ( afAddrType_t *pSrcAddr, zclOTA_QueryNextImageReqParams_t *pParam )
+{
+  uint8 options = 0;
+  uint8 status;
+
+  if ( zclOTA_Permit )
+  {
+    if ( pParam->fieldControl )
+    {
+      options |= MT_OTA_HW_VER_PRESENT_OPTION;
+    }
+
+    // Pick up a block delay set by the console before the download starts;
+    // the block requests of the download use this value
+    osal_nv_read ( ZCD_NV_OTA_BLOCK_REQ_DELAY, 0,
+                   sizeof ( zclOTA_MinBlockReqDelay ), &zclOTA_MinBlockReqDelay );
 
     // Request the next image for this device from the console via the MT File System
     status = MT_OtaGetImage ( pSrcAddr, &pParam->fileId, pParam->hardwareVersion, NULL, options );
@@ -2434,78 +3639,53 @@ ZStatus_t zclOTA_Srv_QueryNextImageReq ( afAddrType_t *pSrcAddr, zclOTA_QueryNex
  */
 ZStatus_t zclOTA_Srv_ImageBlockReq ( afAddrType_t *pSrcAddr, zclOTA_ImageBlockReqParams_t *pParam )
 {
+  zclOTA_Session_t *pSession;
   uint8 status = ZFailure;
+  uint8 len;
 
-  if ( pParam->fileId.version != queryResponse.fileId.version )
+  pSession = zclOTA_SessionCheck ( pSrcAddr, &pParam->fileId, &status );
+
+  if ( ( pSession == NULL ) || !zclOTA_Permit )
   {
-    status = ZCL_STATUS_NO_IMAGE_AVAILABLE;
+    return status;
   }
-  else
-  {
 
-    if ( zclOTA_Permit && ( pParam != NULL ) )
-    {
-      uint8 len = pParam->maxDataSize;
-
-      if ( len > OTA_MAX_MTU )
-      {
-        len = OTA_MAX_MTU;
-      }
-
-      // The item already exists in NV memory, read it from NV memory
-      osal_nv_read ( ZCD_NV_OTA_BLOCK_REQ_DELAY, 0,
-                     sizeof ( zclOTA_MinBlockReqDelay ), &zclOTA_MinBlockReqDelay );
-
-      // check if client supports rate limiting feature, and if client rate needs to be set
-      if ( ( ( pParam->fieldControl & OTA_BLOCK_FC_REQ_DELAY_PRESENT ) != 0 ) &&
-           ( pParam->blockReqDelay != zclOTA_MinBlockReqDelay ) )
-      {
-        zclOTA_ImageBlockRspParams_t blockRsp;
-
-        // Fill in the response parameters
-        blockRsp.status = ZOtaWaitForData;
-        osal_memcpy ( &blockRsp.rsp.success.fileId, &pParam->fileId, sizeof ( zclOTA_FileID_t ) );
-        blockRsp.rsp.wait.currentTime = 0;
-        blockRsp.rsp.wait.requestTime = 0;
-        blockRsp.rsp.wait.blockReqDelay = zclOTA_MinBlockReqDelay;
-
-        // Send a wait response with updated rate limit timing
-        zclOTA_SendImageBlockRsp ( pSrcAddr, &blockRsp );
-      }
-      else
-      {
-        // Read the data from the OTA Console
-        status = MT_OtaFileReadReq ( pSrcAddr, &pParam->fileId, len, pParam->fileOffset );
-
-        // Send a wait response to the client
-        if ( status != ZSuccess )
-        {
-          zclOTA_ImageBlockRspParams_t blockRsp;
-
-          // Fill in the response parameters
-          blockRsp.status = ZOtaWaitForData;
-          osal_memcpy ( &blockRsp.rsp.success.fileId, &pParam->fileId, sizeof ( zclOTA_FileID_t ) );
-          blockRsp.rsp.wait.currentTime = 0;
-          blockRsp.rsp.wait.requestTime = OTA_SEND_BLOCK_WAIT;
-          blockRsp.rsp.wait.blockReqDelay = zclOTA_MinBlockReqDelay;
-
-          // Send the block to the peer
-          zclOTA_SendImageBlockRsp ( pSrcAddr, &blockRsp );
-        }
-      }
+  len = pParam->maxDataSize;
+  if ( len > OTA_SERVER_BLOCK_SIZE )
+  {
+    len = OTA_SERVER_BLOCK_SIZE;
+  }
 
-      status = ZCL_STATUS_CMD_HAS_RSP;
+  zclOTA_SessionProgress ( pSession, pParam->fileOffset, len );
+  pSession->blockReqDelay = zclOTA_SessionDelay();
 
+  // check if client supports rate limiting feature, and if client rate needs to be set
+  if ( ( ( pParam->fieldControl & OTA_BLOCK_FC_REQ_DELAY_PRESENT ) != 0 ) &&
+       ( pParam->blockReqDelay != pSession->blockReqDelay ) )
+  {
+    // Send a wait response with updated rate limit timing
+    zclOTA_SendWaitRsp ( pSrcAddr, 0, 0, pSession->blockReqDelay );
+  }
+  else
+  {
+    // Send the data from the block cache or the OTA Console
+    if ( zclOTA_ReadBlock ( pSrcAddr, &pParam->fileId, len, pParam->fileOffset ) != ZSuccess )
+    {
+      // Send a wait response to the client
+      zclOTA_SendWaitRsp ( pSrcAddr, 0, OTA_SEND_BLOCK_WAIT, pSession->blockReqDelay );
     }
   }
 
-  return status;
+  return ZCL_STATUS_CMD_HAS_RSP;
 }
 
 /******************************************************************************
  * @fn      zclOTA_Srv_ImagePageReq
  *
- * @brief   Handle an Image Page Request.  Note: Not currently supported.
+ * @brief   Handle an Image Page Request.  The blocks of the page are read
+ *          one at a time and sent to the client spaced by the requested
+ *          response spacing, or the client's block request delay if that is
+ *          longer.  A new request from the client replaces its current page.
  *
  * @param   pSrcAddr - The source of the message
  *          pParam - message parameters
@@ -2514,8 +3694,47 @@ ZStatus_t zclOTA_Srv_ImageBlockReq ( afAddrType_t *pSrcAddr, zclOTA_ImageBlockRe
  */
 ZStatus_t zclOTA_Srv_ImagePageReq ( afAddrType_t *pSrcAddr, zclOTA_ImagePageReqParams_t *pParam )
 {
-  // Send not supported resposne
-  return ZUnsupClusterCmd;
+  zclOTA_Session_t *pSession;
+  uint8 status = ZFailure;
+
+  pSession = zclOTA_SessionCheck ( pSrcAddr, &pParam->fileId, &status );
+
+  if ( ( pSession == NULL ) || !zclOTA_Permit )
+  {
+    return status;
+  }
+
+  if ( ( pParam->pageSize == 0 ) || ( pParam->maxDataSize == 0 ) ||
+       ( pParam->fileOffset >= pSession->imageSize ) )
+  {
+    return ZCL_STATUS_INVALID_VALUE;
+  }
+
+  zclOTA_SessionProgress ( pSession, pParam->fileOffset, pParam->pageSize );
+  pSession->blockReqDelay = zclOTA_SessionDelay();
+
+  pSession->pageOffset = pParam->fileOffset;
+  pSession->pageEnd = pParam->fileOffset + pParam->pageSize;
+  if ( pSession->pageEnd > pSession->imageSize )
+  {
+    pSession->pageEnd = pSession->imageSize;
+  }
+
+  pSession->responseSpacing = pParam->responseSpacing;
+  if ( pSession->blockReqDelay > pSession->responseSpacing )
+  {
+    pSession->responseSpacing = pSession->blockReqDelay;
+  }
+
+  pSession->maxDataSize = pParam->maxDataSize;
+  if ( pSession->maxDataSize > OTA_SERVER_BLOCK_SIZE )
+  {
+    pSession->maxDataSize = OTA_SERVER_BLOCK_SIZE;
+  }
+
+  zclOTA_PageReadNext ( pSession );
+
+  return ZCL_STATUS_CMD_HAS_RSP;
 }
 
 /******************************************************************************
@@ -2536,6 +3755,14 @@ ZStatus_t zclOTA_Srv_UpgradeEndReq ( afAddrType_t *pSrcAddr, zclOTA_UpgradeEndRe
   {
     zclOTA_UpgradeEndRspParams_t rspParms;
 
+    zclOTA_Session_t *pSession = zclOTA_SessionFind ( pSrcAddr );
+
+    // The download is over; free the client's session
+    if ( pSession != NULL )
+    {
+      pSession->inUse = FALSE;
+    }
+
     if ( pParam->status == ZSuccess )
     {
       osal_memcpy ( &rspParms.fileId, &pParam->fileId, sizeof ( zclOTA_FileID_t ) );
@@ -2572,6 +3799,10 @@ ZStatus_t zclOTA_Srv_QuerySpecificFileReq ( afAddrType_t *pSrcAddr, zclOTA_Query
   // Request the image from the console
   if ( zclOTA_Permit )
   {
+    // Pick up a block delay set by the console before the download starts
+    osal_nv_read ( ZCD_NV_OTA_BLOCK_REQ_DELAY, 0,
+                   sizeof ( zclOTA_MinBlockReqDelay ), &zclOTA_MinBlockReqDelay );
+
     status = MT_OtaGetImage ( pSrcAddr, &pParam->fileId, 0,  pParam->nodeAddr, MT_OTA_QUERY_SPECIFIC_OPTION );
   }
   else
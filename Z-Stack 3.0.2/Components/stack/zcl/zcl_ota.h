@@ -65,6 +65,21 @@ extern "C"
 #define OTA_MAX_END_REQ_RETRIES                       2
 #define OTA_MAX_BLOCK_RSP_WAIT_TIME                   ((uint16)5000)
 
+// Largest image block the adaptive client asks for and the server sends.
+// Blocks above OTA_MAX_MTU need APS fragmentation, at the client and the server.
+// The server also sends no more than its OTA console can return in one MT
+// frame.
+#if !defined OTA_MAX_BLOCK_SIZE
+#if defined ( ZIGBEE_FRAGMENTATION )
+#define OTA_MAX_BLOCK_SIZE                            128  // bytes
+#else
+#define OTA_MAX_BLOCK_SIZE                            OTA_MAX_MTU
+#endif
+#endif
+#if ( OTA_MAX_BLOCK_SIZE > 255 )
+#error "OTA_MAX_BLOCK_SIZE must fit the 8-bit block data size"
+#endif
+
 // Simple descriptor values
 #define ZCL_OTA_ENDPOINT                              14
 #ifdef OTA_HA
@@ -181,6 +196,10 @@ extern "C"
 #define OTA_BLOCK_FC_NODES_IEEE_PRESENT               0x01
 #define OTA_BLOCK_FC_REQ_DELAY_PRESENT                0x02
 
+// Image Page Request Field Control Bitmask
+#define OTA_PAGE_FC_GENERIC                           0x00
+#define OTA_PAGE_FC_NODES_IEEE_PRESENT                0x01
+
 //  Image Notify Command Payload Type
 #define NOTIFY_PAYLOAD_JITTER                         0x00
 #define NOTIFY_PAYLOAD_JITTER_MFG                     0x01
@@ -197,6 +216,86 @@ extern "C"
 #define ZCL_OTA_SEND_MATCH_DESCRIPTOR_EVT             0x0040
 #define ZCL_OTA_SEND_IEEE_ADD_REQ_EVT                 0x0080
 
+// Server Task Events
+#define ZCL_OTA_IMAGE_PAGE_RSP_EVT                    0x0100
+
+// Set OTA_CLIENT_PAGE_REQ to TRUE to have the client download the image a
+// page at a time with Image Page Requests instead of one Image Block Request
+// per block. The client falls back to block requests if the server does not
+// support the command.
+#if !defined OTA_CLIENT_PAGE_REQ
+#define OTA_CLIENT_PAGE_REQ                           FALSE
+#endif
+#if !defined OTA_PAGE_SIZE
+#define OTA_PAGE_SIZE                                 512  // bytes per page request
+#endif
+#if !defined OTA_PAGE_RSP_SPACING
+#define OTA_PAGE_RSP_SPACING                          50   // ms between block responses
+#endif
+
+// Set OTA_CLIENT_ADAPTIVE to TRUE to have the client size and pace its block
+// requests by how the link behaves.  The block size grows by
+// OTA_ADAPT_BLOCK_STEP after every OTA_ADAPT_GOOD_RSPS prompt responses and is
+// halved when a request times out; the delay added between requests shrinks
+// and grows the other way.  The response timeout follows the measured round
+// trip time instead of always being OTA_MAX_BLOCK_RSP_WAIT_TIME.
+#if !defined OTA_CLIENT_ADAPTIVE
+#define OTA_CLIENT_ADAPTIVE                           FALSE
+#endif
+#if !defined OTA_ADAPT_MIN_BLOCK
+#define OTA_ADAPT_MIN_BLOCK                           16   // bytes
+#endif
+#if !defined OTA_ADAPT_MAX_BLOCK
+#define OTA_ADAPT_MAX_BLOCK                           OTA_MAX_BLOCK_SIZE
+#endif
+#define OTA_ADAPT_BLOCK_STEP                          8    // bytes
+#define OTA_ADAPT_GOOD_RSPS                           4
+#define OTA_ADAPT_DELAY_STEP                          20   // ms
+#define OTA_ADAPT_MAX_DELAY                           2000 // ms
+#define OTA_ADAPT_MIN_RSP_WAIT                        500  // ms
+
+// Server session table.  Each client downloading from the server holds an
+// entry.  A client that has not made a request for OTA_SESSION_TIMEOUT
+// seconds no longer counts towards the pacing and its entry may be given to
+// another client.  A client finding the table full is asked to come back in
+// OTA_SESSION_BUSY_WAIT seconds.
+#if !defined OTA_SERVER_MAX_SESSIONS
+#define OTA_SERVER_MAX_SESSIONS                       8
+#endif
+#define OTA_SESSION_TIMEOUT                           60
+#define OTA_SESSION_BUSY_WAIT                         30
+
+// Time, in ms, the network needs per image block sent by the server.  Each of
+// N active clients is given a block request delay of N times this, so the
+// clients share the network equally and together send about one block per
+// interval.  The delay is never below the minimum block request delay.  0
+// disables the pacing and all clients use the minimum block request delay.
+#if !defined OTA_SERVER_BLOCK_INTERVAL
+#define OTA_SERVER_BLOCK_INTERVAL                     0
+#endif
+
+// Download progress, in percent, between status reports to the console
+#if !defined OTA_SERVER_PROGRESS_STEP
+#define OTA_SERVER_PROGRESS_STEP                      10
+#endif
+
+// Set OTA_BLOCK_CACHE to TRUE to have the server keep the image blocks it has
+// read from the console in RAM, so clients downloading the same image share
+// one console read per block instead of each reading it over the serial link.
+#if !defined OTA_BLOCK_CACHE
+#define OTA_BLOCK_CACHE                               FALSE
+#endif
+#if !defined OTA_BLOCK_CACHE_ENTRIES
+#define OTA_BLOCK_CACHE_ENTRIES                       8    // blocks of OTA_MAX_BLOCK_SIZE bytes
+#endif
+#if !defined OTA_BLOCK_CACHE_READ_AHEAD
+#define OTA_BLOCK_CACHE_READ_AHEAD                    2    // blocks read ahead of a request
+#endif
+#if !defined OTA_BLOCK_CACHE_WAITERS
+#define OTA_BLOCK_CACHE_WAITERS                       4    // clients answered by one read
+#endif
+// Seconds before an unanswered console read no longer holds its cache entry
+#define OTA_BLOCK_CACHE_READ_TIMEOUT                  5
 
 // The OTA Upgrade delay is the number of seconds before the client
 // should wait before switching to the upgrade image
@@ -338,6 +437,15 @@ typedef struct
   uint8 ota_event;
 } zclOTA_CallbackMsg_t;
 
+// Server block cache counters
+typedef struct
+{
+  uint32 hits;          // Blocks sent without a console read of their own
+  uint32 misses;        // Block requests that needed a console read
+  uint32 reads;         // Console reads issued, including read-ahead
+  uint32 bytesSaved;    // Image bytes sent without a console read of their own
+} zclOTA_CacheStats_t;
+
 /******************************************************************************
  * GLOBAL VARIABLES
  */
@@ -353,6 +461,10 @@ extern uint16 zclOTA_ManufacturerId;
 extern uint16 zclOTA_ImageType;
 extern uint16 zclOTA_MinBlockReqDelay;
 
+#if (defined OTA_SERVER) && (OTA_SERVER == TRUE) && (OTA_BLOCK_CACHE == TRUE)
+extern zclOTA_CacheStats_t zclOTA_CacheStats;
+#endif
+
 /******************************************************************************
  * FUNCTIONS
  */
@@ -42,6 +42,9 @@
  * INCLUDES
  */
 
+// Call site file id for heap usage attribution (OSALMEM_SITES)
+#define OSALMEM_SITE_FILE  OSALMEM_FILE_ZDAPP
+
 #include "ZComDef.h"
 #include "ZMAC.h"
 #include "OSAL.h"
@@ -128,11 +131,13 @@
 #endif
 
 // Delay time before updating NWK NV data to force fewer writes during high activity.
+#if !defined ZDAPP_UPDATE_NWK_NV_TIME
 #if ZDO_NV_SAVE_RFDs
 #define ZDAPP_UPDATE_NWK_NV_TIME 700
 #else
 #define ZDAPP_UPDATE_NWK_NV_TIME 65000
 #endif
+#endif
 
 // Timeout value to process New Devices
 #define ZDAPP_NEW_DEVICE_TIME     600   // in ms
@@ -532,6 +537,9 @@ UINT16 ZDApp_event_loop( uint8 task_id, UINT16 events )
 
   if ( events & ZDO_NWK_UPDATE_NV )
   {
+    // Save pending APS link key table changes
+    ZDSecMgrFlushNV();
+
     // Save only in valid state
     if ( _NIB.nwkState == NWK_ROUTER || _NIB.nwkState == NWK_ENDDEVICE )
     {
@@ -3655,9 +3663,12 @@ void ZDApp_NVUpdate( void )
     // No need to wait, set the event to save the state
     osal_set_event(ZDAppTaskID, ZDO_NWK_UPDATE_NV);
   }
-  else
+  else if ( !ZDSecMgrNVPending()
+            || (osal_get_timeoutEx( ZDAppTaskID, ZDO_NWK_UPDATE_NV ) == 0) )
   {
-    // To allow for more changes to the network state before saving
+    // To allow for more changes to the network state before saving. Once
+    // link key table changes are pending the running timer is left alone,
+    // so they are saved at most ZDAPP_UPDATE_NWK_NV_TIME after the first one.
     osal_start_timerEx( ZDAppTaskID, ZDO_NWK_UPDATE_NV, ZDAPP_UPDATE_NWK_NV_TIME );
   }
 #endif
@@ -40,6 +40,9 @@
 /*********************************************************************
  * INCLUDES
  */
+// Call site file id for heap usage attribution (OSALMEM_SITES)
+#define OSALMEM_SITE_FILE  OSALMEM_FILE_ZDPROFILE
+
 #include "ZComDef.h"
 #include "OSAL.h"
 #include "AF.h"
@@ -45,6 +45,9 @@ extern "C"
 /******************************************************************************
  * INCLUDES
  */
+// Call site file id for heap usage attribution (OSALMEM_SITES)
+#define OSALMEM_SITE_FILE  OSALMEM_FILE_ZDSECMGR
+
 #include "ZComDef.h"
 #include "OSAL.h"
 #include "OSAL_Nv.h"
@@ -73,6 +76,37 @@ extern "C"
 // maximum number of LINK keys this device may store
 #define ZDSECMGR_ENTRY_MAX ZDSECMGR_DEVICE_MAX
 
+// keep a direct map from Address Manager index to entry index so entry
+// lookups do not scan ZDSecMgrEntries, set to FALSE to save the RAM
+#if !defined ( ZDSECMGR_AMI_INDEX )
+  #define ZDSECMGR_AMI_INDEX TRUE
+#endif
+
+#if ( ZDSECMGR_ENTRY_MAX < 0xFF )
+  typedef uint8 ZDSecMgrEntryIdx_t;
+  #define ZDSECMGR_AMI_INDEX_NONE 0xFF
+#else
+  typedef uint16 ZDSecMgrEntryIdx_t;
+  #define ZDSECMGR_AMI_INDEX_NONE 0xFFFF
+#endif
+
+// set to TRUE to keep a RAM copy of the address, attributes and seed of each
+// TCLK table entry so TCLK lookups do not read NV. Every TCLK write outside
+// this file must be followed by ZDSecMgrTCLKIndexSet or
+// ZDSecMgrTCLKIndexReload, so only enable it when no stack library code
+// writes the table other than through APSME_AddTCLinkKey at the call sites
+// that reload the index
+#if !defined ( ZDSECMGR_TCLK_INDEX )
+  #define ZDSECMGR_TCLK_INDEX FALSE
+#endif
+
+// write only the changed APS link key table entry, together with its key,
+// and defer header count updates that do not change whether the table is
+// empty to the next ZDApp NV update, set to FALSE to rewrite the table
+#if !defined ( ZDSECMGR_NV_WRITEBACK )
+  #define ZDSECMGR_NV_WRITEBACK TRUE
+#endif
+
 // total number of stored devices
 #if !defined ( ZDSECMGR_STORED_DEVICES )
   #define ZDSECMGR_STORED_DEVICES 3
@@ -146,6 +180,16 @@ uint8 ZDSecMgrTCAuthenticated = FALSE;
 
 ZDSecMgrEntry_t* ZDSecMgrEntries  = NULL;
 
+#if ( ZDSECMGR_AMI_INDEX == TRUE )
+// entry index for each Address Manager index, NULL if it couldn't be allocated
+static ZDSecMgrEntryIdx_t* ZDSecMgrAmiIndex = NULL;
+#endif
+
+#if defined ( NV_RESTORE ) && ( ZDSECMGR_NV_WRITEBACK == TRUE )
+// the APS link key table header count in NV is out of date
+static uint8 ZDSecMgrNvHdrDirty = FALSE;
+#endif
+
 void ZDSecMgrAddrMgrCB( uint8 update, AddrMgrEntry_t* newEntry, AddrMgrEntry_t* oldEntry );
 
 uint8 ZDSecMgrPermitJoiningEnabled;
@@ -156,6 +200,23 @@ APSME_TCLKDevEntry_t TrustCenterLinkKey;
 APSME_ApsLinkKeyFrmCntr_t ApsLinkKeyFrmCntr[ZDSECMGR_ENTRY_MAX];
 APSME_TCLinkKeyFrmCntr_t TCLinkKeyFrmCntr[ZDSECMGR_TC_DEVICE_MAX];
 
+#if ( ZDSECMGR_TCLK_INDEX == TRUE )
+// fields of each TCLK table entry used when securing frames, the frame
+// counters are in TCLinkKeyFrmCntr
+typedef struct
+{
+  uint8 extAddr[Z_EXTADDR_LEN];
+  uint8 keyAttributes;
+  uint8 keyType;
+  uint8 SeedShift_IcIndex;
+} ZDSecMgrTCLKIndex_t;
+
+static ZDSecMgrTCLKIndex_t ZDSecMgrTCLKIndex[ZDSECMGR_TC_DEVICE_MAX];
+
+// TRUE while every entry of ZDSecMgrTCLKIndex matches NV
+static uint8 ZDSecMgrTCLKIndexValid = FALSE;
+#endif
+
  CONST uint16 gZDSECMGR_TC_DEVICE_MAX = ZDSECMGR_TC_DEVICE_MAX;
  CONST uint16 gZDSECMGR_TC_DEVICE_IC_MAX = ZDSECMGR_TC_DEVICE_IC_MAX;
  uint8  gZDSECMGR_TC_ATTEMPT_DEFAULT_KEY = ZDSECMGR_TC_ATTEMPT_DEFAULT_KEY;
@@ -172,6 +233,8 @@ APSME_TCLinkKeyFrmCntr_t TCLinkKeyFrmCntr[ZDSECMGR_TC_DEVICE_MAX];
  *   ZDSecMgrEntryLookupExtGetIndex
  *   ZDSecMgrEntryFree
  *   ZDSecMgrEntryNew
+ *   ZDSecMgrEntryAMISet
+ *   ZDSecMgrAmiIndexBuild
  *   ZDSecMgrAppKeyGet
  *   ZDSecMgrAppKeyReq
  *   ZDSecMgrTclkReq
@@ -187,6 +250,8 @@ APSME_TCLinkKeyFrmCntr_t TCLinkKeyFrmCntr[ZDSECMGR_TC_DEVICE_MAX];
  *   ZDSecMgrAssocDeviceAuth
  *   ZDSecMgrAuthNwkKey
  *   APSME_TCLinkKeyInit
+ *   ZDSecMgrTCLKIndexSet
+ *   ZDSecMgrSearchTCLinkKeyEntry
  *   APSME_IsDefaultTCLK
  */
 
@@ -214,12 +279,21 @@ ZStatus_t ZDSecMgrEntryLookupExtGetIndex( uint8* extAddr, ZDSecMgrEntry_t** entr
 ZStatus_t ZDSecMgrEntryLookupAMIGetIndex( uint16 ami, uint16* entryIndex );
 void ZDSecMgrEntryFree( ZDSecMgrEntry_t* entry );
 ZStatus_t ZDSecMgrEntryNew( ZDSecMgrEntry_t** entry );
+static void ZDSecMgrEntryAMISet( ZDSecMgrEntry_t* entry, uint16 ami );
+#if ( ZDSECMGR_AMI_INDEX == TRUE )
+static void ZDSecMgrAmiIndexBuild( void );
+#endif
 ZStatus_t ZDSecMgrAuthenticationSet( uint8* extAddr, ZDSecMgr_Authentication_Option option );
 void ZDSecMgrApsLinkKeyInit(uint8 setDefault);
 #if defined ( NV_RESTORE )
+#if ( ZDSECMGR_NV_WRITEBACK != TRUE )
 static void ZDSecMgrWriteNV(void);
+#endif
 static void ZDSecMgrRestoreFromNV(void);
 static void ZDSecMgrUpdateNV( uint16 index );
+#if ( ZDSECMGR_NV_WRITEBACK == TRUE )
+static uint16 ZDSecMgrEntryCount( void );
+#endif
 #endif
 
 //-----------------------------------------------------------------------------
@@ -437,6 +511,10 @@ void ZDSecMgrEntryInit(uint8 state)
 
       ZDSecMgrEntries[index].keyNvId = SEC_NO_KEY_NV_ID;
     }
+
+#if ( ZDSECMGR_AMI_INDEX == TRUE )
+    ZDSecMgrAmiIndex = osal_mem_alloc( sizeof(ZDSecMgrEntryIdx_t) * NWK_MAX_ADDRESSES );
+#endif
   }
 
 #if defined NV_RESTORE
@@ -447,6 +525,80 @@ void ZDSecMgrEntryInit(uint8 state)
 #else
   (void)state;
 #endif
+
+#if ( ZDSECMGR_AMI_INDEX == TRUE )
+  ZDSecMgrAmiIndexBuild();
+#endif
+}
+
+#if ( ZDSECMGR_AMI_INDEX == TRUE )
+/******************************************************************************
+ * @fn          ZDSecMgrAmiIndexBuild
+ *
+ * @brief       Rebuild the Address Manager index to entry index map from
+ *              the entry table.
+ *
+ * @param       none
+ *
+ * @return      none
+ */
+static void ZDSecMgrAmiIndexBuild( void )
+{
+  uint16 index;
+
+  if ( ( ZDSecMgrAmiIndex == NULL ) || ( ZDSecMgrEntries == NULL ) )
+  {
+    return;
+  }
+
+  osal_memset( ZDSecMgrAmiIndex, 0xFF, sizeof(ZDSecMgrEntryIdx_t) * NWK_MAX_ADDRESSES );
+
+  // walk backwards so the first of any duplicate entries wins, like a scan
+  index = ZDSECMGR_ENTRY_MAX;
+  while ( index-- > 0 )
+  {
+    if ( ZDSecMgrEntries[index].ami < NWK_MAX_ADDRESSES )
+    {
+      ZDSecMgrAmiIndex[ZDSecMgrEntries[index].ami] = (ZDSecMgrEntryIdx_t)index;
+    }
+  }
+}
+#endif // ZDSECMGR_AMI_INDEX
+
+/******************************************************************************
+ * @fn          ZDSecMgrEntryAMISet
+ *
+ * @brief       Set the Address Manager index of an entry.
+ *
+ * @param       entry - [in] valid entry
+ * @param       ami   - [in] Address Manager index, or INVALID_NODE_ADDR to
+ *                           release the entry
+ *
+ * @return      none
+ */
+static void ZDSecMgrEntryAMISet( ZDSecMgrEntry_t* entry, uint16 ami )
+{
+#if ( ZDSECMGR_AMI_INDEX == TRUE )
+  uint16 oldAmi = entry->ami;
+#endif
+
+  entry->ami = ami;
+
+#if ( ZDSECMGR_AMI_INDEX == TRUE )
+  if ( ZDSecMgrAmiIndex != NULL )
+  {
+    if ( ( oldAmi == INVALID_NODE_ADDR ) && ( ami < NWK_MAX_ADDRESSES ) &&
+         ( ZDSecMgrAmiIndex[ami] == ZDSECMGR_AMI_INDEX_NONE ) )
+    {
+      // common case, a free entry taking an unused address index
+      ZDSecMgrAmiIndex[ami] = (ZDSecMgrEntryIdx_t)(entry - ZDSecMgrEntries);
+    }
+    else
+    {
+      ZDSecMgrAmiIndexBuild();
+    }
+  }
+#endif
 }
 
 /******************************************************************************
@@ -473,19 +625,13 @@ ZStatus_t ZDSecMgrEntryLookup( uint16 nwkAddr, ZDSecMgrEntry_t** entry )
     addrMgrEntry.user    = ADDRMGR_USER_SECURITY;
     addrMgrEntry.nwkAddr = nwkAddr;
 
-    if ( AddrMgrEntryLookupNwk( &addrMgrEntry ) == TRUE )
+    if ( ( AddrMgrEntryLookupNwk( &addrMgrEntry ) == TRUE ) &&
+         ( ZDSecMgrEntryLookupAMIGetIndex( addrMgrEntry.index, &index ) == ZSuccess ) )
     {
-      for ( index = 0; index < ZDSECMGR_ENTRY_MAX ; index++ )
-      {
-        if ( addrMgrEntry.index == ZDSecMgrEntries[index].ami )
-        {
-          // return successful results
-          *entry = &ZDSecMgrEntries[index];
+      // return successful results
+      *entry = &ZDSecMgrEntries[index];
 
-          // break from loop
-          return ZSuccess;
-        }
-      }
+      return ZSuccess;
     }
   }
 
@@ -509,20 +655,12 @@ ZStatus_t ZDSecMgrEntryLookupAMI( uint16 ami, ZDSecMgrEntry_t** entry )
   // initialize results
   *entry = NULL;
 
-  // verify data is available
-  if ( ZDSecMgrEntries != NULL )
+  if ( ZDSecMgrEntryLookupAMIGetIndex( ami, &index ) == ZSuccess )
   {
-    for ( index = 0; index < ZDSECMGR_ENTRY_MAX ; index++ )
-    {
-      if ( ZDSecMgrEntries[index].ami == ami )
-      {
-        // return successful results
-        *entry = &ZDSecMgrEntries[index];
+    // return successful results
+    *entry = &ZDSecMgrEntries[index];
 
-        // break from loop
-        return ZSuccess;
-      }
-    }
+    return ZSuccess;
   }
 
   return ZNwkUnknownDevice;
@@ -572,24 +710,14 @@ ZStatus_t ZDSecMgrEntryLookupExtGetIndex( uint8* extAddr, ZDSecMgrEntry_t** entr
   uint16 index;
 
   // lookup address index
-  if ( ZDSecMgrExtAddrLookup( extAddr, &ami ) == ZSuccess )
+  if ( ( ZDSecMgrExtAddrLookup( extAddr, &ami ) == ZSuccess ) &&
+       ( ZDSecMgrEntryLookupAMIGetIndex( ami, &index ) == ZSuccess ) )
   {
-    // verify data is available
-    if ( ZDSecMgrEntries != NULL )
-    {
-      for ( index = 0; index < ZDSECMGR_ENTRY_MAX ; index++ )
-      {
-        if ( ZDSecMgrEntries[index].ami == ami )
-        {
-          // return successful results
-          *entry = &ZDSecMgrEntries[index];
-          *entryIndex = index;
+    // return successful results
+    *entry = &ZDSecMgrEntries[index];
+    *entryIndex = index;
 
-          // break from loop
-          return ZSuccess;
-        }
-      }
-    }
+    return ZSuccess;
   }
 
   return ZNwkUnknownDevice;
@@ -612,6 +740,23 @@ ZStatus_t ZDSecMgrEntryLookupAMIGetIndex( uint16 ami, uint16* entryIndex )
   // verify data is available
   if ( ZDSecMgrEntries != NULL )
   {
+#if ( ZDSECMGR_AMI_INDEX == TRUE )
+    if ( ( ZDSecMgrAmiIndex != NULL ) && ( ami < NWK_MAX_ADDRESSES ) )
+    {
+      index = ZDSecMgrAmiIndex[ami];
+
+      if ( index != ZDSECMGR_AMI_INDEX_NONE )
+      {
+        // return successful results
+        *entryIndex = index;
+
+        return ZSuccess;
+      }
+
+      return ZNwkUnknownDevice;
+    }
+#endif
+
     for ( index = 0; index < ZDSECMGR_ENTRY_MAX ; index++ )
     {
       if ( ZDSecMgrEntries[index].ami == ami )
@@ -665,7 +810,7 @@ void ZDSecMgrEntryFree( ZDSecMgrEntry_t* entry )
   }
 
   // marking the entry as INVALID_NODE_ADDR
-  entry->ami = INVALID_NODE_ADDR;
+  ZDSecMgrEntryAMISet( entry, INVALID_NODE_ADDR );
 
   // set to default value
   entry->authenticateOption = ZDSecMgr_Not_Authenticated;
@@ -846,7 +991,7 @@ void ZDSecMgrTclkReq( ZDO_RequestKeyInd_t* ind )
     req.key = key;
 
     //Search for the entry
-    APSME_SearchTCLinkKeyEntry(initExtAddr,&found, &TCLKDevEntry);
+    ZDSecMgrSearchTCLinkKeyEntry(initExtAddr,&found, &TCLKDevEntry);
 
     //If found, generate the key accordingly to the key attribute
     if(found)
@@ -1084,7 +1229,7 @@ void ZDSecMgrDeviceRemove( ZDSecMgrDevice_t* device )
       uint8 found;
       APSME_GetRequest( apsTrustCenterAddress,0, TC_ExtAddr );
       
-      APSME_SearchTCLinkKeyEntry(TC_ExtAddr,&found,NULL);
+      ZDSecMgrSearchTCLinkKeyEntry(TC_ExtAddr,&found,NULL);
       
       // For ZG_GLOBAL_LINK_KEY the message has to be sent twice, one
       // APS un-encrypted and one APS encrypted, to make sure that it can interoperate
@@ -1290,7 +1435,7 @@ ZStatus_t ZDSecMgrDeviceJoinDirect( ZDSecMgrDevice_t* device )
     uint16 keyNvIndex;
     APSME_TCLKDevEntry_t TCLKDevEntry;
     
-    keyNvIndex = APSME_SearchTCLinkKeyEntry(device->extAddr,&found, &TCLKDevEntry);
+    keyNvIndex = ZDSecMgrSearchTCLinkKeyEntry(device->extAddr,&found, &TCLKDevEntry);
     
     //If found and it was verified, then allow it to join in a fresh state by erasing the key entry
     if((found == TRUE) && (TCLKDevEntry.keyAttributes == ZG_VERIFIED_KEY))
@@ -1311,6 +1456,7 @@ ZStatus_t ZDSecMgrDeviceJoinDirect( ZDSecMgrDevice_t* device )
       
       //Update the entry
       osal_nv_write(keyNvIndex,0,sizeof(APSME_TCLKDevEntry_t), &TCLKDevEntry );
+      ZDSecMgrTCLKIndexSet( keyNvIndex, &TCLKDevEntry );
     }
     
   }
@@ -1404,7 +1550,7 @@ ZStatus_t ZDSecMgrDeviceJoinFwd( ZDSecMgrDevice_t* device )
     uint8 found;
     APSME_GetRequest( apsTrustCenterAddress,0, TC_ExtAddr );
     
-    APSME_SearchTCLinkKeyEntry(TC_ExtAddr,&found,NULL);
+    ZDSecMgrSearchTCLinkKeyEntry(TC_ExtAddr,&found,NULL);
     
     // For ZG_GLOBAL_LINK_KEY the message has to be sent twice one
     // un-encrypted and one APS encrypted, to make sure that it can interoperate
@@ -1817,6 +1963,7 @@ void ZDSecMgrTransportKeyInd( ZDO_TransportKeyInd_t* ind )
   {
     //Update the TC address in the entry
     osal_nv_write(ZCD_NV_TCLK_TABLE_START, osal_offsetof(APSME_TCLKDevEntry_t,extAddr), Z_EXTADDR_LEN, ind->srcExtAddr);
+    ZDSecMgrTCLKIndexSet( ZCD_NV_TCLK_TABLE_START, NULL );
   }
 #endif
   
@@ -1869,7 +2016,7 @@ void ZDSecMgrTransportKeyInd( ZDO_TransportKeyInd_t* ind )
     APSME_TCLKDevEntry_t TCLKDevEntry;
     
     //Search the entry, which should exist at this point
-    entryIndex = APSME_SearchTCLinkKeyEntry(ind->srcExtAddr, &found, &TCLKDevEntry);
+    entryIndex = ZDSecMgrSearchTCLinkKeyEntry(ind->srcExtAddr, &found, &TCLKDevEntry);
     
     if(found)
     {
@@ -1887,6 +2034,7 @@ void ZDSecMgrTransportKeyInd( ZDO_TransportKeyInd_t* ind )
       
       //Update the entry
       osal_nv_write(entryIndex,0,sizeof(APSME_TCLKDevEntry_t),&TCLKDevEntry);
+      ZDSecMgrTCLKIndexSet( entryIndex, &TCLKDevEntry );
 
       //Create the entry for the key
       if(ZSUCCESS == osal_nv_item_init(ZCD_NV_TCLK_JOIN_DEV,SEC_KEY_LEN,ind->key) )
@@ -1921,14 +2069,22 @@ void ZDSecMgrTransportKeyInd( ZDO_TransportKeyInd_t* ind )
         if ( ZDSecMgrEntryNew( &entry ) == ZSuccess )
         {
           // finish setting up entry
-          entry->ami = ami;
+          ZDSecMgrEntryAMISet( entry, ami );
         }
       }
 
       ZDSecMgrLinkKeySet( ind->srcExtAddr, ind->key );
 
 #if defined NV_RESTORE
+#if ( ZDSECMGR_NV_WRITEBACK == TRUE )
+      if ( entry != NULL )
+      {
+        // Write the control record for the new established link key to NV.
+        ZDSecMgrUpdateNV( (uint16)(entry - ZDSecMgrEntries) );
+      }
+#else
       ZDSecMgrWriteNV();  // Write the control record for the new established link key to NV.
+#endif
 #endif
     }
   }
@@ -1972,7 +2128,7 @@ void ZDSecMgrUpdateDeviceInd( ZDO_UpdateDeviceInd_t* ind )
       uint16 keyNvIndex;
       APSME_TCLKDevEntry_t TCLKDevEntry;
       
-      keyNvIndex = APSME_SearchTCLinkKeyEntry(device.extAddr,&found, &TCLKDevEntry);
+      keyNvIndex = ZDSecMgrSearchTCLinkKeyEntry(device.extAddr,&found, &TCLKDevEntry);
       
       //If found and it was verified, then allow it to join in a fresh state by erasing the key entry
       if((found == TRUE) && (TCLKDevEntry.keyAttributes == ZG_VERIFIED_KEY))
@@ -1987,6 +2143,7 @@ void ZDSecMgrUpdateDeviceInd( ZDO_UpdateDeviceInd_t* ind )
         
         //Update the entry
         osal_nv_write(keyNvIndex,0,sizeof(APSME_TCLKDevEntry_t), &TCLKDevEntry );
+        ZDSecMgrTCLKIndexSet( keyNvIndex, &TCLKDevEntry );
       }
       
       bdb_TCAddJoiningDevice(device.parentAddr,device.extAddr);
@@ -2685,7 +2842,7 @@ ZStatus_t ZDSecMgrAddLinkKey( uint16 shortAddr, uint8 *extAddr, uint8 *key)
   {
     if ( ZDSecMgrEntryNew( &entry ) == ZSuccess )
     {
-      entry->ami = ami;
+      ZDSecMgrEntryAMISet( entry, ami );
     }
     else
     {
@@ -2702,7 +2859,11 @@ ZStatus_t ZDSecMgrAddLinkKey( uint16 shortAddr, uint8 *extAddr, uint8 *key)
 #endif
 
 #if defined NV_RESTORE
+#if ( ZDSECMGR_NV_WRITEBACK == TRUE )
+  ZDSecMgrUpdateNV( (uint16)(entry - ZDSecMgrEntries) );  // Write the new established link key to NV.
+#else
   ZDSecMgrWriteNV();  // Write the new established link key to NV.
+#endif
 #endif
 
   return ZSuccess;
@@ -2737,7 +2898,7 @@ uint8 ZDSecMgrInitNV(void)
   return rtrn;
 }
 
-#if defined ( NV_RESTORE )
+#if defined ( NV_RESTORE ) && ( ZDSECMGR_NV_WRITEBACK != TRUE )
 /*********************************************************************
  * @fn      ZDSecMgrWriteNV()
  *
@@ -2773,7 +2934,7 @@ static void ZDSecMgrWriteNV( void )
   // Save off the header
   osal_nv_write( ZCD_NV_APS_LINK_KEY_TABLE, 0, sizeof( nvDeviceListHdr_t ), &hdr );
 }
-#endif // NV_RESTORE
+#endif // NV_RESTORE && !ZDSECMGR_NV_WRITEBACK
 
 #if defined ( NV_RESTORE )
 /******************************************************************************
@@ -2907,7 +3068,36 @@ void ZDSecMgrSetDefaultNV( void )
 static void ZDSecMgrUpdateNV( uint16 index )
 {
   nvDeviceListHdr_t hdr;
+#if ( ZDSECMGR_NV_WRITEBACK == TRUE )
+  uint16 numRecs;
+
+  if (ZDSecMgrEntries == NULL)
+  {
+    return;
+  }
 
+  // Save off the record right after its key, so NV never holds a key
+  // whose control record is out of date
+  osal_nv_write( ZCD_NV_APS_LINK_KEY_TABLE,
+                 (uint16)((sizeof(nvDeviceListHdr_t)) + (index * sizeof(ZDSecMgrEntry_t))),
+                 sizeof(ZDSecMgrEntry_t), &ZDSecMgrEntries[index] );
+
+  // The restore only checks the count for zero, so only a change to or from
+  // an empty table has to be written now
+  numRecs = ZDSecMgrEntryCount();
+
+  if ( (osal_nv_read(ZCD_NV_APS_LINK_KEY_TABLE, 0, sizeof(nvDeviceListHdr_t), &hdr) != ZSUCCESS) ||
+       ((hdr.numRecs == 0) != (numRecs == 0)) )
+  {
+    hdr.numRecs = numRecs;
+    osal_nv_write( ZCD_NV_APS_LINK_KEY_TABLE, 0, sizeof( nvDeviceListHdr_t ), &hdr );
+  }
+  else if ( hdr.numRecs != numRecs )
+  {
+    ZDSecMgrNvHdrDirty = TRUE;
+    ZDApp_NVUpdate();
+  }
+#else
   if (ZDSecMgrEntries != NULL)
   {
     // Save off the record
@@ -2933,9 +3123,88 @@ static void ZDSecMgrUpdateNV( uint16 index )
     // Save off the header
     osal_nv_write( ZCD_NV_APS_LINK_KEY_TABLE, 0, sizeof( nvDeviceListHdr_t ), &hdr );
   }
+#endif // ZDSECMGR_NV_WRITEBACK
 }
+
+#if ( ZDSECMGR_NV_WRITEBACK == TRUE )
+/*********************************************************************
+ * @fn      ZDSecMgrEntryCount()
+ *
+ * @brief   Count the valid APS link key table entries in RAM
+ *
+ * @param   none
+ *
+ * @return  number of valid entries
+ */
+static uint16 ZDSecMgrEntryCount( void )
+{
+  uint16 i;
+  uint16 numRecs = 0;
+
+  if ( ZDSecMgrEntries != NULL )
+  {
+    for ( i = 0; i < ZDSECMGR_ENTRY_MAX; i++ )
+    {
+      if ( ZDSecMgrEntries[i].ami != INVALID_NODE_ADDR )
+      {
+        numRecs++;
+      }
+    }
+  }
+
+  return numRecs;
+}
+#endif // ZDSECMGR_NV_WRITEBACK
 #endif // NV_RESTORE
 
+/*********************************************************************
+ * @fn      ZDSecMgrFlushNV()
+ *
+ * @brief   Write the APS link key table header count to NV if it is out
+ *          of date. The entries themselves are written with their keys.
+ *
+ * @param   none
+ *
+ * @return  none
+ */
+void ZDSecMgrFlushNV( void )
+{
+#if defined ( NV_RESTORE ) && ( ZDSECMGR_NV_WRITEBACK == TRUE )
+  nvDeviceListHdr_t hdr;
+
+  if ( ZDSecMgrNvHdrDirty == FALSE )
+  {
+    return;
+  }
+
+  hdr.numRecs = ZDSecMgrEntryCount();
+
+  // Save off the header
+  osal_nv_write( ZCD_NV_APS_LINK_KEY_TABLE, 0, sizeof( nvDeviceListHdr_t ), &hdr );
+
+  ZDSecMgrNvHdrDirty = FALSE;
+#endif
+}
+
+/*********************************************************************
+ * @fn      ZDSecMgrNVPending()
+ *
+ * @brief   Check for APS link key table changes waiting for
+ *          ZDSecMgrFlushNV().
+ *
+ * @param   none
+ *
+ * @return  TRUE if a flush is pending
+ */
+uint8 ZDSecMgrNVPending( void )
+{
+#if defined ( NV_RESTORE ) && ( ZDSECMGR_NV_WRITEBACK == TRUE )
+  return ZDSecMgrNvHdrDirty;
+#else
+  return FALSE;
+#endif
+}
+
 /******************************************************************************
  * @fn          ZDSecMgrAPSRemove
  *
@@ -2987,6 +3256,11 @@ void APSME_TCLinkKeyInit(uint8 setDefault)
   uint8                rtrn;
   uint16               i;
   
+#if ( ZDSECMGR_TCLK_INDEX == TRUE )
+  // Every entry is loaded below, an entry that cannot be clears this again
+  ZDSecMgrTCLKIndexValid = TRUE;
+#endif
+
   // Clear the data for the keys
   osal_memset( &TCLKDevEntry, 0x00, sizeof(APSME_TCLKDevEntry_t) );
   TCLKDevEntry.keyAttributes = ZG_DEFAULT_KEY;
@@ -3007,6 +3281,7 @@ void APSME_TCLinkKeyInit(uint8 setDefault)
         osal_nv_write(ZCD_NV_TCLK_TABLE_START + i, 0, sizeof(APSME_TCLKDevEntry_t), &TCLKDevEntry);
         TCLinkKeyFrmCntr[i].txFrmCntr = 0;
         TCLinkKeyFrmCntr[i].rxFrmCntr = 0;
+        ZDSecMgrTCLKIndexSet( ZCD_NV_TCLK_TABLE_START + i, &TCLKDevEntry );
       }
       else
       {
@@ -3024,11 +3299,22 @@ void APSME_TCLinkKeyInit(uint8 setDefault)
         TCLinkKeyFrmCntr[i].txFrmCntr = TCLKDevEntry.txFrmCntr;
         TCLinkKeyFrmCntr[i].rxFrmCntr = TCLKDevEntry.rxFrmCntr;
         
+        ZDSecMgrTCLKIndexSet( ZCD_NV_TCLK_TABLE_START + i, &TCLKDevEntry );
+
         // Making sure data is cleared and set to default for every key all the time
         osal_memset( &TCLKDevEntry, 0x00, sizeof(APSME_TCLKDevEntry_t) );
         TCLKDevEntry.keyAttributes = ZG_DEFAULT_KEY;
       }
     }
+    else if (rtrn == NV_ITEM_UNINIT)
+    {
+      // Just created with the default entry
+      ZDSecMgrTCLKIndexSet( ZCD_NV_TCLK_TABLE_START + i, &TCLKDevEntry );
+    }
+    else
+    {
+      ZDSecMgrTCLKIndexSet( ZCD_NV_TCLK_TABLE_START + i, NULL );
+    }
   }
 
   if(setDefault)
@@ -3038,6 +3324,141 @@ void APSME_TCLinkKeyInit(uint8 setDefault)
   }
 }
 
+/******************************************************************************
+ * @fn          ZDSecMgrTCLKIndexSet
+ *
+ * @brief       Update the RAM copy of a TCLK table entry after writing it.
+ *              Every write that may change the address, key attributes,
+ *              key type or seed shift of an entry must be followed by a
+ *              call to this, or lookups would use stale values.
+ *
+ * @param       keyNvId - [in] NV ID of the TCLK table entry written
+ * @param       pEntry  - [in] entry as written, NULL to read it back from
+ *                             NV after writing only part of it
+ *
+ * @return      none
+ */
+void ZDSecMgrTCLKIndexSet( uint16 keyNvId, APSME_TCLKDevEntry_t *pEntry )
+{
+#if ( ZDSECMGR_TCLK_INDEX == TRUE )
+  APSME_TCLKDevEntry_t TCLKDevEntry;
+  uint16 i = keyNvId - ZCD_NV_TCLK_TABLE_START;
+
+  if ( i < gZDSECMGR_TC_DEVICE_MAX )
+  {
+    if ( pEntry == NULL )
+    {
+      if ( osal_nv_read( keyNvId, 0, sizeof(APSME_TCLKDevEntry_t),
+                         &TCLKDevEntry ) == SUCCESS )
+      {
+        pEntry = &TCLKDevEntry;
+      }
+      else
+      {
+        // Unknown contents, search NV until the table is initialized again
+        ZDSecMgrTCLKIndexValid = FALSE;
+        return;
+      }
+    }
+
+    osal_memcpy( ZDSecMgrTCLKIndex[i].extAddr, pEntry->extAddr, Z_EXTADDR_LEN );
+    ZDSecMgrTCLKIndex[i].keyAttributes = pEntry->keyAttributes;
+    ZDSecMgrTCLKIndex[i].keyType = pEntry->keyType;
+    ZDSecMgrTCLKIndex[i].SeedShift_IcIndex = pEntry->SeedShift_IcIndex;
+  }
+#else
+  (void)keyNvId;
+  (void)pEntry;
+#endif
+}
+
+/******************************************************************************
+ * @fn          ZDSecMgrTCLKIndexReload
+ *
+ * @brief       Read every TCLK table entry back from NV into the RAM copy,
+ *              after a write that does not report which entry it changed,
+ *              such as APSME_AddTCLinkKey.
+ *
+ * @param       none
+ *
+ * @return      none
+ */
+void ZDSecMgrTCLKIndexReload( void )
+{
+#if ( ZDSECMGR_TCLK_INDEX == TRUE )
+  uint16 i;
+
+  // An entry that cannot be read clears this again
+  ZDSecMgrTCLKIndexValid = TRUE;
+
+  for ( i = 0; i < gZDSECMGR_TC_DEVICE_MAX; i++ )
+  {
+    ZDSecMgrTCLKIndexSet( ZCD_NV_TCLK_TABLE_START + i, NULL );
+  }
+#endif
+}
+
+/******************************************************************************
+ * @fn          ZDSecMgrSearchTCLinkKeyEntry
+ *
+ * @brief       Search the TCLK table for an extended address. While the RAM
+ *              copy of the table is complete the search does not read NV,
+ *              the entry returned then carries the frame counters from
+ *              TCLinkKeyFrmCntr. Otherwise, and for addresses that are not
+ *              valid, the search falls back to APSME_SearchTCLinkKeyEntry.
+ *
+ * @param       pExt  - [in] extended address
+ * @param       found - [out] TRUE if an entry for pExt was found
+ * @param       tcLinkKeyAddrEntry - [out] entry found, may be NULL
+ *
+ * @return      NV ID of the entry found, or of the first free entry if
+ *              not found, 0xFFFF if the table is full
+ */
+uint16 ZDSecMgrSearchTCLinkKeyEntry( uint8 *pExt, uint8* found, APSME_TCLKDevEntry_t* tcLinkKeyAddrEntry )
+{
+#if ( ZDSECMGR_TCLK_INDEX == TRUE )
+  uint16 freeId = 0xFFFF;
+  uint16 i;
+
+  if ( ( ZDSecMgrTCLKIndexValid == FALSE ) || !AddrMgrExtAddrValid( pExt ) )
+  {
+    return APSME_SearchTCLinkKeyEntry( pExt, found, tcLinkKeyAddrEntry );
+  }
+
+  *found = FALSE;
+
+  for ( i = 0; i < gZDSECMGR_TC_DEVICE_MAX; i++ )
+  {
+    if ( !AddrMgrExtAddrValid( ZDSecMgrTCLKIndex[i].extAddr ) )
+    {
+      if ( freeId == 0xFFFF )
+      {
+        freeId = ZCD_NV_TCLK_TABLE_START + i;
+      }
+    }
+    else if ( osal_ExtAddrEqual( ZDSecMgrTCLKIndex[i].extAddr, pExt ) )
+    {
+      if ( tcLinkKeyAddrEntry != NULL )
+      {
+        tcLinkKeyAddrEntry->txFrmCntr = TCLinkKeyFrmCntr[i].txFrmCntr;
+        tcLinkKeyAddrEntry->rxFrmCntr = TCLinkKeyFrmCntr[i].rxFrmCntr;
+        osal_memcpy( tcLinkKeyAddrEntry->extAddr, pExt, Z_EXTADDR_LEN );
+        tcLinkKeyAddrEntry->keyAttributes = ZDSecMgrTCLKIndex[i].keyAttributes;
+        tcLinkKeyAddrEntry->keyType = ZDSecMgrTCLKIndex[i].keyType;
+        tcLinkKeyAddrEntry->SeedShift_IcIndex = ZDSecMgrTCLKIndex[i].SeedShift_IcIndex;
+      }
+
+      *found = TRUE;
+      return ( ZCD_NV_TCLK_TABLE_START + i );
+    }
+  }
+
+  return freeId;
+#else
+  return APSME_SearchTCLinkKeyEntry( pExt, found, tcLinkKeyAddrEntry );
+#endif
+}
+
 
 /******************************************************************************
  * @fn          APSME_TCLinkKeySync
@@ -3068,13 +3489,13 @@ ZStatus_t APSME_TCLinkKeySync( uint16 srcAddr, SSP_Info_t* si )
     APSME_LookupExtAddr( srcAddr, si->extAddr );
   }
 
-  entryIndex = APSME_SearchTCLinkKeyEntry(si->extAddr,&entryFound,&TCLKDevEntry);
+  entryIndex = ZDSecMgrSearchTCLinkKeyEntry(si->extAddr,&entryFound,&TCLKDevEntry);
   
 #if ZG_BUILD_JOINING_TYPE
   if(ZG_DEVICE_JOINING_TYPE && !entryFound)
   {
     osal_memset(defaultEntry, 0, Z_EXTADDR_LEN);
-    entryIndex = APSME_SearchTCLinkKeyEntry(defaultEntry,&entryFound,&TCLKDevEntry);
+    entryIndex = ZDSecMgrSearchTCLinkKeyEntry(defaultEntry,&entryFound,&TCLKDevEntry);
   }
 #endif
   
@@ -3191,7 +3612,7 @@ ZStatus_t APSME_TCLinkKeyLoad( uint16 dstAddr, SSP_Info_t* si )
   
   if(extAddrFound)
   {
-    entryIndex = APSME_SearchTCLinkKeyEntry(si->extAddr,&found,&TCLKDevEntry);
+    entryIndex = ZDSecMgrSearchTCLinkKeyEntry(si->extAddr,&found,&TCLKDevEntry);
     if(entryIndex != 0xFFFF)
     {
       uint16 i = entryIndex - ZCD_NV_TCLK_TABLE_START;
@@ -3250,6 +3671,7 @@ ZStatus_t APSME_TCLinkKeyLoad( uint16 dstAddr, SSP_Info_t* si )
         TCLKDevEntry.rxFrmCntr = 0;
         //save entry in nv
         osal_nv_write(entryIndex,0,sizeof(APSME_TCLKDevEntry_t),&TCLKDevEntry);
+        ZDSecMgrTCLKIndexSet( entryIndex, &TCLKDevEntry );
         //Initialize framecounter
         osal_memset(&TCLinkKeyFrmCntr[i],0,sizeof(APSME_TCLinkKeyFrmCntr_t));
         // set the keyNvId to use
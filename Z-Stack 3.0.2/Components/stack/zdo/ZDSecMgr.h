@@ -378,6 +378,70 @@ extern uint8 ZDSecMgrInitNV( void );
  */
 extern void ZDSecMgrSetDefaultNV( void );
 
+/*********************************************************************
+ * @fn          ZDSecMgrFlushNV
+ *
+ * @brief       Write pending APS link key table changes to NV
+ *
+ * @param       none
+ *
+ * @return      none
+ */
+extern void ZDSecMgrFlushNV( void );
+
+/*********************************************************************
+ * @fn          ZDSecMgrNVPending
+ *
+ * @brief       Check for APS link key table changes waiting for
+ *              ZDSecMgrFlushNV()
+ *
+ * @param       none
+ *
+ * @return      TRUE if a flush is pending
+ */
+extern uint8 ZDSecMgrNVPending( void );
+
+/******************************************************************************
+ * @fn          ZDSecMgrSearchTCLinkKeyEntry
+ *
+ * @brief       Search the TCLK table for an extended address, checking the
+ *              RAM index of the table before searching NV. Same interface as
+ *              APSME_SearchTCLinkKeyEntry.
+ *
+ * @param       pExt  - [in] extended address
+ * @param       found - [out] TRUE if an entry for pExt was found
+ * @param       tcLinkKeyAddrEntry - [out] entry found, may be NULL
+ *
+ * @return      NV ID of the entry found, or of the first free entry if
+ *              not found, 0xFFFF if the table is full
+ */
+extern uint16 ZDSecMgrSearchTCLinkKeyEntry( uint8 *pExt, uint8* found, APSME_TCLKDevEntry_t* tcLinkKeyAddrEntry );
+
+/******************************************************************************
+ * @fn          ZDSecMgrTCLKIndexSet
+ *
+ * @brief       Update the RAM copy of a TCLK table entry after writing it.
+ *
+ * @param       keyNvId - [in] NV ID of the TCLK table entry written
+ * @param       pEntry  - [in] entry as written, NULL to read it back from
+ *                             NV after writing only part of it
+ *
+ * @return      none
+ */
+extern void ZDSecMgrTCLKIndexSet( uint16 keyNvId, APSME_TCLKDevEntry_t *pEntry );
+
+/******************************************************************************
+ * @fn          ZDSecMgrTCLKIndexReload
+ *
+ * @brief       Read the RAM copy of the TCLK table back from NV after
+ *              APSME_AddTCLinkKey, which does not update it.
+ *
+ * @param       none
+ *
+ * @return      none
+ */
+extern void ZDSecMgrTCLKIndexReload( void );
+
 /******************************************************************************
  * @fn          ZDSecMgrAPSRemove
  *
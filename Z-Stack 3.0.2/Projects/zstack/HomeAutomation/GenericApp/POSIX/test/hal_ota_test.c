@@ -0,0 +1,427 @@
+/**************************************************************************************************
+  Filename:       hal_ota_test.c
+  Revised:        $Date$
+  Revision:       $Revision$
+
+  Description:    Host test of the CC2530 OTA download CRC (HAL_OTA_DL_CRC). Images are streamed
+                  through HalOTAWrite() into an emulated SPI flash, in random block sizes, and the
+                  CRC run while they were written is compared against the full re-read that
+                  HalOTAChkDL() does otherwise. Corrupted images and out-of-order writes are
+                  replayed as well.
+
+
+  Copyright 2026 The Z-Stack host port authors.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions
+  are met:
+
+    Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+
+    Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+
+    Neither the name of the copyright holder nor the names of its
+    contributors may be used to endorse or promote products derived
+    from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**************************************************************************************************/
+
+/**************************************************************************************************
+ *                                           INCLUDES
+ **************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// The host board, MCU and type headers; their include guards keep the CC2530 ones, next to the
+// OTA driver, from being included by it
+#include "hal_board_cfg.h"
+#include "hal_mcu.h"
+#include "hal_types.h"
+
+/**************************************************************************************************
+ *                                            MACROS
+ **************************************************************************************************/
+
+// The CC2530 DMA header only holds register definitions, which the OTA driver does not use here
+#define HAL_DMA_H
+
+#define HAL_OTA_DL_CRC              TRUE
+
+#define HAL_FLASH_PAGE_SIZE         2048
+#define HAL_FLASH_WORD_SIZE         4
+
+// The SPI flash seen through the USART1 registers
+#define XNV_SPI_BEGIN()             xnvSpiBegin()
+#define XNV_SPI_TX(x)               xnvSpiTx(x)
+#define XNV_SPI_RX()                xnvRx
+#define XNV_SPI_WAIT_RXRDY()
+#define XNV_SPI_END()
+#define XNV_SPI_INIT()
+
+/**************************************************************************************************
+ *                                        LOCAL VARIABLES
+ **************************************************************************************************/
+
+uint8 halIntsEnabled = 1;
+
+static uint8 P1DIR;
+
+static uint8 xnvRx;
+
+static void xnvSpiBegin(void);
+static void xnvSpiTx(uint8 ch);
+
+/**************************************************************************************************
+ *                                     OTA DRIVER UNDER TEST
+ **************************************************************************************************/
+
+#include "hal_ota.c"
+
+/**************************************************************************************************
+ *                                           CONSTANTS
+ **************************************************************************************************/
+
+#define TEST_IMAGES                 200
+#define TEST_PROGRAM_MIN            (HAL_OTA_CRC_OSET + sizeof(OTA_CrcControl_t))
+#define TEST_PROGRAM_MAX            0x4000
+#define TEST_HEADER_MAX             0x0180
+#define TEST_IMAGE_MAX              (TEST_HEADER_MAX + OTA_SUB_ELEMENT_HDR_LEN + TEST_PROGRAM_MAX)
+#define TEST_BLOCK_MAX              128
+
+/**************************************************************************************************
+ *                                        LOCAL VARIABLES
+ **************************************************************************************************/
+
+static uint8 xnvMem[HAL_OTA_DL_MAX];
+static uint8 xnvCmd;
+static uint32 xnvAddr;
+static uint16 xnvCnt;
+
+static uint8 testImage[TEST_IMAGE_MAX];
+static uint32 testFails;
+
+/**************************************************************************************************
+ * @fn          xnvSpiBegin
+ *
+ * @brief       Select the emulated SPI flash, which starts a new command.
+ *
+ * input parameters
+ *
+ * None.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      None.
+ **************************************************************************************************
+ */
+static void xnvSpiBegin(void)
+{
+  xnvCnt = 0;
+}
+
+/**************************************************************************************************
+ * @fn          xnvSpiTx
+ *
+ * @brief       Clock a byte into the emulated SPI flash and the answering byte out of it.
+ *
+ * input parameters
+ *
+ * @param       ch - Byte sent to the flash.
+ *
+ * output parameters
+ *
+ * xnvRx - Byte received from the flash.
+ *
+ * @return      None.
+ **************************************************************************************************
+ */
+static void xnvSpiTx(uint8 ch)
+{
+  xnvRx = 0;
+
+  if (xnvCnt == 0)
+  {
+    xnvCmd = ch;
+    xnvAddr = 0;
+  }
+  else if (((xnvCmd == XNV_READ_CMD) || (xnvCmd == XNV_WRPG_CMD)) && (xnvCnt <= 3))
+  {
+    xnvAddr = (xnvAddr << 8) | ch;
+  }
+  else if ((xnvCmd == XNV_READ_CMD) && (xnvCnt > 4))
+  {
+    // The byte after the address is a dummy
+    xnvRx = xnvMem[xnvAddr++ % HAL_OTA_DL_MAX];
+  }
+  else if (xnvCmd == XNV_WRPG_CMD)
+  {
+    xnvMem[xnvAddr % HAL_OTA_DL_MAX] = ch;
+
+    // Page program wraps within the 256 byte page
+    xnvAddr = (xnvAddr & ~0xFFUL) | ((xnvAddr + 1) & 0xFF);
+  }
+
+  xnvCnt++;
+}
+
+/**************************************************************************************************
+ * @fn          HalFlashRead, HalFlashWrite, HalFlashErase
+ *
+ * @brief       Internal flash, only used by the driver for the active image.
+ **************************************************************************************************
+ */
+void HalFlashRead(uint8 pg, uint16 offset, uint8 *buf, uint16 cnt)
+{
+  (void)pg;
+  (void)offset;
+  (void)memset(buf, 0xFF, cnt);
+}
+
+void HalFlashWrite(uint16 addr, uint8 *buf, uint16 cnt)
+{
+  (void)addr;
+  (void)buf;
+  (void)cnt;
+}
+
+void HalFlashErase(uint8 pg)
+{
+  (void)pg;
+}
+
+/**************************************************************************************************
+ * @fn          testRand
+ *
+ * @brief       Random number in a range.
+ *
+ * input parameters
+ *
+ * @param       lo - Lowest value returned.
+ * @param       hi - Highest value returned.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      Random number from lo to hi.
+ **************************************************************************************************
+ */
+static uint32 testRand(uint32 lo, uint32 hi)
+{
+  return lo + ((uint32)rand() % (hi - lo + 1));
+}
+
+/**************************************************************************************************
+ * @fn          testBuildImage
+ *
+ * @brief       Build an OTA image with random contents around a program with a good CRC.
+ *
+ * input parameters
+ *
+ * @param       hdrLen - OTA header length, written at OTA_HEADER_LEN_POS.
+ * @param       programSize - Size of the program following the sub-element header.
+ *
+ * output parameters
+ *
+ * testImage - The image.
+ *
+ * @return      Size of the image.
+ **************************************************************************************************
+ */
+static uint32 testBuildImage(uint16 hdrLen, uint32 programSize)
+{
+  uint32 programStart = hdrLen + OTA_SUB_ELEMENT_HDR_LEN;
+  OTA_CrcControl_t crcControl;
+  uint16 crc = 0;
+  uint32 i;
+
+  for (i = 0; i < programStart + programSize; i++)
+  {
+    testImage[i] = (uint8)rand();
+  }
+
+  testImage[OTA_HEADER_LEN_POS] = LO_UINT16(hdrLen);
+  testImage[OTA_HEADER_LEN_POS + 1] = HI_UINT16(hdrLen);
+
+  crcControl.crc[0] = 0;
+  crcControl.crc[1] = 0xFFFF;
+  crcControl.programSize = programSize;
+  (void)memcpy(testImage + programStart + HAL_OTA_CRC_OSET, &crcControl, sizeof(crcControl));
+
+  // As in HalOTAChkDL(), the two CRC words are not part of the calculation
+  for (i = 0; i < programSize; i++)
+  {
+    if ((i < HAL_OTA_CRC_OSET) || (i >= HAL_OTA_CRC_OSET + 4))
+    {
+      crc = runPoly(crc, testImage[programStart + i]);
+    }
+  }
+
+  crcControl.crc[0] = crc;
+  (void)memcpy(testImage + programStart + HAL_OTA_CRC_OSET, &crcControl, sizeof(crcControl));
+
+  return programStart + programSize;
+}
+
+/**************************************************************************************************
+ * @fn          testStream
+ *
+ * @brief       Write an image through HalOTAWrite() in random block sizes, in order from offset 0,
+ *              or with one block written again out of order when asked to.
+ *
+ * input parameters
+ *
+ * @param       size - Size of the image.
+ * @param       outOfOrder - TRUE to write an earlier block again part way through.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      None.
+ **************************************************************************************************
+ */
+static void testStream(uint32 size, uint8 outOfOrder)
+{
+  uint32 replay = testRand(1, size - 1);
+  uint32 oset = 0;
+
+  (void)memset(xnvMem, 0xFF, size);
+
+  while (oset < size)
+  {
+    uint16 len = (uint16)testRand(1, TEST_BLOCK_MAX);
+
+    if (len > size - oset)
+    {
+      len = (uint16)(size - oset);
+    }
+
+    HalOTAWrite(oset, testImage + oset, len, HAL_OTA_DL);
+    oset += len;
+
+    if (outOfOrder && (oset >= replay))
+    {
+      // A retried block, written again after later ones
+      uint32 back = testRand(1, replay);
+
+      HalOTAWrite(replay - back, testImage + replay - back, 1, HAL_OTA_DL);
+      outOfOrder = FALSE;
+    }
+  }
+}
+
+/**************************************************************************************************
+ * @fn          testCheck
+ *
+ * @brief       Check an image against the full re-read of the DL image from flash.
+ *
+ * input parameters
+ *
+ * @param       name - Name of the case, for the report.
+ * @param       expect - SUCCESS or FAILURE expected of HalOTAChkDL().
+ * @param       expectRun - TRUE if the CRC run while writing is expected to cover the image.
+ *
+ * output parameters
+ *
+ * testFails - Incremented on a mismatch.
+ *
+ * @return      None.
+ **************************************************************************************************
+ */
+static void testCheck(const char *name, uint8 expect, uint8 expectRun)
+{
+  uint8 used = dlCrc.valid && dlCrc.startKnown;
+  uint8 fast = HalOTAChkDL(0);
+  uint8 full;
+
+  // Have HalOTAChkDL() read the image back instead
+  dlCrc.valid = FALSE;
+  full = HalOTAChkDL(0);
+
+  if ((fast != full) || (full != expect) || (used != expectRun))
+  {
+    (void)printf("FAIL %s: running %u, full re-read %u, expected %u, run used %u\n",
+                 name, fast, full, expect, used);
+    testFails++;
+  }
+}
+
+/**************************************************************************************************
+ * @fn          main
+ *
+ * @brief       Replay good, corrupted and out-of-order images.
+ *
+ * input parameters
+ *
+ * None.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      0 if every case passed.
+ **************************************************************************************************
+ */
+int main(void)
+{
+  uint32 n;
+
+  srand(0x2530);
+
+  for (n = 0; n < TEST_IMAGES; n++)
+  {
+    uint16 hdrLen = (uint16)testRand(OTA_HEADER_LEN_MIN, TEST_HEADER_MAX);
+    uint32 programSize = testRand(TEST_PROGRAM_MIN, TEST_PROGRAM_MAX);
+    uint32 size;
+    uint32 pos;
+
+    // Header lengths whose low byte is below OTA_HEADER_LEN_POS + 1
+    if ((n % 4) == 0)
+    {
+      hdrLen = (uint16)(0x0100 + testRand(0, OTA_HEADER_LEN_POS));
+    }
+
+    size = testBuildImage(hdrLen, programSize);
+    testStream(size, FALSE);
+    testCheck("good image", SUCCESS, TRUE);
+
+    // Corrupt one program byte outside the CRC control structure
+    do
+    {
+      pos = testRand(0, programSize - 1);
+    } while ((pos >= HAL_OTA_CRC_OSET) && (pos < HAL_OTA_CRC_OSET + sizeof(OTA_CrcControl_t)));
+    testImage[hdrLen + OTA_SUB_ELEMENT_HDR_LEN + pos] ^= (uint8)testRand(1, 0xFF);
+    testStream(size, FALSE);
+    testCheck("corrupted image", FAILURE, TRUE);
+
+    size = testBuildImage(hdrLen, programSize);
+    testStream(size, TRUE);
+    testCheck("out-of-order image", SUCCESS, FALSE);
+  }
+
+  (void)printf("hal_ota_test: %u images, %u failures\n", (unsigned)TEST_IMAGES, (unsigned)testFails);
+
+  return (testFails == 0) ? 0 : 1;
+}
+
+/**************************************************************************************************
+**************************************************************************************************/
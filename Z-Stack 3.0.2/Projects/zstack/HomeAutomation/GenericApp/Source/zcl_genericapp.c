@@ -84,7 +84,7 @@
   #include "bdb_touchlink.h"
 #endif
 
-#include "onboard.h"
+#include "OnBoard.h"
 
 /* HAL */
 #include "hal_lcd.h"
@@ -46,7 +46,7 @@
 #include "zcl.h"
 #include "zcl_general.h"
 #include "zcl_closures.h"
-#include "zcl_HVAC.h"
+#include "zcl_hvac.h"
 #include "zcl_ss.h"
 #include "zcl_ms.h"
 #include "zcl_lighting.h"
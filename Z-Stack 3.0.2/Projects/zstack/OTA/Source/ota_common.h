@@ -101,6 +101,7 @@
 #define OTA_HEADER_LEN_MIN_ECDSA            166
 #define OTA_HEADER_STR_LEN                  32
 
+#define OTA_HEADER_LEN_POS                  6
 #define OTA_HEADER_IMAGE_SIZE_POS           52
 // OTA_HEADER_FILE_ID_POS is needed for windows tools
 #define OTA_HEADER_FILE_ID_POS              10
@@ -121,6 +122,7 @@
 
 // MT OTA Status Indication Types
 #define MT_OTA_DL_COMPLETE                  0
+#define MT_OTA_DL_PROGRESS                  1   // optional field is percent done
 
 #if defined HAL_MCU_CC2538
 #pragma pack(2)
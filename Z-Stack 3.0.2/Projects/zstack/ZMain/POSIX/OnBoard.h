@@ -0,0 +1,282 @@
+/**************************************************************************************************
+  Filename:       OnBoard.h
+  Revised:        $Date$
+  Revision:       $Revision$
+
+  Description:    Defines stuff for the host (POSIX) board.
+
+
+  Copyright 2026 Texas Instruments Incorporated. All rights reserved.
+
+  IMPORTANT: Your use of this Software is limited to those specific rights
+  granted under the terms of a software license agreement between the user
+  who downloaded the software, his/her employer (which must be your employer)
+  and Texas Instruments Incorporated (the "License").  You may not use this
+  Software unless you agree to abide by the terms of the License. The License
+  limits your use, and you acknowledge, that the Software may not be modified,
+  copied or distributed unless embedded on a Texas Instruments microcontroller
+  or used solely and exclusively in conjunction with a Texas Instruments radio
+  frequency transceiver, which is integrated into your product.  Other than for
+  the foregoing purpose, you may not use, reproduce, copy, prepare derivative
+  works of, modify, distribute, perform, display or sell this Software and/or
+  its documentation for any purpose.
+
+  YOU FURTHER ACKNOWLEDGE AND AGREE THAT THE SOFTWARE AND DOCUMENTATION ARE
+  PROVIDED AS IS WITHOUT WARRANTY OF ANY KIND, EITHER EXPRESS OR IMPLIED,
+  INCLUDING WITHOUT LIMITATION, ANY WARRANTY OF MERCHANTABILITY, TITLE,
+  NON-INFRINGEMENT AND FITNESS FOR A PARTICULAR PURPOSE. IN NO EVENT SHALL
+  TEXAS INSTRUMENTS OR ITS LICENSORS BE LIABLE OR OBLIGATED UNDER CONTRACT,
+  NEGLIGENCE, STRICT LIABILITY, CONTRIBUTION, BREACH OF WARRANTY, OR OTHER
+  LEGAL EQUITABLE THEORY ANY DIRECT OR INDIRECT DAMAGES OR EXPENSES
+  INCLUDING BUT NOT LIMITED TO ANY INCIDENTAL, SPECIAL, INDIRECT, PUNITIVE
+  OR CONSEQUENTIAL DAMAGES, LOST PROFITS OR LOST DATA, COST OF PROCUREMENT
+  OF SUBSTITUTE GOODS, TECHNOLOGY, SERVICES, OR ANY CLAIMS BY THIRD PARTIES
+  (INCLUDING BUT NOT LIMITED TO ANY DEFENSE THEREOF), OR OTHER SIMILAR COSTS.
+
+  Should you have any questions regarding your right to use this Software,
+  contact Texas Instruments Incorporated at www.TI.com.
+**************************************************************************************************/
+
+#ifndef ONBOARD_H
+#define ONBOARD_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*********************************************************************
+ * INCLUDES
+ */
+
+#include "hal_mcu.h"
+#include "hal_uart.h"
+#include "hal_sleep.h"
+#include "OSAL.h"
+
+/*********************************************************************
+ * GLOBAL VARIABLES
+ */
+
+// 64-bit Extended Address of this device
+extern uint8 aExtendedAddress[8];
+
+/*********************************************************************
+ * CONSTANTS
+ */
+
+// Timer clock and power-saving definitions
+#define TIMER_DECR_TIME    1  // 1ms - has to be matched with TC_OCC
+
+/* OSAL timer defines */
+#define TICK_TIME   1000   // Timer per tick - in micro-sec
+/*
+  Timer4 interrupts @ 1.0 msecs using 1/128 pre-scaler
+  TICK_COUNT = (CPUMHZ / 128) / 1000
+*/
+#define TICK_COUNT  1  // 32 Mhz Output Compare Count
+
+/*********************************************************************
+ * MACROS
+ */
+
+// These Key definitions are unique to this development system.
+// They are used to bypass functions when starting up the device.
+#define SW_BYPASS_NV    HAL_KEY_SW_5  // Bypass Network layer NV restore
+#define SW_BYPASS_START HAL_KEY_SW_1  // Bypass Network initialization
+
+// LCD Support Defintions
+#ifdef LCD_SUPPORTED
+  #if !defined DEBUG
+    #define DEBUG  0
+  #endif
+  #if LCD_SUPPORTED==DEBUG
+    #define SERIAL_DEBUG_SUPPORTED  // Serial-debug
+  #endif
+#else // No LCD support
+  #undef SERIAL_DEBUG_SUPPORTED  // No serial-debug
+#endif
+
+/* Serial Port Definitions */
+#if defined (ZAPP_P1)
+  #define ZAPP_PORT HAL_UART_PORT_0
+#elif defined (ZAPP_P2)
+  #define ZAPP_PORT HAL_UART_PORT_1
+#else
+  #undef ZAPP_PORT
+#endif
+#if defined (ZTOOL_P1)
+  #define ZTOOL_PORT HAL_UART_PORT_0
+#elif defined (ZTOOL_P2)
+  #define ZTOOL_PORT HAL_UART_PORT_1
+#else
+  #undef ZTOOL_PORT
+#endif
+
+#define MT_UART_TX_BUFF_MAX  128
+#define MT_UART_RX_BUFF_MAX  128
+#define MT_UART_THRESHOLD   (MT_UART_RX_BUFF_MAX / 2)
+#define MT_UART_IDLE_TIMEOUT 6
+
+// Restart system from absolute beginning
+// Re-executes the process image, see halMcuReset()
+#define SystemReset()       \
+{                           \
+  HAL_DISABLE_INTERRUPTS(); \
+  HAL_SYSTEM_RESET();       \
+}
+
+#define SystemResetSoft()  Onboard_soft_reset()
+
+/* Reset reason for reset indication: always reported as a power-on reset */
+#define ResetReason() (0)
+
+/* There is no watchdog on the host */
+#define WatchDogEnable(wdti)
+
+// Wait for specified microseconds
+#define MicroWait(t) Onboard_wait(t)
+
+#define OSAL_SET_CPU_INTO_SLEEP(timeout) halSleep(timeout); /* Called from OSAL_PwrMgr */
+
+/* The following Heap sizes are setup for typical TI sample applications,
+ * and should be adjusted to your systems requirements.
+ */
+#if !defined INT_HEAP_LEN
+  #define INT_HEAP_LEN  16384
+#endif
+#define MAXMEMHEAP INT_HEAP_LEN
+
+#define KEY_CHANGE_SHIFT_IDX 1
+#define KEY_CHANGE_KEYS_IDX  2
+
+// Initialization levels
+#define OB_COLD  0
+#define OB_WARM  1
+#define OB_READY 2
+
+#ifdef LCD_SUPPORTED
+  #define BUZZER_OFF  0
+  #define BUZZER_ON   1
+  #define BUZZER_BLIP 2
+#endif
+
+  #define VOLT_LEVEL_BAD      0
+  #define VOLT_LEVEL_CAUTIOUS 1
+  #define VOLT_LEVEL_GOOD     2
+
+typedef struct
+{
+  osal_event_hdr_t hdr;
+  uint8 state; // shift
+  uint8 keys;  // keys
+} keyChange_t;
+
+typedef struct
+{
+  osal_event_hdr_t hdr;
+} UART0_t;
+
+/*********************************************************************
+ * FUNCTIONS
+ */
+
+  /*
+   * Initialize the Peripherals
+   *    level: 0=cold, 1=warm, 2=ready
+   */
+  extern void InitBoard( uint8 level );
+
+ /*
+  * Get elapsed timer clock counts
+  */
+  extern uint32 TimerElapsed( void );
+
+  /*
+   * Register for all key events
+   */
+  extern uint8 RegisterForKeys( uint8 task_id );
+
+  extern uint8 RegisterSW2ForKeys( uint8 task_id );
+
+  extern uint8 RegisterSW3ForKeys( uint8 task_id );
+
+/* Keypad Control Functions */
+
+  /*
+   * Send "Key Pressed" message to application
+   */
+  extern uint8 OnBoard_SendKeys( uint8 keys, uint8 shift );
+
+/* Voltage Measurement Functions */
+
+  /* Register a callback */
+  extern void RegisterVoltageWarningCB( void (*pVoltWarnCB)(uint8) );
+
+  /* Measure voltage and report */
+  extern bool OnBoard_CheckVoltage( void );
+  
+/* LCD Emulation/Control Functions */
+  /*
+   * Convert an interger to an ascii string
+   */
+  extern void _itoa( uint16 num, uint8 *buf, uint8 radix );
+
+
+  extern void Dimmer( uint8 lvl );
+
+/* External I/O Processing Functions */
+  /*
+   * Turn on an external lamp
+   */
+  extern void BigLight_On( void );
+
+  /*
+   * Turn off an external lamp
+   */
+  extern void BigLight_Off( void );
+
+  /*
+   * Turn on/off an external buzzer
+   *   on:   BUZZER_ON or BUZZER_OFF
+   */
+  extern void BuzzerControl( uint8 on );
+
+  /*
+   * Get setting of external dip switch
+   */
+  extern uint8 GetUserDipSw( void );
+
+  /*
+   * Calculate the size of used stack
+   */
+  extern uint16 OnBoard_stack_used( void );
+
+  /*
+   * Callback routine to handle keys
+   */
+  extern void OnBoard_KeyCallback ( uint8 keys, uint8 state );
+
+  /*
+   * Board specific random number generator
+   */
+  extern uint16 Onboard_rand( void );
+
+  /*
+   * Board specific micro-second wait
+   */
+  extern void Onboard_wait( uint16 timeout );
+
+  /*
+   * Board specific soft reset.
+   */
+  extern void Onboard_soft_reset( void );
+
+/*********************************************************************
+*********************************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ONBOARD_H
@@ -131,7 +131,10 @@ int main( void )
 #endif
 
   // Initialize the operating system
-  osal_init_system();
+  if ( osal_init_system() != SUCCESS )
+  {
+    HAL_SYSTEM_RESET();
+  }
 
   // Allow interrupts
   osal_int_enable( INTS_ALL );
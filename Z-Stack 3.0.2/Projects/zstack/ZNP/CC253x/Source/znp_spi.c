@@ -763,6 +763,21 @@ void npSpiRxIsr(void)
   switch (type)
   {
   case MT_RPC_CMD_POLL:
+#if NP_SPI_PIPELINE
+    /* Send as many of the queued AREQ frames as fit in one frame from npSpiBuf; the Tx DMA
+     * descriptor is only re-pointed at an OSAL message for a frame too long to share a batch.
+     */
+    if ((npSpiBuf[MT_RPC_POS_CMD1] == NP_SPI_POLL_BATCH) &&
+        ((npSpiBuf[MT_RPC_POS_LEN] = npSpiPollBatchCallback(npSpiBuf + MT_RPC_FRAME_HDR_SZ,
+                                                            MT_RPC_DATA_MAX)) != 0))
+    {
+      npSpiBuf[MT_RPC_POS_CMD0] = NP_SPI_BATCH_CMD0;
+      npSpiBuf[MT_RPC_POS_CMD1] = NP_SPI_BATCH_CMD1;
+      npSpiState = NP_SPI_WAIT_TX;
+      DMA_TX(npSpiBuf);
+      break;
+    }
+#endif
     if ( (pBuf = npSpiPollCallback()) == NULL )
     {
       pBuf = npSpiBuf;
@@ -81,13 +81,16 @@ static void npBasicRsp(void);
 
 static void npUartCback(uint8 port, uint8 event);
 static void npUartTxReady(void);
-static uint8* npMtUartAlloc(uint8 cmd0, uint8 len);
+static uint8* npMtUartAlloc(uint8 cmd0, uint16 len);
 static void npMtUartSend(uint8 *pBuf);
 
 #if !defined CC2531ZNP
 static uint8* npMtSpiAlloc(uint8 cmd0, uint8 len);
 static void npMtSpiSend(uint8 *pBuf);
 uint8* npSpiPollCallback(void);
+#if NP_SPI_PIPELINE
+uint8 npSpiPollBatchCallback(uint8 *pBuf, uint8 len);
+#endif
 bool npSpiReadyCallback(void);
 #endif
 
@@ -106,6 +109,8 @@ static osal_msg_q_t npTxQueue;
 uint8 znpCfg1;
 uint8 znpCfg0;
 
+znpUartTxStats_t znpUartTxStats;
+
 #if defined TC_LINKKEY_JOIN
 extern uint8 zcl_TaskID;
 #endif
@@ -211,7 +216,7 @@ uint16 znpEventLoop(uint8 taskId, uint16 events)
         break;
       }
 
-      osal_msg_deallocate((byte *)pMsg);
+      MT_UartMsgDeallocate((byte *)pMsg);
     }
 
     events ^= SYS_EVENT_MSG;
@@ -313,7 +318,7 @@ uint16 znpEventLoop(uint8 taskId, uint16 events)
  * @return      None.
  **************************************************************************************************
  */
-uint8 *MT_TransportAlloc(uint8 cmd0, uint8 len)
+uint8 *MT_TransportAlloc(uint8 cmd0, uint16 len)
 {
 #if !defined CC2531ZNP
   if (ZNP_CFG1_UART == znpCfg1)
@@ -322,9 +327,13 @@ uint8 *MT_TransportAlloc(uint8 cmd0, uint8 len)
     return npMtUartAlloc(cmd0, len);
   }
 #if !defined CC2531ZNP
+  else if (len <= MT_RPC_DATA_MAX)
+  {
+    return npMtSpiAlloc(cmd0, (uint8)len);
+  }
   else
   {
-    return npMtSpiAlloc(cmd0, len);
+    return NULL;  // The SPI transport does not carry extended frames.
   }
 #endif
 }
@@ -527,7 +536,9 @@ static void npUartCback(uint8 port, uint8 event)
 /**************************************************************************************************
  * @fn          npUartTxReady
  *
- * @brief       This function gets and writes the next chunk of data to the UART.
+ * @brief       This function writes as many of the queued frames to the UART as the UART driver
+ *              will take. A pass stops when the queue is empty or when a write is cut short, in
+ *              which case the rest is written on the next HAL_UART_TX_EMPTY callback.
  *
  * input parameters
  *
@@ -546,30 +557,46 @@ static void npUartTxReady(void)
   static uint8 *npUartTxMsg = NULL;
   static uint8 *pMsg = NULL;
 
-  if (!npUartTxMsg)
+  while (TRUE)
   {
-    if ((pMsg = npUartTxMsg = osal_msg_dequeue(&npTxQueue)))
+    uint16 txLen;
+    uint16 len;
+
+    if (!npUartTxMsg)
     {
+      if ((pMsg = npUartTxMsg = osal_msg_dequeue(&npTxQueue)) == NULL)
+      {
+        break;
+      }
+
       /* | SOP | Data Length | CMD |  DATA   | FSC |
        * |  1  |     1       |  2  | as dLen |  1  |
        */
-      npUartTxCnt = pMsg[1] + MT_UART_FRAME_OVHD + MT_RPC_FRAME_HDR_SZ;
+      npUartTxCnt = MT_RPC_HDR_SZ(pMsg+1) + MT_RPC_DATA_LEN(pMsg+1) + MT_UART_FRAME_OVHD;
+      znpUartTxStats.depth--;
     }
-  }
 
-  if (npUartTxMsg)
-  {
-    uint16 len = HalUARTWrite(HAL_UART_PORT, pMsg, npUartTxCnt);
+    /* Extended frames can be longer than the UART driver buffer */
+    txLen = MIN(npUartTxCnt, MT_UART_DEFAULT_MAX_TX_BUFF);
+    len = HalUARTWrite(HAL_UART_PORT, pMsg, txLen);
     npUartTxCnt -= len;
+    znpUartTxStats.bytes += len;
 
     if (npUartTxCnt == 0)
     {
       osal_msg_deallocate(npUartTxMsg);
       npUartTxMsg = NULL;
+      znpUartTxStats.frames++;
     }
     else
     {
       pMsg += len;
+
+      if (len < txLen)
+      {
+        znpUartTxStats.stalls++;
+        break;
+      }
     }
   }
 }
@@ -591,10 +618,18 @@ static void npUartTxReady(void)
  * @return      Pointer to the buffer obtained; possibly NULL if an allocation failed.
  **************************************************************************************************
  */
-static uint8* npMtUartAlloc(uint8 cmd0, uint8 len)
+static uint8* npMtUartAlloc(uint8 cmd0, uint16 len)
 {
   uint8 *p;
 
+#if defined MT_EXT_FRAMES
+  /* Make room for the 2-byte length of an extended frame */
+  if (len > MT_RPC_DATA_MAX)
+  {
+    len += (MT_RPC_EXT_HDR_SZ - MT_RPC_FRAME_HDR_SZ);
+  }
+#endif
+
   if ((p = osal_msg_allocate(len + MT_RPC_FRAME_HDR_SZ + MT_UART_FRAME_OVHD)) != NULL)
   {
     return p + 1;
@@ -621,13 +656,17 @@ static uint8* npMtUartAlloc(uint8 cmd0, uint8 len)
  */
 static void npMtUartSend(uint8 *pBuf)
 {
-  uint8 len = pBuf[0] + MT_RPC_FRAME_HDR_SZ;
+  uint16 len = MT_RPC_HDR_SZ(pBuf) + MT_RPC_DATA_LEN(pBuf);
 
   pBuf[len] = MT_UartCalcFCS(pBuf, len);
   pBuf--;
   pBuf[0] = MT_UART_SOF;
 
   osal_msg_enqueue(&npTxQueue, pBuf);
+  if (++znpUartTxStats.depth > znpUartTxStats.depthMax)
+  {
+    znpUartTxStats.depthMax = znpUartTxStats.depth;
+  }
   osal_set_event(znpTaskId, ZNP_UART_TX_READY_EVENT);
 }
 
@@ -712,6 +751,48 @@ uint8* npSpiPollCallback(void)
   return osal_msg_dequeue(&npTxQueue);
 }
 
+#if NP_SPI_PIPELINE
+/**************************************************************************************************
+ * @fn          npSpiPollBatchCallback
+ *
+ * @brief       This function is called by the SPI driver when a batch POLL frame is received.
+ *              It moves the queued AREQ frames that fit into the buffer given, in order.
+ *
+ * input parameters
+ *
+ * @param       pBuf - Pointer to the buffer to fill with whole AREQ frames.
+ * @param       len - Length of the buffer.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      The number of bytes filled; zero if the next AREQ frame does not fit.
+ **************************************************************************************************
+ */
+uint8 npSpiPollBatchCallback(uint8 *pBuf, uint8 len)
+{
+  uint8 *pMsg;
+  uint8 cnt = 0;
+
+  while ((pMsg = OSAL_MSG_Q_HEAD(&npTxQueue)) != NULL)
+  {
+    uint16 frameLen = (uint16)pMsg[MT_RPC_POS_LEN] + MT_RPC_FRAME_HDR_SZ;
+
+    if (frameLen > (uint16)(len - cnt))
+    {
+      break;
+    }
+
+    (void)osal_memcpy(pBuf + cnt, pMsg, frameLen);
+    cnt += (uint8)frameLen;
+    osal_msg_deallocate(osal_msg_dequeue(&npTxQueue));
+  }
+
+  return cnt;
+}
+#endif
+
 /**************************************************************************************************
  * @fn          npSpiReadyCallback
  *
@@ -76,6 +76,21 @@ extern "C" {
  * ------------------------------------------------------------------------------------------------
  */
 
+/* ------------------------------------------------------------------------------------------------
+ *                                          Typedefs
+ * ------------------------------------------------------------------------------------------------
+ */
+
+// UART transmit counters, read and cleared by the host with MT_SYS_ZNP_UART_TX_STATS.
+typedef struct
+{
+  uint32 bytes;       // Bytes written to the UART driver.
+  uint32 frames;      // MT frames completely written to the UART driver.
+  uint16 stalls;      // Passes that stopped because the UART driver was full.
+  uint8  depth;       // Frames now queued and not yet started.
+  uint8  depthMax;    // Highest value of 'depth' seen.
+} znpUartTxStats_t;
+
 /* ------------------------------------------------------------------------------------------------
  *                                          Global Variables
  * ------------------------------------------------------------------------------------------------
@@ -84,6 +99,8 @@ extern "C" {
 #define znpTaskId  MT_TaskID
 #define znpBasicRspRate  MT_PeriodicMsgRate
 
+extern znpUartTxStats_t znpUartTxStats;
+
 /* ------------------------------------------------------------------------------------------------
  *                                          Functions
  * ------------------------------------------------------------------------------------------------
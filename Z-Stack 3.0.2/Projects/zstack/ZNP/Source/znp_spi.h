@@ -58,6 +58,21 @@ extern "C" {
  * ------------------------------------------------------------------------------------------------
  */
 
+/* Set to TRUE to let the host take several queued AREQ frames with one POLL. */
+#if !defined NP_SPI_PIPELINE
+#define NP_SPI_PIPELINE            FALSE
+#endif
+
+/* CMD1 of a POLL frame from a host that can unpack a batch of AREQ frames. */
+#define NP_SPI_POLL_BATCH          0x01
+
+/* A batch is sent as one AREQ frame of the reserved subsystem, whose data is the whole AREQ
+ * frames, each as | LEN | CMD0 | CMD1 | DATA |. A POLL finding nothing queued still gets the
+ * all-zero frame, and a frame too long to share a batch is sent on its own.
+ */
+#define NP_SPI_BATCH_CMD0          ((uint8)MT_RPC_CMD_AREQ | (uint8)MT_RPC_SYS_RES0)
+#define NP_SPI_BATCH_CMD1          0x00
+
 /* ------------------------------------------------------------------------------------------------
  *                                           Typedefs
  * ------------------------------------------------------------------------------------------------
@@ -160,6 +175,28 @@ extern void npSpiTxIsr(void);
  */
 extern uint8 *npSpiPollCallback(void);
 
+#if NP_SPI_PIPELINE
+/**************************************************************************************************
+ * @fn          npSpiPollBatchCallback
+ *
+ * @brief       This function is called by the SPI driver when a batch POLL frame is received.
+ *              It moves the queued AREQ frames that fit into the buffer given, in order.
+ *
+ * input parameters
+ *
+ * @param       pBuf - Pointer to the buffer to fill with whole AREQ frames.
+ * @param       len - Length of the buffer.
+ *
+ * output parameters
+ *
+ * None.
+ *
+ * @return      The number of bytes filled; zero if the next AREQ frame does not fit.
+ **************************************************************************************************
+ */
+extern uint8 npSpiPollBatchCallback(uint8 *pBuf, uint8 len);
+#endif
+
 /**************************************************************************************************
  * @fn          npSpiPollReadyback
  *